@@ -0,0 +1,202 @@
+// ApiServer 부하 테스트
+// 내장 ApiServer(또는 외부 서버)에 동시 연결로 /api/get_latest 를 반복 요청하고
+// 초당 요청 수와 지연 백분위수를 출력한다.
+//
+// 사용법: api_load_bench [connections] [requests_per_connection] [port] [keepalive|close] [host]
+//   keepalive: 연결 하나로 요청을 반복 (기본), close: 요청마다 새 연결
+//   host를 지정하면 내장 서버를 띄우지 않고 해당 서버에 요청한다.
+
+#include "api/ApiServer.h"
+#include "detection/DetectionBuffer.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int connectTo(const char* host, int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, host, &addr.sin_addr);
+
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    return fd;
+}
+
+static bool sendAll(int fd, const std::string& data) {
+    size_t offset = 0;
+    while (offset < data.size()) {
+        ssize_t sent = send(fd, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return false;
+        }
+        offset += sent;
+    }
+    return true;
+}
+
+// 응답 하나 읽기 (Content-Length 기준, 다음 응답의 앞부분은 pending에 남김)
+// 서버가 Connection: close로 응답하면 closing = true
+static bool readResponse(int fd, std::string& pending, bool& closing) {
+    char buffer[8192];
+    size_t total = 0;
+
+    while (true) {
+        if (total == 0) {
+            size_t headerEnd = pending.find("\r\n\r\n");
+            if (headerEnd != std::string::npos) {
+                size_t lengthPos = pending.find("Content-Length: ");
+                if (lengthPos == std::string::npos || lengthPos > headerEnd) {
+                    return false;
+                }
+                total = headerEnd + 4 + strtoul(pending.c_str() + lengthPos + 16, nullptr, 10);
+                size_t closePos = pending.find("Connection: close");
+                closing = closePos != std::string::npos && closePos < headerEnd;
+            }
+        }
+        if (total != 0 && pending.size() >= total) {
+            pending.erase(0, total);
+            return true;
+        }
+
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            return false;
+        }
+        pending.append(buffer, n);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int connections = (argc > 1) ? atoi(argv[1]) : 16;
+    int requestsPerConnection = (argc > 2) ? atoi(argv[2]) : 200;
+    int port = (argc > 3) ? atoi(argv[3]) : 18080;
+    bool keepAlive = (argc > 4) ? strcmp(argv[4], "close") != 0 : true;
+    const char* host = (argc > 5) ? argv[5] : "127.0.0.1";
+    bool embedded = (argc <= 5);
+
+    // 내장 서버 준비
+    std::unique_ptr<DetectionBuffer> buffer;
+    std::unique_ptr<ApiServer> server;
+    if (embedded) {
+        buffer = std::make_unique<DetectionBuffer>(CameraType::RGB);
+        std::vector<DetectedObject> objects(8);
+        for (size_t i = 0; i < objects.size(); i++) {
+            objects[i] = {static_cast<int>(i % NUM_CLASSES), 0.8f,
+                          {static_cast<int>(i * 50), 100, 120, 90}, BboxColor::GREEN, true};
+        }
+        uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        for (uint32_t f = 0; f < 300; f++) {
+            buffer->addDetection(now + f * 33333333ULL, f, objects.data(), objects.size());
+        }
+
+        server = std::make_unique<ApiServer>(port, ApiServer::DEFAULT_WORKER_THREADS,
+                                             std::max(connections * 2, 64));
+        server->registerDetectionBuffer(CameraType::RGB, buffer.get());
+        if (!server->start()) {
+            fprintf(stderr, "failed to start embedded server on port %d\n", port);
+            return 1;
+        }
+    }
+
+    const std::string body = "{\"camera\":\"RGB_Camera\"}";
+    const std::string request =
+        "POST /api/get_latest HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: " + std::to_string(body.size()) + "\r\n" +
+        (keepAlive ? "" : "Connection: close\r\n") +
+        "\r\n" + body;
+
+    std::vector<std::vector<double>> latencies(connections);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> clients;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int c = 0; c < connections; c++) {
+        clients.emplace_back([&, c]() {
+            latencies[c].reserve(requestsPerConnection);
+            int fd = -1;
+            std::string pending;
+            for (int r = 0; r < requestsPerConnection; r++) {
+                auto t0 = std::chrono::steady_clock::now();
+
+                if (fd < 0) {
+                    fd = connectTo(host, port);
+                    pending.clear();
+                }
+                bool closing = false;
+                bool ok = fd >= 0 && sendAll(fd, request) && readResponse(fd, pending, closing);
+                if (fd >= 0 && (!ok || closing)) {
+                    close(fd);
+                    fd = -1;
+                }
+
+                auto t1 = std::chrono::steady_clock::now();
+                if (ok) {
+                    latencies[c].push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+                } else {
+                    failures++;
+                }
+            }
+            if (fd >= 0) {
+                close(fd);
+            }
+        });
+    }
+
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::vector<double> all;
+    for (const auto& l : latencies) {
+        all.insert(all.end(), l.begin(), l.end());
+    }
+    std::sort(all.begin(), all.end());
+
+    auto percentile = [&all](double p) {
+        if (all.empty()) return 0.0;
+        size_t index = std::min(all.size() - 1, static_cast<size_t>(p * all.size()));
+        return all[index];
+    };
+
+    printf("mode=%s connections=%d requests=%zu failures=%d time=%.2fs\n",
+           keepAlive ? "keepalive" : "close", connections, all.size(), failures.load(), seconds);
+    printf("requests/sec=%.0f\n", all.size() / seconds);
+    printf("latency us: p50=%.0f p90=%.0f p99=%.0f p99.9=%.0f max=%.0f\n",
+           percentile(0.50), percentile(0.90), percentile(0.99), percentile(0.999),
+           all.empty() ? 0.0 : all.back());
+
+    if (server) {
+        server->stop();
+    }
+    return failures.load() == 0 ? 0 : 1;
+}
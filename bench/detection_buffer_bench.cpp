@@ -0,0 +1,156 @@
+// DetectionBuffer 삽입 마이크로벤치마크
+// 기존 deque 기반 구현과 객체 풀 기반 구현의 할당 횟수 / 삽입 지연(p50, p99)을 비교한다.
+//
+// 사용법: detection_buffer_bench [frames] [objects_per_frame]
+
+#include "detection/DetectionBuffer.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// 전역 할당 카운터
+static std::atomic<uint64_t> g_allocCount(0);
+
+void* operator new(size_t size) {
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+// 변경 전 DetectionBuffer 구현 (비교 기준)
+class LegacyDequeBuffer {
+public:
+    static constexpr uint64_t BUFFER_DURATION_NS = 120ULL * 1000000000ULL;
+
+    explicit LegacyDequeBuffer(size_t maxSize) : maxSize_(maxSize) {}
+
+    void addDetection(const DetectionData& detection) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        DetectionData data = detection;
+        buffer_.push_back(data);
+        if (buffer_.size() > maxSize_) {
+            buffer_.pop_front();
+        }
+
+        auto now = std::chrono::system_clock::now();
+        uint64_t currentTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now.time_since_epoch()).count();
+        uint64_t cutoffTime = currentTime - BUFFER_DURATION_NS;
+
+        auto it = buffer_.begin();
+        while (it != buffer_.end() && it->timestamp < cutoffTime) {
+            it = buffer_.erase(it);
+        }
+
+        LOG_TRACE("Removed old detections, buffer size: %zu", buffer_.size());
+        LOG_TRACE("Detection added: frame=%u, objects=%zu, buffer_size=%zu",
+                  data.frameNumber, data.objects.size(), buffer_.size());
+    }
+
+private:
+    size_t maxSize_;
+    std::mutex mutex_;
+    std::deque<DetectionData> buffer_;
+};
+
+struct BenchResult {
+    double seconds;
+    uint64_t allocations;
+    double p50Ns;
+    double p99Ns;
+};
+
+template <typename Buffer>
+static BenchResult runBench(Buffer& buffer, size_t frames, size_t objectsPerFrame) {
+    DetectionData detection;
+    detection.cameraType = CameraType::RGB;
+    detection.objects.resize(objectsPerFrame);
+    for (size_t i = 0; i < objectsPerFrame; i++) {
+        DetectedObject& obj = detection.objects[i];
+        obj.classId = static_cast<int>(i % NUM_CLASSES);
+        obj.confidence = 0.5f;
+        obj.bbox = {static_cast<int>(i * 10), 20, 100, 80};
+        obj.color = BboxColor::GREEN;
+        obj.hasBbox = true;
+    }
+
+    std::vector<uint64_t> latencies(frames);
+    uint64_t baseTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    uint64_t allocBefore = g_allocCount.load();
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < frames; i++) {
+        detection.timestamp = baseTime + i * 33333333ULL;  // 30fps
+        detection.frameNumber = static_cast<uint32_t>(i);
+
+        auto t0 = std::chrono::steady_clock::now();
+        buffer.addDetection(detection);
+        auto t1 = std::chrono::steady_clock::now();
+
+        latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    uint64_t allocAfter = g_allocCount.load();
+
+    std::sort(latencies.begin(), latencies.end());
+
+    BenchResult result;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.allocations = allocAfter - allocBefore;
+    result.p50Ns = static_cast<double>(latencies[frames / 2]);
+    result.p99Ns = static_cast<double>(latencies[std::min(frames - 1, frames * 99 / 100)]);
+    return result;
+}
+
+static void printResult(const char* name, const BenchResult& r, size_t frames) {
+    printf("%-10s inserts/s=%10.0f  allocs/insert=%6.2f  allocs/s=%12.0f  p50=%7.0fns  p99=%7.0fns\n",
+           name,
+           frames / r.seconds,
+           static_cast<double>(r.allocations) / frames,
+           r.allocations / r.seconds,
+           r.p50Ns, r.p99Ns);
+}
+
+int main(int argc, char* argv[]) {
+    size_t frames = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    size_t objectsPerFrame = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 8;
+    if (frames == 0) {
+        frames = 1;
+    }
+
+    printf("frames=%zu objects_per_frame=%zu capacity=%zu\n",
+           frames, objectsPerFrame, DetectionBuffer::DEFAULT_BUFFER_SIZE);
+
+    {
+        LegacyDequeBuffer legacy(DetectionBuffer::DEFAULT_BUFFER_SIZE);
+        printResult("deque", runBench(legacy, frames, objectsPerFrame), frames);
+    }
+
+    {
+        DetectionBuffer pooled(CameraType::RGB);
+        printResult("pool", runBench(pooled, frames, objectsPerFrame), frames);
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+// 검출 결과 인코딩 벤치마크
+// /api/get_detections 의 JSON 스트리밍 인코더와 바이너리 포맷(DetectionCodec)을 비교하고,
+// 바이너리 포맷은 디코드 결과가 원본과 같은지(round-trip) 확인한다.
+//
+// 사용법: detection_codec_bench [frames] [objects_per_frame] [iterations]
+
+#include "api/DetectionCodec.h"
+#include "api/JsonDetectionWriter.h"
+#include "detection/DetectionBuffer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static void fillBuffer(DetectionBuffer& buffer, size_t frames, size_t objectsPerFrame) {
+    std::vector<DetectedObject> objects(objectsPerFrame);
+    uint64_t baseTime = 1700000000ULL * 1000000000ULL;
+
+    srand(1234);
+    for (size_t f = 0; f < frames; f++) {
+        for (size_t i = 0; i < objectsPerFrame; i++) {
+            DetectedObject& obj = objects[i];
+            obj.classId = rand() % NUM_CLASSES;
+            obj.confidence = 0.3f + (rand() % 7000) / 10000.0f;
+            obj.bbox = {rand() % 1800, rand() % 1000, 40 + rand() % 300, 40 + rand() % 300};
+            obj.color = static_cast<BboxColor>(rand() % 5);
+            obj.hasBbox = obj.color != BboxColor::NONE;
+        }
+        buffer.addDetection(baseTime + f * 33333333ULL + rand() % 1000,
+                            static_cast<uint32_t>(f * 3), objects.data(), objects.size());
+    }
+}
+
+static bool sameObjects(const DetectionData& a, const DetectionData& b) {
+    if (a.timestamp != b.timestamp || a.frameNumber != b.frameNumber ||
+        a.objects.size() != b.objects.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.objects.size(); i++) {
+        const DetectedObject& x = a.objects[i];
+        const DetectedObject& y = b.objects[i];
+        if (x.classId != y.classId || x.confidence != y.confidence || x.color != y.color ||
+            x.hasBbox != y.hasBbox || memcmp(&x.bbox, &y.bbox, sizeof(BoundingBox)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Encode>
+static double timeEncode(Encode encode, size_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        encode();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+int main(int argc, char* argv[]) {
+    size_t frames = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 3600;
+    size_t objectsPerFrame = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 12;
+    size_t iterations = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 50;
+    if (iterations == 0) {
+        iterations = 1;
+    }
+
+    DetectionBuffer buffer(CameraType::RGB, frames, frames * objectsPerFrame);
+    fillBuffer(buffer, frames, objectsPerFrame);
+
+    size_t jsonBytes = 0;
+    double jsonMs = timeEncode([&]() {
+        JsonDetectionWriter writer([](const char*, size_t) { return true; });
+        writer.beginDetections();
+        buffer.visitDetectionsInTimeRange(0, UINT64_MAX, [&writer](const DetectionView& view) {
+            writer.writeDetection(view, "RGB_Camera");
+        });
+        writer.endDetections();
+        writer.flush();
+        jsonBytes = writer.bytesWritten();
+    }, iterations);
+
+    std::string binary;
+    double binaryMs = timeEncode([&]() {
+        binary.clear();
+        DetectionCodec::Writer writer([&binary](const char* data, size_t length) {
+            binary.append(data, length);
+            return true;
+        });
+        writer.begin(CameraType::RGB);
+        buffer.visitDetectionsInTimeRange(0, UINT64_MAX, [&writer](const DetectionView& view) {
+            writer.writeDetection(view);
+        });
+        writer.end();
+        writer.flush();
+    }, iterations);
+
+    std::vector<DetectionData> decoded;
+    CameraType decodedCamera = CameraType::THERMAL;
+    std::string error;
+    double decodeMs = timeEncode([&]() {
+        decoded.clear();
+        if (!DetectionCodec::decode(reinterpret_cast<const uint8_t*>(binary.data()),
+                                    binary.size(), decodedCamera, decoded, &error)) {
+            fprintf(stderr, "decode failed: %s\n", error.c_str());
+            exit(1);
+        }
+    }, iterations);
+
+    // round-trip 확인
+    std::vector<DetectionData> original = buffer.getDetectionsInTimeRange(0, UINT64_MAX);
+    bool match = decodedCamera == CameraType::RGB && decoded.size() == original.size();
+    for (size_t i = 0; match && i < original.size(); i++) {
+        match = sameObjects(original[i], decoded[i]);
+    }
+
+    printf("frames=%zu objects_per_frame=%zu iterations=%zu\n", frames, objectsPerFrame, iterations);
+    printf("json    encode=%8.3fms  bytes=%10zu\n", jsonMs, jsonBytes);
+    printf("binary  encode=%8.3fms  bytes=%10zu  decode=%8.3fms  (%.1f%% of json)\n",
+           binaryMs, binary.size(), decodeMs, 100.0 * binary.size() / std::max<size_t>(jsonBytes, 1));
+    printf("round-trip: %s\n", match ? "OK" : "MISMATCH");
+
+    return match ? 0 : 1;
+}
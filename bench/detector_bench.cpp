@@ -0,0 +1,200 @@
+// 배치 메타데이터 → DetectionData 변환 마이크로벤치마크 (GPU 불필요)
+// MockBatchMeta로 만든 배치를 변경 전 변환 경로와 Detector::processBatchMeta에 넣어
+// 배치당 시간, 객체당 시간, 배치당 할당 횟수를 비교한다.
+//   legacy  : 프레임마다 새 DetectionData + push_back, 프레임마다 system_clock,
+//             객체마다 sqrt와 DeviceSetting 조회
+//   detector: 스레드 로컬 DetectionData 재사용, 규칙 표(DetectionRules)로 프레임 단위 필터/색상,
+//             배치당 설정 스냅샷, 버퍼 PTS
+//
+// 사용법: detector_bench [batches] [frames_per_batch] [objects_per_frame]
+
+#include "mock_batch_meta.h"
+#include "detection/Detector.h"
+#include "utils/DeviceSetting.h"
+#include "utils/Logger.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+// 전역 할당 카운터
+static std::atomic<uint64_t> g_allocCount(0);
+
+void* operator new(size_t size) {
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+// 변경 전 Detector 변환 경로 (비교 기준)
+class LegacyConverter {
+public:
+    using DetectionCallback = std::function<void(const DetectionData&)>;
+
+    explicit LegacyConverter(DetectionCallback callback) : callback_(callback) {}
+
+    void processBatchMeta(NvDsBatchMeta* batchMeta, uint32_t frameNumber) {
+        for (NvDsMetaList* l_frame = batchMeta->frame_meta_list;
+             l_frame != nullptr; l_frame = l_frame->next) {
+            NvDsFrameMeta* frameMeta = reinterpret_cast<NvDsFrameMeta*>(l_frame->data);
+            if (!frameMeta) continue;
+
+            DetectionData detection;
+            detection.frameNumber = frameNumber;
+            detection.cameraType = CameraType::RGB;
+
+            auto now = std::chrono::system_clock::now();
+            auto duration = now.time_since_epoch();
+            detection.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+
+            for (NvDsMetaList* l_obj = frameMeta->obj_meta_list;
+                 l_obj != nullptr; l_obj = l_obj->next) {
+                NvDsObjectMeta* objMeta = reinterpret_cast<NvDsObjectMeta*>(l_obj->data);
+                if (!objMeta) continue;
+
+                DetectedObject obj = convertToDetectedObject(objMeta);
+                if (obj.confidence > 0.3) {
+                    detection.objects.push_back(obj);
+                }
+            }
+
+            if (!detection.objects.empty()) {
+                callback_(detection);
+            }
+        }
+    }
+
+private:
+    DetectedObject convertToDetectedObject(NvDsObjectMeta* objMeta) {
+        DetectedObject obj;
+        obj.classId = objMeta->class_id;
+        obj.confidence = objMeta->confidence;
+        obj.bbox.x = static_cast<int>(objMeta->rect_params.left);
+        obj.bbox.y = static_cast<int>(objMeta->rect_params.top);
+        obj.bbox.width = static_cast<int>(objMeta->rect_params.width);
+        obj.bbox.height = static_cast<int>(objMeta->rect_params.height);
+        obj.color = determineColor(obj.classId, obj);
+        obj.hasBbox = (obj.color != BboxColor::NONE);
+        return obj;
+    }
+
+    BboxColor determineColor(int classId, const DetectedObject& obj) {
+        float diagonal = std::sqrt(obj.bbox.width * obj.bbox.width +
+                                   obj.bbox.height * obj.bbox.height);
+        if (diagonal < 40.0f || diagonal > 1000.0f) {
+            return BboxColor::NONE;
+        }
+        switch (classId) {
+            case CLASS_NORMAL_COW:
+            case CLASS_NORMAL_COW_SITTING:
+                return BboxColor::GREEN;
+            case CLASS_HEAT_COW:
+                return DeviceSetting::getInstance().get().resnet50Apply ? BboxColor::RED : BboxColor::YELLOW;
+            case CLASS_FLIP_COW:
+                return DeviceSetting::getInstance().get().optFlowApply ? BboxColor::RED : BboxColor::YELLOW;
+            case CLASS_LABOR_SIGN_COW:
+                return BboxColor::RED;
+            case CLASS_OVER_TEMP:
+                return BboxColor::BLUE;
+            default:
+                return BboxColor::GREEN;
+        }
+    }
+
+    DetectionCallback callback_;
+};
+
+struct BenchResult {
+    double seconds;
+    uint64_t allocations;
+    uint64_t objects;
+    uint64_t colored;
+};
+
+template <typename Converter>
+static BenchResult runBench(Converter& converter, MockBatchMeta& batch, size_t batches,
+                            const uint64_t& objects, const uint64_t& colored) {
+    uint64_t objectsBefore = objects;
+    uint64_t coloredBefore = colored;
+    uint64_t allocBefore = g_allocCount.load();
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < batches; i++) {
+        // 라이브 카메라처럼 PTS가 실제 경과 시간을 따르게 한다
+        // (재생보다 빠르게 PTS를 늘리면 Detector가 벽시계 기준을 매초 다시 잡는다)
+        uint64_t pts = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        batch.setFrame(static_cast<int>(i), pts);
+        converter.processBatchMeta(batch.get(), static_cast<uint32_t>(i));
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    BenchResult result;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.allocations = g_allocCount.load() - allocBefore;
+    result.objects = objects - objectsBefore;
+    result.colored = colored - coloredBefore;
+    return result;
+}
+
+static void printResult(const char* name, const BenchResult& r, size_t batches) {
+    printf("%-9s batches/s=%10.0f  ns/object=%7.1f  allocs/batch=%6.2f  objects=%llu (boxed %llu)\n",
+           name,
+           batches / r.seconds,
+           r.objects ? r.seconds * 1e9 / r.objects : 0.0,
+           static_cast<double>(r.allocations) / batches,
+           static_cast<unsigned long long>(r.objects),
+           static_cast<unsigned long long>(r.colored));
+}
+
+int main(int argc, char* argv[]) {
+    size_t batches = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    size_t framesPerBatch = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1;
+    size_t objectsPerFrame = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 16;
+    if (batches == 0) {
+        batches = 1;
+    }
+
+    Logger::getInstance().init("./bench_logs", LogLevel::WARNING);
+    printf("batches=%zu frames_per_batch=%zu objects_per_frame=%zu\n",
+           batches, framesPerBatch, objectsPerFrame);
+
+    MockBatchMeta batch(framesPerBatch, objectsPerFrame);
+
+    // 두 경로 모두 같은 콜백 (객체 수와 박스가 그려지는 객체 수만 센다)
+    uint64_t objects = 0;
+    uint64_t colored = 0;
+    auto callback = [&](const DetectionData& detection) {
+        objects += detection.objects.size();
+        for (const DetectedObject& obj : detection.objects) {
+            colored += obj.hasBbox ? 1 : 0;
+        }
+    };
+
+    {
+        LegacyConverter legacy(callback);
+        printResult("legacy", runBench(legacy, batch, batches, objects, colored), batches);
+    }
+
+    {
+        Detector detector(CameraType::RGB);
+        detector.setDetectionCallback(callback);
+        printResult("detector", runBench(detector, batch, batches, objects, colored), batches);
+    }
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+// HTTP 요청 파서 벤치마크
+// 기존 방식(std::string 누적 + find + istringstream + substr)과 HttpParser를
+// 한 번에 도착한 요청 / 조각으로 나뉘어 도착한 요청에 대해 비교한다.
+//
+// 사용법: http_parser_bench [iterations] [fragment_size]
+
+#include "api/HttpParser.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// 기존 ApiServer 파싱 경로 (비교용)
+struct LegacyRequest {
+    std::string method;
+    std::string path;
+    std::unordered_map<std::string, std::string> headers;
+    std::string body;
+};
+
+size_t legacyCompleteLength(const std::string& data) {
+    size_t headerEnd = data.find("\r\n\r\n");
+    if (headerEnd == std::string::npos) {
+        return 0;
+    }
+
+    size_t contentLength = 0;
+    std::string headers = data.substr(0, headerEnd);
+    size_t contentLengthPos = headers.find("Content-Length:");
+    if (contentLengthPos != std::string::npos) {
+        contentLength = strtoul(headers.c_str() + contentLengthPos + 15, nullptr, 10);
+    }
+
+    size_t total = headerEnd + 4 + contentLength;
+    return (data.size() >= total) ? total : 0;
+}
+
+LegacyRequest legacyParse(const std::string& rawRequest) {
+    LegacyRequest request;
+    std::istringstream stream(rawRequest);
+    std::string line;
+
+    if (std::getline(stream, line)) {
+        std::istringstream lineStream(line);
+        lineStream >> request.method >> request.path;
+    }
+
+    while (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            break;
+        }
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string name = line.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        size_t valueStart = line.find_first_not_of(" \t", colon + 1);
+        request.headers[name] = (valueStart != std::string::npos) ? line.substr(valueStart) : "";
+    }
+
+    size_t headerEnd = rawRequest.find("\r\n\r\n");
+    if (headerEnd != std::string::npos) {
+        request.body = rawRequest.substr(headerEnd + 4);
+    }
+    return request;
+}
+
+volatile size_t g_sink;
+
+// 조각 단위로 도착한다고 가정하고 요청 하나를 처리
+double benchLegacy(const std::string& raw, size_t fragment, size_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        std::string inBuffer;
+        size_t length = 0;
+        for (size_t offset = 0; offset < raw.size() && length == 0; offset += fragment) {
+            inBuffer.append(raw, offset, fragment);
+            length = legacyCompleteLength(inBuffer);
+        }
+        LegacyRequest request = legacyParse(inBuffer.substr(0, length));
+        g_sink = request.body.size() + request.headers.size();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+double benchParser(const std::string& raw, size_t fragment, size_t iterations) {
+    HttpParser parser;
+    std::vector<char> buffer(raw.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        parser.reset();
+        HttpParser::Status status = HttpParser::Status::INCOMPLETE;
+        size_t used = 0;
+        while (status == HttpParser::Status::INCOMPLETE && used < raw.size()) {
+            size_t n = std::min(fragment, raw.size() - used);
+            memcpy(buffer.data() + used, raw.data() + used, n);
+            used += n;
+            status = parser.parse(buffer.data(), used);
+        }
+        g_sink = parser.body().size() + parser.headerCount();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t iterations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    size_t fragment = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 64;
+    if (iterations == 0) iterations = 1;
+    if (fragment == 0) fragment = 1;
+
+    const std::string body =
+        "{\"camera\":\"RGB_Camera\",\"start_time\":\"2024-01-01T12:00:00Z\","
+        "\"end_time\":\"2024-01-01T12:01:00Z\"}";
+    const std::string raw =
+        "POST /api/get_detections HTTP/1.1\r\n"
+        "Host: 192.168.0.10:8080\r\n"
+        "User-Agent: aggregator/2.3\r\n"
+        "Accept: application/json\r\n"
+        "Accept-Encoding: identity\r\n"
+        "Connection: keep-alive\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: " + std::to_string(body.size()) + "\r\n"
+        "\r\n" + body;
+
+    // 결과 확인
+    HttpParser check;
+    if (check.parse(raw.data(), raw.size()) != HttpParser::Status::COMPLETE ||
+        check.consumed() != raw.size() || check.body() != body) {
+        fprintf(stderr, "parser self-check failed\n");
+        return 1;
+    }
+
+    printf("request=%zu bytes iterations=%zu fragment=%zu\n", raw.size(), iterations, fragment);
+    printf("legacy  whole=%8.1f ns  fragmented=%8.1f ns\n",
+           benchLegacy(raw, raw.size(), iterations), benchLegacy(raw, fragment, iterations));
+    printf("parser  whole=%8.1f ns  fragmented=%8.1f ns\n",
+           benchParser(raw, raw.size(), iterations), benchParser(raw, fragment, iterations));
+    return 0;
+}
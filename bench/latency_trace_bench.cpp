@@ -0,0 +1,101 @@
+// 단계별 지연 추적 벤치마크 (NVIDIA 플러그인 없이)
+// CameraSource와 같은 방식으로 LatencyTrace를 패드 프로브에 걸고, 소프트웨어 요소로 만든
+// 파이프라인을 videotestsrc로 돌린 뒤 단계별 지연 분포를 출력한다.
+//   videotestsrc(shmsrc 대신) ! videoconvert(convert) ! queue(queue1, leaky)
+//     ! identity sleep-time(infer 대신) ! videoconvert(output) ! fakesink(webrtc_sink 대신)
+//
+// 사용법: latency_trace_bench [width] [height] [fps] [seconds] [infer_sleep_us]
+
+#include "pipeline/LatencyProbe.h"
+#include "pipeline/LatencyTrace.h"
+#include <cstdio>
+#include <cstdlib>
+#include <gst/gst.h>
+
+namespace {
+
+void printSummary(const char* label, const LatencyHistogram::Summary& summary) {
+    printf("  %-6s n=%-6llu mean=%9.1f p50=%8llu p90=%8llu p99=%8llu max=%8llu us\n", label,
+           static_cast<unsigned long long>(summary.count), summary.mean,
+           static_cast<unsigned long long>(summary.p50),
+           static_cast<unsigned long long>(summary.p90),
+           static_cast<unsigned long long>(summary.p99),
+           static_cast<unsigned long long>(summary.max));
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int width = (argc > 1) ? atoi(argv[1]) : 1280;
+    int height = (argc > 2) ? atoi(argv[2]) : 720;
+    int fps = (argc > 3) ? atoi(argv[3]) : 10;
+    int seconds = (argc > 4) ? atoi(argv[4]) : 10;
+    int inferSleepUs = (argc > 5) ? atoi(argv[5]) : 20000;
+    if (fps <= 0) fps = 10;
+    if (seconds <= 0) seconds = 10;
+
+    gst_init(&argc, &argv);
+
+    char description[512];
+    snprintf(description, sizeof(description),
+             "videotestsrc name=source is-live=true num-buffers=%d "
+             "! video/x-raw,format=I420,width=%d,height=%d,framerate=%d/1 "
+             "! videoconvert name=convert "
+             "! queue name=queue1 leaky=downstream max-size-buffers=5 "
+             "! identity name=infer sleep-time=%d "
+             "! videoconvert name=output "
+             "! fakesink name=webrtc_sink sync=false",
+             fps * seconds, width, height, fps, inferSleepUs);
+
+    GError* error = nullptr;
+    GstElement* pipeline = gst_parse_launch(description, &error);
+    if (!pipeline) {
+        fprintf(stderr, "pipeline: %s\n", error ? error->message : "unknown error");
+        g_clear_error(&error);
+        return 1;
+    }
+
+    LatencyTrace trace("bench");
+    struct {
+        const char* element;
+        const char* pad;
+    } points[] = {
+        {"source", "src"}, {"convert", "src"}, {"queue1", "src"},
+        {"infer", "src"}, {"output", "src"}, {"webrtc_sink", "sink"}
+    };
+    for (const auto& point : points) {
+        GstElement* element = gst_bin_get_by_name(GST_BIN(pipeline), point.element);
+        attachLatencyProbe(&trace, trace.addStage(point.element), element, point.pad);
+        gst_object_unref(element);
+    }
+
+    printf("%dx%d @ %d fps for %d s, infer sleep %d us\n", width, height, fps, seconds, inferSleepUs);
+    gst_element_set_state(pipeline, GST_STATE_PLAYING);
+
+    GstBus* bus = gst_element_get_bus(pipeline);
+    GstMessage* message = gst_bus_timed_pop_filtered(
+        bus, GST_CLOCK_TIME_NONE, static_cast<GstMessageType>(GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+    if (message && GST_MESSAGE_TYPE(message) == GST_MESSAGE_ERROR) {
+        gst_message_parse_error(message, &error, nullptr);
+        fprintf(stderr, "pipeline error: %s\n", error->message);
+        g_clear_error(&error);
+    }
+    if (message) {
+        gst_message_unref(message);
+    }
+    gst_object_unref(bus);
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+
+    for (const LatencyTrace::StageStats& stage : trace.getStats()) {
+        printf("%s%s%s (unmatched %llu)\n", stage.name.c_str(),
+               stage.parent.empty() ? "" : " <- ", stage.parent.c_str(),
+               static_cast<unsigned long long>(stage.unmatched));
+        if (!stage.parent.empty()) {
+            printSummary("stage", stage.stage);
+            printSummary("total", stage.total);
+        }
+    }
+
+    gst_object_unref(pipeline);
+    return 0;
+}
@@ -0,0 +1,229 @@
+// Logger 벤치마크
+// 1) 꺼진 레벨(TRACE)의 LOG_* 호출 비용: 기존 매크로 경로(문자열 생성 + snprintf 후 레벨 검사),
+//    런타임 레벨 검사, 컴파일 시점 제거(LOG_COMPILE_MIN_LEVEL)를 비교한다.
+// 2) 여러 스레드가 동시에 DEBUG 로그를 남길 때 호출 스레드 입장의 호출당 시간을
+//    기존 방식(전역 mutex + put_time/ostringstream + 줄마다 flush)과 비동기 Logger
+//    (텍스트 / 바이너리 모드)로 비교한다. 바이너리 로그는 logdecode로 확인할 수 있다.
+// 3) 모든 스레드가 같은 호출 위치의 ERROR를 쏟아낼 때, 호출 위치별 속도 제한(초당 100개)에
+//    걸려 억제되는 호출의 비용과 억제 수를 잰다.
+//
+// 사용법: logger_bench [threads] [messages_per_thread] [drop|block] [log_dir]
+
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+volatile size_t g_sink;
+
+// 기존 LOG_* 매크로 경로 (비교용): 레벨과 관계없이 file/format 문자열을 만들고
+// 4KB 버퍼에 포맷한 뒤에야 Logger 안에서 레벨을 검사한다
+template<typename... Args>
+void legacyMacroLog(LogLevel level, const std::string& file, int line,
+                    const std::string& format, Args... args) {
+    char buffer[4096];
+    snprintf(buffer, sizeof(buffer), format.c_str(), args...);
+    Logger::getInstance().log(level, file.c_str(), line, std::string(buffer));
+}
+
+template<typename Loop>
+double nsPerCall(size_t iterations, Loop loop) {
+    auto start = std::chrono::steady_clock::now();
+    loop(iterations);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+void disabledLegacy(size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        legacyMacroLog(LogLevel::TRACE, __FILE__, __LINE__,
+                       "Detection added: frame=%u, objects=%zu, buffer_size=%lu",
+                       static_cast<unsigned>(i), i % 7, static_cast<unsigned long>(i));
+        g_sink = i;
+    }
+}
+
+void disabledRuntime(size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        LOG_TRACE("Detection added: frame=%u, objects=%zu, buffer_size=%lu",
+                  static_cast<unsigned>(i), i % 7, static_cast<unsigned long>(i));
+        g_sink = i;
+    }
+}
+
+// 이 함수만 TRACE를 컴파일 단계에서 제거한 것처럼 빌드
+#pragma push_macro("LOG_COMPILE_MIN_LEVEL")
+#undef LOG_COMPILE_MIN_LEVEL
+#define LOG_COMPILE_MIN_LEVEL LOG_LEVEL_DEBUG
+void disabledCompiled(size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        LOG_TRACE("Detection added: frame=%u, objects=%zu, buffer_size=%lu",
+                  static_cast<unsigned>(i), i % 7, static_cast<unsigned long>(i));
+        g_sink = i;
+    }
+}
+#pragma pop_macro("LOG_COMPILE_MIN_LEVEL")
+
+// 기존 Logger::Impl::log 경로 (비교용, 콘솔 출력 제외)
+class LegacyLogger {
+public:
+    explicit LegacyLogger(const std::string& path) : file_(path, std::ios::app) {}
+
+    void log(LogLevel level, const std::string& file, int line, const std::string& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto now = std::chrono::system_clock::now();
+        auto time_t = std::chrono::system_clock::to_time_t(now);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now.time_since_epoch()) % 1000;
+
+        struct tm timeinfo;
+        localtime_r(&time_t, &timeinfo);
+
+        size_t pos = file.find_last_of("/\\");
+        std::ostringstream oss;
+        oss << "[" << std::put_time(&timeinfo, "%Y-%m-%d %H:%M:%S")
+            << "." << std::setfill('0') << std::setw(3) << ms.count() << "] "
+            << "[" << (level == LogLevel::DEBUG ? "DEBUG" : "INFO ") << "] "
+            << "[" << ((pos != std::string::npos) ? file.substr(pos + 1) : file) << ":" << line << "] "
+            << message;
+
+        file_ << oss.str() << std::endl;
+        file_.flush();
+    }
+
+private:
+    std::mutex mutex_;
+    std::ofstream file_;
+};
+
+struct Result {
+    double meanNs;
+    double p99Ns;
+    double totalMs;
+};
+
+// 스레드마다 호출 시간을 재고 전체 분포를 합친다
+template<typename LogCall>
+Result run(size_t threads, size_t messages, LogCall logCall) {
+    std::vector<std::vector<uint32_t>> samples(threads);
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            std::vector<uint32_t>& mine = samples[t];
+            mine.reserve(messages);
+            for (size_t i = 0; i < messages; i++) {
+                auto before = std::chrono::steady_clock::now();
+                logCall(t, i);
+                auto after = std::chrono::steady_clock::now();
+                mine.push_back(static_cast<uint32_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(after - before).count()));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::vector<uint32_t> all;
+    for (auto& mine : samples) {
+        all.insert(all.end(), mine.begin(), mine.end());
+    }
+    std::sort(all.begin(), all.end());
+    double sum = 0;
+    for (uint32_t sample : all) {
+        sum += sample;
+    }
+
+    Result result;
+    result.meanNs = all.empty() ? 0 : sum / all.size();
+    result.p99Ns = all.empty() ? 0 : all[all.size() * 99 / 100];
+    result.totalMs = std::chrono::duration<double, std::milli>(end - start).count();
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t threads = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 4;
+    size_t messages = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 100000;
+    bool block = (argc > 3) && strcmp(argv[3], "block") == 0;
+    std::string logDir = (argc > 4) ? argv[4] : "/tmp/logger_bench";
+    if (threads == 0) threads = 1;
+    if (messages == 0) messages = 1;
+
+    Logger& logger = Logger::getInstance();
+    logger.init(logDir, LogLevel::DEBUG);
+    logger.setOverflowPolicy(block ? LogOverflowPolicy::BLOCK : LogOverflowPolicy::DROP);
+    logger.setRateLimit(0);
+
+    LegacyLogger legacy(logDir + "/legacy.log");
+
+    size_t disabledIterations = messages * 10;
+    printf("disabled TRACE call (iterations=%zu)\n", disabledIterations);
+    printf("legacy macro  %6.2f ns/call\n", nsPerCall(disabledIterations, disabledLegacy));
+    printf("runtime level %6.2f ns/call\n", nsPerCall(disabledIterations, disabledRuntime));
+    printf("compiled out  %6.2f ns/call\n", nsPerCall(disabledIterations, disabledCompiled));
+
+    printf("threads=%zu messages/thread=%zu policy=%s\n",
+           threads, messages, block ? "block" : "drop");
+
+    Result legacyResult = run(threads, messages, [&](size_t t, size_t i) {
+        char message[4096];
+        snprintf(message, sizeof(message),
+                 "Detection published: camera=%zu frame=%zu objects=%d", t, i, 3);
+        legacy.log(LogLevel::DEBUG, __FILE__, __LINE__, std::string(message));
+    });
+    printf("legacy  mean=%8.1f ns  p99=%8.1f ns  total=%8.1f ms\n",
+           legacyResult.meanNs, legacyResult.p99Ns, legacyResult.totalMs);
+
+    Result asyncResult = run(threads, messages, [&](size_t t, size_t i) {
+        LOG_DEBUG("Detection published: camera=%zu frame=%zu objects=%d", t, i, 3);
+    });
+    auto flushStart = std::chrono::steady_clock::now();
+    logger.flush();
+    double flushMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - flushStart).count();
+    printf("async   mean=%8.1f ns  p99=%8.1f ns  total=%8.1f ms  flush=%.1f ms  dropped=%llu\n",
+           asyncResult.meanNs, asyncResult.p99Ns, asyncResult.totalMs, flushMs,
+           static_cast<unsigned long long>(logger.getDroppedCount()));
+
+    uint64_t droppedBefore = logger.getDroppedCount();
+    logger.setBinaryMode(true);
+    Result binaryResult = run(threads, messages, [&](size_t t, size_t i) {
+        LOG_DEBUG("Detection published: camera=%zu frame=%zu objects=%d", t, i, 3);
+    });
+    logger.flush();
+    logger.setBinaryMode(false);
+    printf("binary  mean=%8.1f ns  p99=%8.1f ns  total=%8.1f ms  dropped=%llu\n",
+           binaryResult.meanNs, binaryResult.p99Ns, binaryResult.totalMs,
+           static_cast<unsigned long long>(logger.getDroppedCount() - droppedBefore));
+
+    logger.setRateLimit(100);
+    Result stormResult = run(threads, messages, [&](size_t t, size_t i) {
+        LOG_ERROR("Socket not connected for peer peer-%zu (attempt %zu)", t, i);
+    });
+    logger.flush();
+    logger.setRateLimit(0);
+    printf("storm   mean=%8.1f ns  p99=%8.1f ns  total=%8.1f ms  suppressed=%llu\n",
+           stormResult.meanNs, stormResult.p99Ns, stormResult.totalMs,
+           static_cast<unsigned long long>(logger.getSuppressedCount()));
+
+    logger.close();
+    return 0;
+}
@@ -0,0 +1,83 @@
+// 지표 갱신 비용 벤치마크
+// 여러 스레드가 같은 카운터/히스토그램을 갱신할 때 호출당 시간을 비교한다.
+//   shared   : 하나의 std::atomic<uint64_t>에 fetch_add (모든 스레드가 같은 캐시 라인)
+//   counter  : 스레드별 샤드에 더하는 Counter
+//   histogram: 고정 버킷 Histogram::observe
+// 끝에 /metrics 렌더 한 번의 시간도 출력한다.
+//
+// 사용법: metrics_bench [threads] [ops_per_thread]
+
+#include "utils/Metrics.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+template <typename Fn>
+double runThreads(int threads, int ops, Fn fn) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            for (int i = 0; i < ops; i++) {
+                fn(t, i);
+            }
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    // 스레드들이 동시에 돌므로 벽시계 시간 / 스레드당 호출 수 = 호출당 시간
+    return std::chrono::duration<double, std::nano>(end - start).count() / ops;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int threads = (argc > 1) ? atoi(argv[1]) : 8;
+    int ops = (argc > 2) ? atoi(argv[2]) : 2000000;
+    if (threads <= 0) threads = 8;
+    if (ops <= 0) ops = 2000000;
+
+    MetricsRegistry& registry = MetricsRegistry::getInstance();
+    Counter& counter = registry.counter("bench_ops_total", "Benchmark operations");
+    Histogram& histogram = registry.histogram("bench_latency_seconds", "Benchmark latency",
+                                              Histogram::latencyBuckets());
+    std::atomic<uint64_t> shared{0};
+
+    printf("threads=%d ops/thread=%d\n", threads, ops);
+
+    double sharedNs = runThreads(threads, ops, [&](int, int) {
+        shared.fetch_add(1, std::memory_order_relaxed);
+    });
+    printf("  shared atomic : %7.2f ns/op (total %llu)\n", sharedNs,
+           static_cast<unsigned long long>(shared.load()));
+
+    double counterNs = runThreads(threads, ops, [&](int, int) {
+        counter.inc();
+    });
+    printf("  Counter       : %7.2f ns/op (total %llu)\n", counterNs,
+           static_cast<unsigned long long>(counter.get()));
+
+    double histogramNs = runThreads(threads, ops, [&](int t, int i) {
+        histogram.observe(((i + t) & 1023) * 1e-4);
+    });
+    printf("  Histogram     : %7.2f ns/op (count %llu)\n", histogramNs,
+           static_cast<unsigned long long>(histogram.snapshot().count));
+
+    auto start = std::chrono::steady_clock::now();
+    std::string text = registry.renderPrometheus();
+    auto end = std::chrono::steady_clock::now();
+    printf("  render        : %7.1f us (%zu bytes)\n",
+           std::chrono::duration<double, std::micro>(end - start).count(), text.size());
+    return 0;
+}
@@ -0,0 +1,85 @@
+// GPU 없이 Detector::processBatchMeta를 구동하기 위한 NvDsBatchMeta 모형
+// 배치 → 프레임 → 객체 연결 리스트를 벡터 저장소 위에 만든다 (검출 코드가 읽는 필드만 채움).
+// ENABLE_DEEPSTREAM=OFF면 DeepStreamMeta.h의 CPU 대체 타입, ON이면 SDK 타입 그대로 쓴다.
+
+#ifndef MOCK_BATCH_META_H
+#define MOCK_BATCH_META_H
+
+#include "detection/DeepStreamMeta.h"
+#include "common/Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class MockBatchMeta {
+public:
+    // 객체 i는 클래스/신뢰도/크기를 돌아가며 갖는다.
+    // 신뢰도 임계값(0.3) 아래와 대각선 범위 밖 객체가 섞여 필터 경로도 지난다
+    MockBatchMeta(size_t frames, size_t objectsPerFrame)
+        : objects_(frames * objectsPerFrame)
+        , frames_(frames)
+        , objectLinks_(frames * objectsPerFrame)
+        , frameLinks_(frames)
+        , batch_() {
+        static const float confidences[] = {0.9f, 0.75f, 0.5f, 0.35f, 0.2f};
+        static const float sizes[] = {120.0f, 60.0f, 300.0f, 20.0f, 900.0f};
+
+        for (size_t i = 0; i < objects_.size(); i++) {
+            NvDsObjectMeta& obj = objects_[i];
+            obj = NvDsObjectMeta();
+            obj.class_id = static_cast<int>(i % NUM_CLASSES);
+            obj.object_id = i;
+            obj.confidence = confidences[i % 5];
+            obj.rect_params.left = static_cast<float>((i * 37) % 1200);
+            obj.rect_params.top = static_cast<float>((i * 23) % 600);
+            obj.rect_params.width = sizes[(i / 5) % 5];
+            obj.rect_params.height = sizes[(i / 5) % 5] * 0.75f;
+        }
+
+        for (size_t f = 0; f < frames; f++) {
+            NvDsMetaList* head = nullptr;
+            for (size_t o = objectsPerFrame; o-- > 0;) {
+                NvDsMetaList& link = objectLinks_[f * objectsPerFrame + o];
+                link = NvDsMetaList();
+                link.data = &objects_[f * objectsPerFrame + o];
+                link.next = head;
+                head = &link;
+            }
+
+            NvDsFrameMeta& frame = frames_[f];
+            frame = NvDsFrameMeta();
+            frame.source_id = static_cast<unsigned int>(f);
+            frame.obj_meta_list = head;
+
+            NvDsMetaList& link = frameLinks_[f];
+            link = NvDsMetaList();
+            link.data = &frame;
+            link.next = (f + 1 < frames) ? &frameLinks_[f + 1] : nullptr;
+        }
+
+        batch_.num_frames_in_batch = static_cast<unsigned int>(frames);
+        batch_.frame_meta_list = frames ? &frameLinks_[0] : nullptr;
+    }
+
+    // 배치의 모든 프레임에 같은 번호/PTS를 매긴다 (스트림 먹스 출력처럼)
+    void setFrame(int frameNumber, uint64_t pts) {
+        for (NvDsFrameMeta& frame : frames_) {
+            frame.frame_num = frameNumber;
+            frame.buf_pts = pts;
+        }
+    }
+
+    NvDsBatchMeta* get() { return &batch_; }
+
+private:
+    MockBatchMeta(const MockBatchMeta&) = delete;
+    MockBatchMeta& operator=(const MockBatchMeta&) = delete;
+
+    std::vector<NvDsObjectMeta> objects_;
+    std::vector<NvDsFrameMeta> frames_;
+    std::vector<NvDsMetaList> objectLinks_;
+    std::vector<NvDsMetaList> frameLinks_;
+    NvDsBatchMeta batch_;
+};
+
+#endif // MOCK_BATCH_META_H
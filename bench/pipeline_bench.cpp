@@ -0,0 +1,168 @@
+// 카메라 파이프라인 처리량 벤치마크 (NVIDIA 플러그인 없이)
+// CameraSource가 만드는 토폴로지를 그대로 구성하되, ElementFactory의 CPU 대체 표로
+// NVIDIA 요소를 소프트웨어 요소로 바꾸고 공유 메모리 입출력 대신 videotestsrc/fakesink로 구동한다.
+//   nvvideoconvert → videoconvert ! videoscale ! videorate,
+//   nvstreammux/nvinfer/nvof/dspostproc/nvdsosd → identity,
+//   shmsrc → videotestsrc, shmsink → fakesink (이 벤치에서만)
+// 추론 비용은 identity sleep-time(infer_sleep_us)으로 흉내 낸다.
+//
+// 출력: 요소별 처리량(fps)과 큐 드롭, 프로세스 CPU 사용률, 단계별 지연 분포
+// (CameraSource가 등록하는 PipelineMonitor 지표와 LatencyTrace를 그대로 읽는다)
+//
+// 사용법: pipeline_bench [width] [height] [fps] [seconds] [inference 0|1] [infer_sleep_us]
+
+#include "pipeline/CameraSource.h"
+#include "pipeline/ElementFactory.h"
+#include "pipeline/LatencyTrace.h"
+#include "utils/Logger.h"
+#include "utils/Metrics.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sys/resource.h>
+#include <gst/gst.h>
+
+namespace {
+
+double cpuSeconds() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+           usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+void printSummary(const char* label, const LatencyHistogram::Summary& summary) {
+    printf("    %-6s n=%-6llu mean=%9.1f p50=%8llu p90=%8llu p99=%8llu max=%8llu us\n", label,
+           static_cast<unsigned long long>(summary.count), summary.mean,
+           static_cast<unsigned long long>(summary.p50),
+           static_cast<unsigned long long>(summary.p90),
+           static_cast<unsigned long long>(summary.p99),
+           static_cast<unsigned long long>(summary.max));
+}
+
+// PipelineMonitor가 등록한 지표를 같은 이름 + 라벨로 다시 찾는다
+uint64_t counterValue(const char* name, const std::string& camera, const char* element) {
+    return MetricsRegistry::getInstance().counter(name, "", {{"camera", camera}, {"element", element}}).get();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int width = (argc > 1) ? atoi(argv[1]) : 1280;
+    int height = (argc > 2) ? atoi(argv[2]) : 720;
+    int fps = (argc > 3) ? atoi(argv[3]) : 10;
+    int seconds = (argc > 4) ? atoi(argv[4]) : 10;
+    bool inference = (argc > 5) ? atoi(argv[5]) != 0 : true;
+    int inferSleepUs = (argc > 6) ? atoi(argv[6]) : 20000;
+    if (fps <= 0) fps = 10;
+    if (seconds <= 0) seconds = 10;
+
+    gst_init(&argc, &argv);
+    Logger::getInstance().init("./bench_logs", LogLevel::WARNING);
+
+    ElementFactory& factory = ElementFactory::getInstance();
+    factory.useCpuSubstitutions();
+    factory.setSubstitution("shmsrc", "videotestsrc is-live=true");
+    factory.setSubstitution("shmsink", "fakesink sync=false");
+    if (inferSleepUs > 0) {
+        factory.setSubstitution("nvinfer", "identity sleep-time=" + std::to_string(inferSleepUs));
+    }
+
+    CameraConfig config;
+    config.name = "bench";
+    config.type = CameraType::RGB;
+    config.source.protocol = "shm";
+    config.source.port = 0;
+    config.source.width = width;
+    config.source.height = height;
+    config.source.framerate = fps;
+    config.inference.enabled = inference;
+    config.inference.config_file = "/dev/null";  // Detector는 파일이 열리는지만 확인한다
+    config.inference.scale_width = 640;
+    config.inference.scale_height = 640;
+
+    GstElement* pipeline = gst_pipeline_new("bench-pipeline");
+    CameraSource camera(CameraType::RGB, 0);
+    if (!camera.init(config, pipeline)) {
+        fprintf(stderr, "failed to build camera topology\n");
+        gst_object_unref(pipeline);
+        return 1;
+    }
+
+    printf("%dx%d @ %d fps for %d s, inference %s, infer sleep %d us\n", width, height, fps, seconds,
+           inference ? "on" : "off", inferSleepUs);
+
+    if (gst_element_set_state(pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+        fprintf(stderr, "failed to start pipeline\n");
+        gst_object_unref(pipeline);
+        return 1;
+    }
+
+    double cpuStart = cpuSeconds();
+    auto wallStart = std::chrono::steady_clock::now();
+    auto deadline = wallStart + std::chrono::seconds(seconds);
+
+    GstBus* bus = gst_element_get_bus(pipeline);
+    bool failed = false;
+    bool finished = false;
+    while (!finished && std::chrono::steady_clock::now() < deadline) {
+        GstMessage* message = gst_bus_timed_pop_filtered(
+            bus, 100 * GST_MSECOND, static_cast<GstMessageType>(GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+        if (!message) {
+            continue;
+        }
+        if (GST_MESSAGE_TYPE(message) == GST_MESSAGE_ERROR) {
+            GError* error = nullptr;
+            gst_message_parse_error(message, &error, nullptr);
+            fprintf(stderr, "pipeline error from %s: %s\n", GST_OBJECT_NAME(message->src), error->message);
+            g_clear_error(&error);
+            failed = true;
+        }
+        finished = true;
+        gst_message_unref(message);
+    }
+    gst_object_unref(bus);
+
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    double cpu = cpuSeconds() - cpuStart;
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+
+    const std::string& cameraName = camera.getLatencyTrace()->getName();
+    printf("wall %.2f s, cpu %.2f s (%.1f%% of one core)\n", wall, cpu, 100.0 * cpu / wall);
+
+    const char* elements[] = {"shmsrc", "queue1", "queue2", "infer", "webrtc_queue", "webrtc_sink"};
+    const char* queues[] = {"queue1", "queue2", "webrtc_queue"};
+    printf("throughput:\n");
+    for (const char* element : elements) {
+        if (!inference && (std::string(element) == "queue2" || std::string(element) == "infer")) {
+            continue;
+        }
+        uint64_t buffers = counterValue("pipeline_buffers_total", cameraName, element);
+        printf("  %-13s %8llu buffers %8.2f fps\n", element,
+               static_cast<unsigned long long>(buffers), buffers / wall);
+    }
+    printf("queue drops:\n");
+    for (const char* queue : queues) {
+        if (!inference && std::string(queue) == "queue2") {
+            continue;
+        }
+        uint64_t drops = counterValue("pipeline_queue_dropped_total", cameraName, queue);
+        printf("  %-13s %8llu dropped %8.2f /s\n", queue,
+               static_cast<unsigned long long>(drops), drops / wall);
+    }
+
+    printf("latency:\n");
+    for (const LatencyTrace::StageStats& stage : camera.getLatencyTrace()->getStats()) {
+        printf("  %s%s%s (unmatched %llu)\n", stage.name.c_str(),
+               stage.parent.empty() ? "" : " <- ", stage.parent.c_str(),
+               static_cast<unsigned long long>(stage.unmatched));
+        if (!stage.parent.empty()) {
+            printSummary("stage", stage.stage);
+            printSummary("total", stage.total);
+        }
+    }
+
+    gst_object_unref(pipeline);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,180 @@
+// ROI / 축사 마스크 필터 벤치마크
+// 1920x1080 프레임에 포함 영역(사다리꼴)과 제외 영역(축사 칸, 통로, 사료조) 다각형을 두고
+// 합성 바운딩 박스 수천 개를 판정한다.
+//   polygon : 박스마다 중심을 모든 다각형과 짝홀 규칙으로 검사 (래스터화 없이 하는 경우)
+//   center  : RoiMask 비트맵에서 중심 셀 비트 하나 조회
+//   overlap : RoiMask 적분표로 박스가 덮는 허용 셀 비율 조회
+//   rules   : DetectionRules::apply (클래스/크기 규칙 + 프리셋 마스크, 프레임 단위 압축)
+// 박스당 시간과 통과 비율, 비트맵 중심 판정이 다각형 판정과 일치하는 비율을 출력한다.
+//
+// 사용법: roi_mask_bench [boxes] [rounds] [cell_size]
+
+#include "detection/DetectionRules.h"
+#include "detection/RoiMask.h"
+#include "utils/Logger.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int FRAME_WIDTH = 1920;
+const int FRAME_HEIGHT = 1080;
+
+RoiMask::Polygon rect(float x, float y, float width, float height) {
+    return {{x, y}, {x + width, y}, {x + width, y + height}, {x, y + height}};
+}
+
+bool inside(const RoiMask::Polygon& polygon, float x, float y) {
+    bool result = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const RoiMask::Point& a = polygon[i];
+        const RoiMask::Point& b = polygon[j];
+        if (((a.y > y) != (b.y > y)) && (x < (b.x - a.x) * (y - a.y) / (b.y - a.y) + a.x)) {
+            result = !result;
+        }
+    }
+    return result;
+}
+
+std::string polygonJson(const RoiMask::Polygon& polygon) {
+    std::string text = "[";
+    for (size_t i = 0; i < polygon.size(); i++) {
+        text += (i ? ",[" : "[") + std::to_string(polygon[i].x) + "," + std::to_string(polygon[i].y) + "]";
+    }
+    return text + "]";
+}
+
+std::string polygonsJson(const std::vector<RoiMask::Polygon>& polygons) {
+    std::string text = "[";
+    for (size_t i = 0; i < polygons.size(); i++) {
+        text += (i ? "," : "") + polygonJson(polygons[i]);
+    }
+    return text + "]";
+}
+
+template <typename Fn>
+double timePerBox(size_t boxes, int rounds, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(boxes) * rounds);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t boxes = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 5000;
+    int rounds = (argc > 2) ? atoi(argv[2]) : 200;
+    int cellSize = (argc > 3) ? atoi(argv[3]) : 16;
+    if (boxes == 0) boxes = 1;
+    if (rounds <= 0) rounds = 1;
+    if (cellSize <= 0) cellSize = 16;
+
+    Logger::getInstance().init("./bench_logs", LogLevel::WARNING);
+
+    // 축사 한 화면: 바닥 사다리꼴 안쪽만 의미가 있고, 칸막이/통로/사료조는 제외
+    std::vector<RoiMask::Polygon> include = {
+        {{120, 1080}, {1800, 1080}, {1500, 220}, {420, 220}}
+    };
+    std::vector<RoiMask::Polygon> exclude = {
+        rect(0, 0, 1920, 240),        // 천장/벽
+        rect(880, 220, 160, 860),     // 가운데 통로
+        rect(300, 900, 1320, 180),    // 사료조
+        {{420, 220}, {600, 220}, {360, 1080}, {120, 1080}},    // 왼쪽 칸막이
+        {{1320, 220}, {1500, 220}, {1800, 1080}, {1560, 1080}} // 오른쪽 칸막이
+    };
+
+    RoiMask centerMask;
+    RoiMask overlapMask;
+    if (!centerMask.build(FRAME_WIDTH, FRAME_HEIGHT, cellSize, include, exclude, RoiMask::Mode::CENTER) ||
+        !overlapMask.build(FRAME_WIDTH, FRAME_HEIGHT, cellSize, include, exclude, RoiMask::Mode::OVERLAP, 0.5f)) {
+        fprintf(stderr, "failed to build mask\n");
+        return 1;
+    }
+
+    std::string rulesText = "{\"cameras\": {\"rgb\": {\"mask\": {\"frame\": [" + std::to_string(FRAME_WIDTH) + "," +
+                            std::to_string(FRAME_HEIGHT) + "], \"cell_size\": " + std::to_string(cellSize) +
+                            ", \"presets\": {\"default\": {\"include\": " + polygonsJson(include) +
+                            ", \"exclude\": " + polygonsJson(exclude) + "}}}}}}";
+    std::unique_ptr<DetectionRules> rules = DetectionRules::compile(rulesText);
+    if (!rules) {
+        fprintf(stderr, "failed to compile rules\n");
+        return 1;
+    }
+
+    // 합성 박스 (소 한 마리 크기 근처)
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> xDist(0, FRAME_WIDTH - 1);
+    std::uniform_int_distribution<int> yDist(0, FRAME_HEIGHT - 1);
+    std::uniform_int_distribution<int> sizeDist(40, 360);
+    std::uniform_int_distribution<int> classDist(0, NUM_CLASSES - 1);
+    std::vector<DetectedObject> objects(boxes);
+    for (DetectedObject& obj : objects) {
+        obj.classId = classDist(rng);
+        obj.confidence = 0.9f;
+        obj.bbox = {xDist(rng), yDist(rng), sizeDist(rng), sizeDist(rng)};
+        obj.color = BboxColor::NONE;
+        obj.hasBbox = false;
+    }
+
+    printf("frame=%dx%d cell=%d grid=%dx%d allowed=%.1f%% boxes=%zu rounds=%d\n",
+           FRAME_WIDTH, FRAME_HEIGHT, cellSize, centerMask.columns(), centerMask.rows(),
+           100.0 * centerMask.allowedCells() / (centerMask.columns() * centerMask.rows()), boxes, rounds);
+
+    size_t polygonKept = 0;
+    size_t agree = 0;
+    double polygonNs = timePerBox(boxes, rounds, [&]() {
+        polygonKept = 0;
+        agree = 0;
+        for (const DetectedObject& obj : objects) {
+            float x = obj.bbox.x + obj.bbox.width * 0.5f;
+            float y = obj.bbox.y + obj.bbox.height * 0.5f;
+            bool allowed = false;
+            for (const RoiMask::Polygon& polygon : include) {
+                allowed |= inside(polygon, x, y);
+            }
+            for (const RoiMask::Polygon& polygon : exclude) {
+                allowed &= !inside(polygon, x, y);
+            }
+            polygonKept += allowed;
+            agree += (allowed == centerMask.containsCenter(obj.bbox));
+        }
+    });
+
+    size_t centerKept = 0;
+    double centerNs = timePerBox(boxes, rounds, [&]() {
+        centerKept = 0;
+        for (const DetectedObject& obj : objects) {
+            centerKept += centerMask.accepts(obj.bbox);
+        }
+    });
+
+    size_t overlapKept = 0;
+    double overlapNs = timePerBox(boxes, rounds, [&]() {
+        overlapKept = 0;
+        for (const DetectedObject& obj : objects) {
+            overlapKept += overlapMask.accepts(obj.bbox);
+        }
+    });
+
+    // apply는 배열을 압축하므로 매 라운드 원본을 복사해 넣는다 (복사 비용 포함)
+    std::vector<DetectedObject> scratch(boxes);
+    size_t rulesKept = 0;
+    double rulesNs = timePerBox(boxes, rounds, [&]() {
+        scratch.assign(objects.begin(), objects.end());
+        rulesKept = rules->apply(CameraType::RGB, -1, 0, scratch.data(), scratch.size());
+    });
+
+    printf("  polygon  %7.1f ns/box  kept %5.1f%%\n", polygonNs, 100.0 * polygonKept / boxes);
+    printf("  center   %7.1f ns/box  kept %5.1f%%  (agrees with polygon %.2f%%)\n", centerNs,
+           100.0 * centerKept / boxes, 100.0 * agree / boxes);
+    printf("  overlap  %7.1f ns/box  kept %5.1f%%\n", overlapNs, 100.0 * overlapKept / boxes);
+    printf("  rules    %7.1f ns/box  kept %5.1f%%\n", rulesNs, 100.0 * rulesKept / boxes);
+    return 0;
+}
@@ -0,0 +1,173 @@
+// HttpParser 퍼즈 하네스
+// 같은 입력을 한 번에 파싱한 결과와 임의 지점에서 나눠(버퍼 주소도 바꿔 가며) 증분 파싱한
+// 결과가 같은지, 반환된 view가 입력 범위를 벗어나지 않는지 확인한다.
+//
+// clang(libFuzzer): http_parser_fuzz [corpus_dir]
+// 그 외 컴파일러: http_parser_fuzz [iterations] 또는 http_parser_fuzz file...
+//   (시드 요청을 무작위로 변형해 반복 실행)
+
+#include "api/HttpParser.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+void check(bool condition, const char* message) {
+    if (!condition) {
+        fprintf(stderr, "http_parser_fuzz: %s\n", message);
+        abort();
+    }
+}
+
+void checkView(std::string_view view, const char* base, size_t size) {
+    check(view.empty() || (view.data() >= base && view.data() + view.size() <= base + size),
+          "view outside of input");
+}
+
+struct Result {
+    HttpParser::Status status;
+    int errorStatus;
+    size_t consumed;
+    std::string method, path, version, body;
+    std::vector<std::string> headers;
+};
+
+Result capture(const HttpParser& parser, const char* base, size_t size) {
+    Result result;
+    result.status = parser.status();
+    result.errorStatus = parser.errorStatus();
+    result.consumed = parser.consumed();
+    if (result.status != HttpParser::Status::COMPLETE) {
+        return result;
+    }
+
+    check(result.consumed > 0 && result.consumed <= size, "bad consumed length");
+    checkView(parser.method(), base, size);
+    checkView(parser.path(), base, size);
+    checkView(parser.version(), base, size);
+    checkView(parser.body(), base, size);
+
+    result.method = std::string(parser.method());
+    result.path = std::string(parser.path());
+    result.version = std::string(parser.version());
+    result.body = std::string(parser.body());
+    for (size_t i = 0; i < parser.headerCount(); i++) {
+        checkView(parser.headerName(i), base, size);
+        checkView(parser.headerValue(i), base, size);
+        result.headers.push_back(std::string(parser.headerName(i)) + ":" +
+                                 std::string(parser.headerValue(i)));
+    }
+    (void)parser.keepAlive();
+    return result;
+}
+
+bool sameResult(const Result& a, const Result& b) {
+    return a.status == b.status && a.errorStatus == b.errorStatus && a.consumed == b.consumed &&
+           a.method == b.method && a.path == b.path && a.version == b.version &&
+           a.body == b.body && a.headers == b.headers;
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size < 2) {
+        return 0;
+    }
+
+    // 첫 바이트는 조각 크기 시드
+    size_t step = 1 + data[0] % 17;
+    const char* input = reinterpret_cast<const char*>(data + 1);
+    size_t length = size - 1;
+
+    HttpParser::Limits limits;
+    limits.maxHeaderSize = 512;
+    limits.maxBodySize = 1024;
+    limits.maxHeaderCount = 8;
+
+    // 한 번에 파싱
+    std::vector<char> whole(input, input + length);
+    HttpParser oneShot(limits);
+    oneShot.parse(whole.data(), whole.size());
+    Result expected = capture(oneShot, whole.data(), whole.size());
+
+    // 조각 단위로 증분 파싱, 호출마다 다른 주소의 버퍼로 옮긴다
+    HttpParser incremental(limits);
+    std::vector<char> buffers[2];
+    size_t used = 0;
+    int current = 0;
+    while (used < length && incremental.status() == HttpParser::Status::INCOMPLETE) {
+        used = std::min(length, used + step);
+        current ^= 1;
+        buffers[current].assign(input, input + used);
+        incremental.parse(buffers[current].data(), used);
+    }
+    Result actual = capture(incremental, buffers[current].data(), used);
+
+    check(sameResult(expected, actual), "incremental parse differs from one-shot parse");
+    check(expected.status != HttpParser::Status::ERROR || expected.errorStatus >= 400,
+          "error without HTTP status");
+    return 0;
+}
+
+#ifndef HTTP_PARSER_FUZZ_LIBFUZZER
+int main(int argc, char* argv[]) {
+    // 파일 인자: 각 파일을 입력으로 한 번씩 실행
+    if (argc > 1 && std::strtoul(argv[1], nullptr, 10) == 0) {
+        for (int i = 1; i < argc; i++) {
+            std::ifstream file(argv[i], std::ios::binary);
+            std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                                      std::istreambuf_iterator<char>());
+            LLVMFuzzerTestOneInput(data.data(), data.size());
+        }
+        return 0;
+    }
+
+    size_t iterations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const char* seeds[] = {
+        "POST /api/get_latest HTTP/1.1\r\nHost: x\r\nContent-Length: 23\r\n\r\n"
+        "{\"camera\":\"RGB_Camera\"}",
+        "GET /metrics HTTP/1.0\r\nConnection: keep-alive\r\n\r\n",
+        "\r\nPOST /a HTTP/1.1\r\ncontent-length: 3\r\nCONTENT-LENGTH: 3\r\n\r\nabcGET / HTTP/1.1\r\n\r\n",
+        "POST /a HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n0\r\n\r\n",
+    };
+    const char dictionary[] = " :\r\n\t0123456789HTTP/1.01GETPOSTContent-Length";
+
+    std::mt19937 rng(12345);
+    std::vector<uint8_t> input;
+    for (size_t i = 0; i < iterations; i++) {
+        const char* seed = seeds[rng() % (sizeof(seeds) / sizeof(seeds[0]))];
+        input.assign(1, static_cast<uint8_t>(rng()));
+        input.insert(input.end(), seed, seed + strlen(seed));
+
+        // 무작위 변형: 바이트 교체 / 삽입 / 삭제
+        int mutations = rng() % 6;
+        for (int m = 0; m < mutations && input.size() > 1; m++) {
+            size_t pos = 1 + rng() % (input.size() - 1);
+            switch (rng() % 3) {
+                case 0:
+                    input[pos] = (rng() % 2) ? static_cast<uint8_t>(rng())
+                                             : dictionary[rng() % (sizeof(dictionary) - 1)];
+                    break;
+                case 1:
+                    input.insert(input.begin() + pos, dictionary[rng() % (sizeof(dictionary) - 1)]);
+                    break;
+                default:
+                    input.erase(input.begin() + pos);
+                    break;
+            }
+        }
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+
+    printf("http_parser_fuzz: %zu iterations OK\n", iterations);
+    return 0;
+}
+#endif
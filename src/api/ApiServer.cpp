@@ -1,28 +1,69 @@
 #include "ApiServer.h"
+#include "JsonDetectionWriter.h"
+#include "DetectionCodec.h"
+#include "DetectionStreamHub.h"
 #include "../detection/DetectionBuffer.h"
+#include "../pipeline/LatencyTrace.h"
 #include "../utils/Logger.h"
+#include "../utils/Metrics.h"
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <poll.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <cstring>
+#include <algorithm>
+#include <cctype>
 #include <sstream>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
-ApiServer::ApiServer(int port)
+ApiServer::ApiServer(int port, size_t workerThreads, size_t maxConnections,
+                     int keepAliveTimeoutMs)
     : port_(port)
     , serverSocket_(-1)
-    , running_(false) {
+    , epollFd_(-1)
+    , wakeFd_(-1)
+    , running_(false)
+    , maxConnections_(std::max<size_t>(maxConnections, 1))
+    , keepAliveTimeoutMs_(std::max(keepAliveTimeoutMs, 100))
+    , parserLimits_()
+    , workerCount_(std::max<size_t>(workerThreads, 1))
+    , streamHub_(std::make_unique<DetectionStreamHub>()) {
+    
+    parserLimits_.maxHeaderSize = MAX_HEADER_SIZE;
+    parserLimits_.maxBodySize = MAX_BODY_SIZE;
+    
+    // 등록되지 않은 경로는 한 시계열로 모은다 (경로별 라벨 폭증 방지)
+    notFoundLatency_ = &MetricsRegistry::getInstance().histogram(
+        "api_request_duration_seconds", "API request latency (handler and response write)",
+        Histogram::latencyBuckets(), {{"method", "any"}, {"route", "unmatched"}});
     
     // 기본 라우트 등록
     addRoute("POST", "/api/get_detections", 
-             [this](const Request& req) { return handleGetDetections(req); });
+             [this](const Request& req) { return handleGetDetections(req, false); });
+    addRoute("POST", "/api/get_detections_bin", 
+             [this](const Request& req) { return handleGetDetections(req, true); });
     addRoute("POST", "/api/get_latest", 
              [this](const Request& req) { return handleGetLatest(req); });
+    addRoute("GET", "/api/stream", 
+             [this](const Request& req) { return handleStream(req); });
+    addRoute("GET", "/api/cache_stats", 
+             [this](const Request& req) { return handleCacheStats(req); });
+    addRoute("GET", "/api/log_stats", 
+             [this](const Request& req) { return handleLogStats(req); });
+    addRoute("GET", "/api/latency", 
+             [this](const Request& req) { return handleLatency(req); });
+    addRoute("GET", "/metrics", 
+             [this](const Request& req) { return handleMetrics(req); });
     
-    LOG_INFO("API Server created on port %d", port);
+    LOG_INFO("API Server created on port %d (workers=%zu, max_connections=%zu, keepalive=%dms)",
+             port, workerCount_, maxConnections_, keepAliveTimeoutMs_);
 }
 
 ApiServer::~ApiServer() {
@@ -35,8 +76,8 @@ bool ApiServer::start() {
         return true;
     }
     
-    // 서버 소켓 생성
-    serverSocket_ = socket(AF_INET, SOCK_STREAM, 0);
+    // 서버 소켓 생성 (논블로킹)
+    serverSocket_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
     if (serverSocket_ < 0) {
         LOG_ERROR("Failed to create server socket: %s", strerror(errno));
         return false;
@@ -66,16 +107,44 @@ bool ApiServer::start() {
     }
     
     // 리슨
-    if (listen(serverSocket_, 10) < 0) {
+    if (listen(serverSocket_, SOMAXCONN) < 0) {
         LOG_ERROR("Failed to listen: %s", strerror(errno));
         close(serverSocket_);
         serverSocket_ = -1;
         return false;
     }
     
-    // 서버 스레드 시작
+    // epoll 및 wakeup eventfd 생성
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd_ < 0 || wakeFd_ < 0) {
+        LOG_ERROR("Failed to create epoll/eventfd: %s", strerror(errno));
+        if (epollFd_ >= 0) close(epollFd_);
+        if (wakeFd_ >= 0) close(wakeFd_);
+        close(serverSocket_);
+        epollFd_ = wakeFd_ = serverSocket_ = -1;
+        return false;
+    }
+    
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = nullptr;  // nullptr = 리슨 소켓
+    epoll_ctl(epollFd_, EPOLL_CTL_ADD, serverSocket_, &ev);
+    ev.data.ptr = &wakeFd_;
+    epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &ev);
+    
+    // 실시간 스트림 허브 시작 (실패해도 나머지 API는 동작)
+    if (!streamHub_->start()) {
+        LOG_WARN("Detection stream hub not available");
+    }
+    
+    // 리액터 및 워커 스레드 시작
     running_ = true;
     serverThread_ = std::thread(&ApiServer::serverThread, this);
+    for (size_t i = 0; i < workerCount_; i++) {
+        workers_.emplace_back(&ApiServer::workerThread, this);
+    }
     
     LOG_INFO("API Server started on port %d", port_);
     return true;
@@ -86,13 +155,17 @@ void ApiServer::stop() {
         return;
     }
     
-    running_ = false;
+    // 작업자는 queueMutex_를 잡고 조건을 확인한 뒤 잠든다.
+    // 잠금 없이 내리면 확인과 잠듦 사이에 끼어들어 아래 notify_all을 놓치고 join이 멈춘다
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        running_ = false;
+    }
     
-    // 서버 소켓 닫기
-    if (serverSocket_ >= 0) {
-        shutdown(serverSocket_, SHUT_RDWR);
-        close(serverSocket_);
-        serverSocket_ = -1;
+    // 리액터 깨우기
+    uint64_t one = 1;
+    if (write(wakeFd_, &one, sizeof(one)) < 0) {
+        LOG_WARN("Failed to wake API reactor: %s", strerror(errno));
     }
     
     // 스레드 종료 대기
@@ -100,6 +173,35 @@ void ApiServer::stop() {
         serverThread_.join();
     }
     
+    queueCond_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+    requestQueue_.clear();
+    
+    streamHub_->stop();
+    
+    // 남은 연결 정리
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        for (auto& pair : connections_) {
+            close(pair.first);
+        }
+        connections_.clear();
+    }
+    
+    // 서버 소켓 닫기
+    if (serverSocket_ >= 0) {
+        close(serverSocket_);
+        serverSocket_ = -1;
+    }
+    close(epollFd_);
+    close(wakeFd_);
+    epollFd_ = wakeFd_ = -1;
+    
     LOG_INFO("API Server stopped");
 }
 
@@ -113,147 +215,539 @@ void ApiServer::registerDetectionBuffer(CameraType type, DetectionBuffer* buffer
             detectionBuffers_.resize(static_cast<size_t>(type) + 1, nullptr);
         }
         detectionBuffers_[static_cast<size_t>(type)] = buffer;
+        streamHub_->attachBuffer(type, buffer);
         LOG_INFO("Registered detection buffer for %s camera",
                  (type == CameraType::RGB) ? "RGB" : "THERMAL");
     }
 }
 
+void ApiServer::registerLatencyTrace(CameraType type, LatencyTrace* trace) {
+    if (trace) {
+        if (static_cast<size_t>(type) >= latencyTraces_.size()) {
+            latencyTraces_.resize(static_cast<size_t>(type) + 1, nullptr);
+        }
+        latencyTraces_[static_cast<size_t>(type)] = trace;
+    }
+}
+
 void ApiServer::addRoute(const std::string& method, const std::string& path, 
                         RequestHandler handler) {
     std::string key = method + ":" + path;
-    routes_[key] = handler;
+    routes_[key] = Route{handler, &MetricsRegistry::getInstance().histogram(
+        "api_request_duration_seconds", "API request latency (handler and response write)",
+        Histogram::latencyBuckets(), {{"method", method}, {"route", path}})};
     LOG_DEBUG("Added route: %s %s", method.c_str(), path.c_str());
 }
 
 void ApiServer::serverThread() {
+    constexpr int MAX_EVENTS = 64;
+    struct epoll_event events[MAX_EVENTS];
+    
+    // 유휴 연결 검사 주기 (타임아웃의 1/4, 100ms ~ 1s)
+    const auto sweepInterval = std::chrono::milliseconds(
+        std::min(std::max(keepAliveTimeoutMs_ / 4, 100), 1000));
+    auto lastSweep = std::chrono::steady_clock::now();
+    
     while (running_) {
+        int count = epoll_wait(epollFd_, events, MAX_EVENTS,
+                               static_cast<int>(sweepInterval.count()));
+        if (count < 0) {
+            if (errno != EINTR) {
+                LOG_ERROR("epoll_wait failed: %s", strerror(errno));
+            }
+            continue;
+        }
+        
+        for (int i = 0; i < count; i++) {
+            void* ptr = events[i].data.ptr;
+            if (ptr == nullptr) {
+                acceptConnections();
+            } else if (ptr == &wakeFd_) {
+                uint64_t value;
+                while (read(wakeFd_, &value, sizeof(value)) > 0) {}
+            } else {
+                readConnection(static_cast<Connection*>(ptr));
+            }
+        }
+        
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastSweep >= sweepInterval) {
+            closeIdleConnections();
+            lastSweep = now;
+        }
+    }
+}
+
+void ApiServer::acceptConnections() {
+    while (true) {
         struct sockaddr_in clientAddr;
         socklen_t clientLen = sizeof(clientAddr);
         
-        // 클라이언트 연결 수락
-        int clientSocket = accept(serverSocket_, (struct sockaddr*)&clientAddr, &clientLen);
+        // 클라이언트 연결 수락 (큐가 빌 때까지)
+        int clientSocket = accept4(serverSocket_, (struct sockaddr*)&clientAddr, &clientLen,
+                                   SOCK_NONBLOCK | SOCK_CLOEXEC);
         if (clientSocket < 0) {
-            if (running_ && errno != EINTR) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
                 LOG_ERROR("Failed to accept connection: %s", strerror(errno));
             }
+            return;
+        }
+        
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        
+        // 연결 수 제한
+        if (connections_.size() >= maxConnections_) {
+            LOG_WARN("Connection limit reached (%zu), rejecting %s",
+                     maxConnections_, inet_ntoa(clientAddr.sin_addr));
+            close(clientSocket);
+            continue;
+        }
+        
+        // 응답은 직접 버퍼링해서 보내므로 Nagle 지연 비활성화
+        int noDelay = 1;
+        setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        
+        auto conn = std::make_unique<Connection>(parserLimits_);
+        conn->fd = clientSocket;
+        conn->buffer.resize(INITIAL_BUFFER_SIZE);
+        conn->begin = 0;
+        conn->end = 0;
+        conn->requestCount = 0;
+        conn->busy = false;
+        conn->peerClosed = false;
+        conn->lastActivity = std::chrono::steady_clock::now();
+        
+        // EPOLLONESHOT: 워커가 처리 중인 연결은 이벤트를 받지 않는다
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        ev.data.ptr = conn.get();
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, clientSocket, &ev) < 0) {
+            LOG_ERROR("Failed to register connection: %s", strerror(errno));
+            close(clientSocket);
             continue;
         }
         
-        // 클라이언트 처리 (별도 스레드)
-        std::thread clientThread(&ApiServer::handleClient, this, clientSocket);
-        clientThread.detach();
+        connections_[clientSocket] = std::move(conn);
     }
 }
 
-void ApiServer::handleClient(int clientSocket) {
-    char buffer[4096];
-    std::string requestData;
+void ApiServer::readConnection(Connection* conn) {
+    bool peerClosed = false;
     
-    // HTTP 요청 읽기
+    // 논블로킹으로 가능한 만큼 연결 버퍼에 직접 읽기
     while (true) {
-        ssize_t bytesRead = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
-        if (bytesRead <= 0) {
-            break;
+        if (conn->end == conn->buffer.size()) {
+            if (conn->begin > 0) {
+                // 처리한 요청 앞부분 제거 (파서 위치는 요청 시작 기준이라 그대로 유효)
+                memmove(conn->buffer.data(), conn->buffer.data() + conn->begin,
+                        conn->end - conn->begin);
+                conn->end -= conn->begin;
+                conn->begin = 0;
+            } else if (conn->buffer.size() < MAX_BUFFER_SIZE) {
+                conn->buffer.resize(std::min(conn->buffer.size() * 2, MAX_BUFFER_SIZE));
+            } else {
+                break;  // 최대 크기 요청이 이미 버퍼에 있음
+            }
         }
         
-        buffer[bytesRead] = '\0';
-        requestData += buffer;
-        
-        // 헤더 종료 확인
-        if (requestData.find("\r\n\r\n") != std::string::npos) {
-            break;
+        ssize_t bytesRead = recv(conn->fd, conn->buffer.data() + conn->end,
+                                 conn->buffer.size() - conn->end, 0);
+        if (bytesRead > 0) {
+            conn->end += bytesRead;
+            continue;
+        }
+        if (bytesRead == 0) {
+            peerClosed = true;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            peerClosed = true;
         }
+        break;
     }
     
-    if (requestData.empty()) {
-        close(clientSocket);
+    // 요청이 완성되지 않았으면 더 기다린다 (새로 받은 부분만 파싱)
+    if (parsePending(conn) == HttpParser::Status::INCOMPLETE) {
+        if (peerClosed || !rearmConnection(conn)) {
+            closeConnection(conn);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        conn->lastActivity = std::chrono::steady_clock::now();
         return;
     }
     
-    // 요청 파싱
-    Request request = parseRequest(requestData);
+    // 워커에 넘긴다 (큐가 가득 차면 거절)
+    // 상대가 쓰기를 닫았으면 남은 요청만 처리하고 닫는다
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        conn->peerClosed = peerClosed;
+        conn->busy = true;
+        conn->lastActivity = std::chrono::steady_clock::now();
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (requestQueue_.size() < maxConnections_) {
+            requestQueue_.push_back(conn);
+            queueCond_.notify_one();
+            return;
+        }
+    }
     
-    // Content-Length 확인 및 body 읽기
-    size_t headerEnd = requestData.find("\r\n\r\n");
-    if (headerEnd != std::string::npos) {
-        std::string headers = requestData.substr(0, headerEnd);
-        size_t contentLengthPos = headers.find("Content-Length:");
-        
-        if (contentLengthPos != std::string::npos) {
-            size_t valueStart = contentLengthPos + 15;
-            size_t valueEnd = headers.find("\r\n", valueStart);
-            int contentLength = std::stoi(headers.substr(valueStart, valueEnd - valueStart));
-            
-            // 이미 읽은 body 부분
-            request.body = requestData.substr(headerEnd + 4);
-            
-            // 나머지 body 읽기
-            while (static_cast<int>(request.body.length()) < contentLength) {
-                ssize_t bytesRead = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
-                if (bytesRead <= 0) break;
-                request.body.append(buffer, bytesRead);
+    LOG_WARN("API request queue full, rejecting request");
+    sendResponse(conn->fd, errorResponse(503, "Server busy"));
+    closeConnection(conn);
+}
+
+bool ApiServer::rearmConnection(Connection* conn) {
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    ev.data.ptr = conn;
+    return epoll_ctl(epollFd_, EPOLL_CTL_MOD, conn->fd, &ev) == 0;
+}
+
+void ApiServer::closeConnection(Connection* conn) {
+    std::lock_guard<std::mutex> lock(connectionsMutex_);
+    int fd = conn->fd;
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections_.erase(fd);  // conn 해제
+}
+
+int ApiServer::detachConnection(Connection* conn) {
+    // epoll/연결 목록에서 빼고 소켓은 닫지 않는다
+    std::lock_guard<std::mutex> lock(connectionsMutex_);
+    int fd = conn->fd;
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+    connections_.erase(fd);  // conn 해제
+    return fd;
+}
+
+void ApiServer::closeIdleConnections() {
+    auto deadline = std::chrono::steady_clock::now() -
+                    std::chrono::milliseconds(keepAliveTimeoutMs_);
+    
+    // 워커가 처리 중인 연결은 건너뛴다
+    std::lock_guard<std::mutex> lock(connectionsMutex_);
+    for (auto it = connections_.begin(); it != connections_.end();) {
+        Connection* conn = it->second.get();
+        if (!conn->busy && conn->lastActivity < deadline) {
+            LOG_DEBUG("Closing idle API connection (fd=%d)", conn->fd);
+            epoll_ctl(epollFd_, EPOLL_CTL_DEL, conn->fd, nullptr);
+            close(conn->fd);
+            it = connections_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ApiServer::workerThread() {
+    while (true) {
+        Connection* conn = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCond_.wait(lock, [this]() { return !running_ || !requestQueue_.empty(); });
+            if (!running_) {
+                return;
             }
+            conn = requestQueue_.front();
+            requestQueue_.pop_front();
         }
+        
+        handleClient(conn);
     }
+}
+
+void ApiServer::handleClient(Connection* conn) {
+    bool keepAlive = true;
     
-    // 라우트 찾기 및 처리
-    std::string routeKey = request.method + ":" + request.path;
-    Response response;
-    
-    auto it = routes_.find(routeKey);
-    if (it != routes_.end()) {
-        response = it->second(request);
-    } else {
-        response = handleNotFound(request);
+    // 버퍼에 쌓인 요청을 순서대로 처리 (파이프라이닝)
+    while (keepAlive && running_) {
+        HttpParser::Status status = parsePending(conn);
+        
+        if (status == HttpParser::Status::ERROR) {
+            int errorStatus = conn->parser.errorStatus();
+            LOG_WARN("Rejecting malformed API request (status %d)", errorStatus);
+            sendResponse(conn->fd, errorResponse(errorStatus, "Bad request"));
+            keepAlive = false;
+            break;
+        }
+        if (status == HttpParser::Status::INCOMPLETE) {
+            break;  // 나머지는 아직 도착하지 않음
+        }
+        
+        // 버퍼를 가리키는 view로 요청 구성 (복사 없음)
+        const HttpParser& parser = conn->parser;
+        Request request;
+        request.method = parser.method();
+        request.path = parser.path();
+        request.version = parser.version();
+        size_t queryStart = request.path.find('?');
+        if (queryStart != std::string_view::npos) {
+            request.query = request.path.substr(queryStart + 1);
+            request.path = request.path.substr(0, queryStart);
+        }
+        request.body = parser.body();
+        request.keepAlive = parser.keepAlive();
+        request.parser = &parser;
+        
+        // 라우트 찾기 및 처리
+        std::string routeKey;
+        routeKey.reserve(request.method.size() + 1 + request.path.size());
+        routeKey.append(request.method).append(1, ':').append(request.path);
+        Response response;
+        auto started = std::chrono::steady_clock::now();
+        Histogram* latency = notFoundLatency_;
+        
+        auto it = routes_.find(routeKey);
+        if (it != routes_.end()) {
+            response = it->second.handler(request);
+            latency = it->second.latency;
+        } else {
+            response = handleNotFound(request);
+        }
+        
+        // 장기 스트림: 헤더만 보내고 소켓을 넘긴다
+        if (response.takeover) {
+            bool sent = sendResponse(conn->fd, response);
+            latency->observe(std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - started).count());
+            if (!sent) {
+                closeConnection(conn);
+                return;
+            }
+            TakeoverHandler takeover = std::move(response.takeover);
+            int fd = detachConnection(conn);
+            if (!takeover(fd)) {
+                close(fd);
+            }
+            return;
+        }
+        
+        // HTTP/1.0 클라이언트는 chunked를 모르므로 스트림 본문은 연결 종료로 끝낸다 (RFC 7230 3.3.1)
+        bool chunked = request.version != "HTTP/1.0";
+        keepAlive = request.keepAlive && ++conn->requestCount < MAX_REQUESTS_PER_CONNECTION &&
+                    (chunked || !response.stream);
+        if (!sendResponse(conn->fd, response, keepAlive, chunked)) {
+            keepAlive = false;
+        }
+        latency->observe(std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - started).count());
+        
+        // 다음 요청으로 (버퍼가 비면 처음부터 재사용)
+        conn->begin += parser.consumed();
+        if (conn->begin == conn->end) {
+            conn->begin = conn->end = 0;
+        }
+        conn->parser.reset();
     }
     
-    // 응답 전송
-    std::string responseStr = buildResponse(response);
-    send(clientSocket, responseStr.c_str(), responseStr.length(), 0);
+    if (!keepAlive || !running_ || conn->peerClosed) {
+        closeConnection(conn);
+        return;
+    }
     
-    close(clientSocket);
+    std::lock_guard<std::mutex> lock(connectionsMutex_);
+    conn->busy = false;
+    conn->lastActivity = std::chrono::steady_clock::now();
+    if (!rearmConnection(conn)) {
+        epoll_ctl(epollFd_, EPOLL_CTL_DEL, conn->fd, nullptr);
+        close(conn->fd);
+        connections_.erase(conn->fd);
+    }
 }
 
-ApiServer::Request ApiServer::parseRequest(const std::string& rawRequest) {
-    Request request;
-    std::istringstream stream(rawRequest);
-    std::string line;
+HttpParser::Status ApiServer::parsePending(Connection* conn) {
+    return conn->parser.parse(conn->buffer.data() + conn->begin, conn->end - conn->begin);
+}
+
+ApiServer::Response ApiServer::errorResponse(int statusCode, const char* message) const {
+    Response response;
+    response.statusCode = statusCode;
+    response.contentType = "application/json";
     
-    // 첫 줄 파싱 (METHOD PATH HTTP/1.1)
-    if (std::getline(stream, line)) {
-        std::istringstream lineStream(line);
-        lineStream >> request.method >> request.path;
-    }
+    json errorJson;
+    errorJson["status"] = "error";
+    errorJson["message"] = message;
+    response.body = errorJson.dump();
     
-    return request;
+    return response;
 }
 
-std::string ApiServer::buildResponse(const Response& response) {
+std::string ApiServer::buildResponse(const Response& response, bool keepAlive, bool chunked) {
     std::ostringstream oss;
     
     // 상태 줄
     oss << "HTTP/1.1 " << response.statusCode << " ";
     switch (response.statusCode) {
         case 200: oss << "OK"; break;
+        case 400: oss << "Bad Request"; break;
         case 404: oss << "Not Found"; break;
+        case 413: oss << "Payload Too Large"; break;
+        case 431: oss << "Request Header Fields Too Large"; break;
         case 500: oss << "Internal Server Error"; break;
+        case 501: oss << "Not Implemented"; break;
+        case 503: oss << "Service Unavailable"; break;
+        case 505: oss << "HTTP Version Not Supported"; break;
         default: oss << "Unknown"; break;
     }
     oss << "\r\n";
     
     // 헤더
     oss << "Content-Type: " << response.contentType << "\r\n";
-    oss << "Content-Length: " << response.body.length() << "\r\n";
+    if (response.takeover) {
+        // 연결 종료로 끝나는 본문 (프록시 버퍼링 방지)
+        oss << "Cache-Control: no-cache\r\n";
+        oss << "X-Accel-Buffering: no\r\n";
+        keepAlive = false;
+    } else if (response.stream && chunked) {
+        oss << "Transfer-Encoding: chunked\r\n";
+    } else if (response.stream) {
+        // 연결 종료로 끝나는 본문 (HTTP/1.0)
+        keepAlive = false;
+    } else {
+        size_t length = response.sharedBody ? response.sharedBody->size() : response.body.size();
+        oss << "Content-Length: " << length << "\r\n";
+    }
+    if (keepAlive) {
+        oss << "Connection: keep-alive\r\n";
+        oss << "Keep-Alive: timeout=" << std::max(keepAliveTimeoutMs_ / 1000, 1) << "\r\n";
+    } else {
+        oss << "Connection: close\r\n";
+    }
     oss << "Access-Control-Allow-Origin: *\r\n";
     oss << "\r\n";
     
-    // 바디
-    oss << response.body;
-    
     return oss.str();
 }
 
-ApiServer::Response ApiServer::handleGetDetections(const Request& request) {
+bool ApiServer::sendResponse(int clientSocket, const Response& response, bool keepAlive, bool chunked) {
+    std::string head = buildResponse(response, keepAlive, chunked);
+    
+    // 헤더 + 본문을 한 번의 sendmsg로 (본문 복사 없음)
+    if (!response.stream) {
+        const std::string& body = response.sharedBody ? *response.sharedBody : response.body;
+        struct iovec iov[2];
+        iov[0].iov_base = const_cast<char*>(head.data());
+        iov[0].iov_len = head.size();
+        iov[1].iov_base = const_cast<char*>(body.data());
+        iov[1].iov_len = response.takeover ? 0 : body.size();
+        return sendAllv(clientSocket, iov, 2);
+    }
+    
+    if (!sendAll(clientSocket, head.data(), head.length())) {
+        return false;
+    }
+    
+    bool ok = true;
+    if (!chunked) {
+        // 본문을 그대로 보내고 연결을 닫아 끝을 알린다
+        response.stream([this, clientSocket, &ok](const char* data, size_t length) {
+            if (ok && length > 0) {
+                ok = sendAll(clientSocket, data, length);
+            }
+            return ok;
+        });
+        if (!ok) {
+            LOG_WARN("Streaming response aborted: %s", strerror(errno));
+        }
+        return ok;
+    }
+    
+    // chunked 본문: <hex 길이>\r\n<데이터>\r\n ... 0\r\n\r\n
+    response.stream([this, clientSocket, &ok](const char* data, size_t length) {
+        if (!ok || length == 0) {
+            return ok;
+        }
+        char sizeLine[32];
+        int n = snprintf(sizeLine, sizeof(sizeLine), "%zx\r\n", length);
+        
+        // 작은 조각이 Nagle에 묶이지 않도록 한 번의 sendmsg로 전송
+        struct iovec iov[3];
+        iov[0].iov_base = sizeLine;
+        iov[0].iov_len = n;
+        iov[1].iov_base = const_cast<char*>(data);
+        iov[1].iov_len = length;
+        iov[2].iov_base = const_cast<char*>("\r\n");
+        iov[2].iov_len = 2;
+        ok = sendAllv(clientSocket, iov, 3);
+        return ok;
+    });
+    
+    if (ok) {
+        ok = sendAll(clientSocket, "0\r\n\r\n", 5);
+    }
+    if (!ok) {
+        LOG_WARN("Streaming response aborted: %s", strerror(errno));
+    }
+    return ok;
+}
+
+bool ApiServer::waitWritable(int clientSocket) {
+    // 논블로킹 소켓의 송신 버퍼가 빌 때까지 대기 (느린 클라이언트는 시간 초과로 끊음)
+    struct pollfd pfd;
+    pfd.fd = clientSocket;
+    pfd.events = POLLOUT;
+    pfd.revents = 0;
+    
+    int result;
+    do {
+        result = poll(&pfd, 1, SEND_TIMEOUT_MS);
+    } while (result < 0 && errno == EINTR);
+    
+    return result > 0 && (pfd.revents & POLLOUT);
+}
+
+bool ApiServer::sendAllv(int clientSocket, struct iovec* iov, int count) {
+    while (count > 0) {
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        
+        ssize_t sent = sendmsg(clientSocket, &msg, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR || ((errno == EAGAIN || errno == EWOULDBLOCK) &&
+                                   waitWritable(clientSocket))) {
+                continue;
+            }
+            return false;
+        }
+        
+        // 부분 전송 처리
+        while (count > 0 && static_cast<size_t>(sent) >= iov->iov_len) {
+            sent -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + sent;
+            iov->iov_len -= sent;
+        }
+    }
+    return true;
+}
+
+bool ApiServer::sendAll(int clientSocket, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(clientSocket, data, length, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR || ((errno == EAGAIN || errno == EWOULDBLOCK) &&
+                                   waitWritable(clientSocket))) {
+                continue;
+            }
+            return false;
+        }
+        data += sent;
+        length -= sent;
+    }
+    return true;
+}
+
+ApiServer::Response ApiServer::handleGetDetections(const Request& request, bool binary) {
     Response response;
     response.contentType = "application/json";
     
@@ -292,42 +786,42 @@ ApiServer::Response ApiServer::handleGetDetections(const Request& request) {
             endTs = parseISOTime(endTime);
         }
         
-        // 검출 데이터 조회
-        auto detections = detectionBuffers_[static_cast<size_t>(camType)]->
-                         getDetectionsInTimeRange(startTs, endTs);
+        // 버퍼에서 소켓으로 바로 직렬화 (chunked, 메모리 사용량은 인코더 버퍼 크기로 제한)
+        DetectionBuffer* buffer = detectionBuffers_[static_cast<size_t>(camType)];
+        const char* cameraName = (camType == CameraType::RGB) ? "RGB_Camera" : "Thermal_Camera";
         
-        // JSON 응답 생성
-        json responseJson;
-        responseJson["status"] = "success";
-        responseJson["detections"] = json::array();
-        
-        for (const auto& detection : detections) {
-            json detJson;
-            detJson["timestamp"] = detection.timestamp;
-            detJson["frame_number"] = detection.frameNumber;
-            detJson["camera"] = camera;
-            detJson["objects"] = json::array();
-            
-            for (const auto& obj : detection.objects) {
-                json objJson;
-                objJson["class_id"] = obj.classId;
-                objJson["confidence"] = obj.confidence;
-                objJson["bbox"] = {obj.bbox.x, obj.bbox.y, 
-                                  obj.bbox.x + obj.bbox.width,
-                                  obj.bbox.y + obj.bbox.height};
-                
-                const char* colorNames[] = {"green", "yellow", "red", "blue", "null"};
-                objJson["bbox_color"] = colorNames[static_cast<int>(obj.color)];
-                objJson["has_bbox"] = obj.hasBbox;
-                
-                detJson["objects"].push_back(objJson);
-            }
-            
-            responseJson["detections"].push_back(detJson);
+        // Accept 헤더로 바이너리 포맷 요청 가능
+        if (request.header("accept").find(DetectionCodec::CONTENT_TYPE) != std::string_view::npos) {
+            binary = true;
         }
         
         response.statusCode = 200;
-        response.body = responseJson.dump();
+        
+        if (binary) {
+            response.contentType = DetectionCodec::CONTENT_TYPE;
+            response.stream = [buffer, camType, startTs, endTs](const BodyWriter& write) {
+                DetectionCodec::Writer writer(write);
+                writer.begin(camType);
+                buffer->visitDetectionsInTimeRange(startTs, endTs,
+                    [&writer](const DetectionView& detection) {
+                        writer.writeDetection(detection);
+                    });
+                writer.end();
+                writer.flush();
+            };
+            return response;
+        }
+        
+        response.stream = [buffer, cameraName, startTs, endTs](const BodyWriter& write) {
+            JsonDetectionWriter writer(write);
+            writer.beginDetections();
+            buffer->visitDetectionsInTimeRange(startTs, endTs,
+                [&writer, cameraName](const DetectionView& detection) {
+                    writer.writeDetection(detection, cameraName);
+                });
+            writer.endDetections();
+            writer.flush();
+        };
         
     } catch (const std::exception& e) {
         LOG_ERROR("Error handling get_detections: %s", e.what());
@@ -368,22 +862,27 @@ ApiServer::Response ApiServer::handleGetLatest(const Request& request) {
             throw std::runtime_error("Detection buffer not available");
         }
         
-        // 최신 검출 데이터 조회
-        DetectionData latest;
-        bool hasData = detectionBuffers_[static_cast<size_t>(camType)]->
-                      getLatestDetection(latest);
+        // 같은 세대의 직렬화 결과가 있으면 재사용 (세대는 데이터보다 먼저 읽는다)
+        DetectionBuffer* buffer = detectionBuffers_[static_cast<size_t>(camType)];
+        uint64_t generation = buffer->getGeneration();
+        response.statusCode = 200;
+        response.sharedBody = latestCache_.lookup(camera, generation);
+        if (response.sharedBody) {
+            return response;
+        }
         
         // JSON 응답 생성
         json responseJson;
         
-        if (hasData) {
+        // 최신 검출 데이터 조회 (버퍼 내부 뷰를 직접 직렬화)
+        bool hasData = buffer->visitLatestDetection([&](const DetectionView& latest) {
             responseJson["status"] = "success";
             responseJson["detection"]["timestamp"] = latest.timestamp;
             responseJson["detection"]["frame_number"] = latest.frameNumber;
             responseJson["detection"]["camera"] = camera;
             responseJson["detection"]["objects"] = json::array();
             
-            for (const auto& obj : latest.objects) {
+            for (const auto& obj : latest) {
                 json objJson;
                 objJson["class_id"] = obj.classId;
                 objJson["confidence"] = obj.confidence;
@@ -393,17 +892,20 @@ ApiServer::Response ApiServer::handleGetLatest(const Request& request) {
                 
                 responseJson["detection"]["objects"].push_back(objJson);
             }
-        } else {
+        });
+        
+        if (!hasData) {
             responseJson["status"] = "success";
             responseJson["detection"] = nullptr;
         }
         
-        response.statusCode = 200;
-        response.body = responseJson.dump();
+        response.sharedBody = std::make_shared<const std::string>(responseJson.dump());
+        latestCache_.store(camera, generation, response.sharedBody);
         
     } catch (const std::exception& e) {
         LOG_ERROR("Error handling get_latest: %s", e.what());
         
+        response.sharedBody.reset();
         json errorJson;
         errorJson["status"] = "error";
         errorJson["message"] = e.what();
@@ -415,6 +917,193 @@ ApiServer::Response ApiServer::handleGetLatest(const Request& request) {
     return response;
 }
 
+ApiServer::Response ApiServer::handleStream(const Request& request) {
+    // GET /api/stream?camera=RGB_Camera[&filter=alarm | &classes=1,4]
+    std::string_view camera = request.queryParam("camera");
+    
+    CameraType camType;
+    if (camera == "RGB_Camera") {
+        camType = CameraType::RGB;
+    } else if (camera == "Thermal_Camera") {
+        camType = CameraType::THERMAL;
+    } else {
+        return errorResponse(400, "Invalid camera type");
+    }
+    
+    if (static_cast<size_t>(camType) >= detectionBuffers_.size() ||
+        !detectionBuffers_[static_cast<size_t>(camType)]) {
+        return errorResponse(500, "Detection buffer not available");
+    }
+    
+    // 클래스 필터 (0 = 모든 프레임)
+    uint32_t classMask = 0;
+    std::string_view filter = request.queryParam("filter");
+    std::string_view classes = request.queryParam("classes");
+    if (filter == "alarm") {
+        classMask = DetectionStreamHub::ALARM_CLASS_MASK;
+    } else if (!filter.empty() && filter != "all") {
+        return errorResponse(400, "Invalid filter");
+    }
+    while (!classes.empty()) {
+        size_t comma = classes.find(',');
+        std::string_view item = classes.substr(0, comma);
+        if (item.size() != 1 || item[0] < '0' || item[0] >= '0' + NUM_CLASSES) {
+            return errorResponse(400, "Invalid class id");
+        }
+        classMask |= 1u << (item[0] - '0');
+        classes = (comma == std::string_view::npos) ? std::string_view() : classes.substr(comma + 1);
+    }
+    
+    if (!streamHub_->hasCapacity()) {
+        return errorResponse(503, "Too many stream subscribers");
+    }
+    
+    Response response;
+    response.statusCode = 200;
+    response.contentType = "text/event-stream";
+    response.takeover = [this, camType, classMask](int clientSocket) {
+        return streamHub_->subscribe(clientSocket, camType, classMask);
+    };
+    return response;
+}
+
+ApiServer::Response ApiServer::handleCacheStats(const Request& request) {
+    (void)request;
+    
+    ResponseCache::Stats stats = latestCache_.getStats();
+    uint64_t total = stats.hits + stats.misses;
+    
+    json statsJson;
+    statsJson["status"] = "success";
+    statsJson["routes"]["/api/get_latest"] = {
+        {"hits", stats.hits},
+        {"misses", stats.misses},
+        {"entries", stats.entries},
+        {"hit_ratio", total > 0 ? static_cast<double>(stats.hits) / total : 0.0}
+    };
+    
+    Response response;
+    response.statusCode = 200;
+    response.contentType = "application/json";
+    response.body = statsJson.dump();
+    return response;
+}
+
+// 로거 상태: 큐가 가득 차 버려진 수, 속도 제한으로 억제된 수 (호출 위치별)
+ApiServer::Response ApiServer::handleLogStats(const Request& request) {
+    (void)request;
+    
+    Logger& logger = Logger::getInstance();
+    json sites = json::array();
+    for (const LogSuppression& site : logger.getSuppressionStats()) {
+        std::string level = LogFormat::levelName(static_cast<uint8_t>(site.level));
+        level.erase(level.find_last_not_of(' ') + 1);
+        sites.push_back({
+            {"file", site.file},
+            {"line", site.line},
+            {"level", level},
+            {"format", site.format},
+            {"suppressed", site.suppressed}
+        });
+    }
+    
+    json statsJson;
+    statsJson["status"] = "success";
+    statsJson["dropped"] = logger.getDroppedCount();
+    statsJson["suppressed"] = logger.getSuppressedCount();
+    statsJson["sites"] = std::move(sites);
+    
+    Response response;
+    response.statusCode = 200;
+    response.contentType = "application/json";
+    response.body = statsJson.dump();
+    return response;
+}
+
+// Prometheus 스크레이프 (요소별 처리량, 큐 드롭/채움 정도)
+ApiServer::Response ApiServer::handleMetrics(const Request& request) {
+    (void)request;
+    
+    Response response;
+    response.statusCode = 200;
+    response.contentType = MetricsRegistry::CONTENT_TYPE;
+    response.body = MetricsRegistry::getInstance().renderPrometheus();
+    return response;
+}
+
+// GET /api/latency[?camera=RGB_Camera][&reset=1]
+// 단계별 지연 분포 (us): stage는 부모 단계부터, total은 shmsrc부터
+ApiServer::Response ApiServer::handleLatency(const Request& request) {
+    std::string_view camera = request.queryParam("camera");
+    bool reset = request.queryParam("reset") == "1";
+    
+    auto summaryJson = [](const LatencyHistogram::Summary& summary) {
+        return json{
+            {"count", summary.count},
+            {"mean", summary.mean},
+            {"min", summary.count > 0 ? summary.min : 0},
+            {"p50", summary.p50},
+            {"p90", summary.p90},
+            {"p99", summary.p99},
+            {"p999", summary.p999},
+            {"max", summary.max}
+        };
+    };
+    
+    json cameras = json::array();
+    for (LatencyTrace* trace : latencyTraces_) {
+        if (!trace || (!camera.empty() && camera != trace->getName())) {
+            continue;
+        }
+        
+        json stages = json::array();
+        for (const LatencyTrace::StageStats& stage : trace->getStats()) {
+            json stageJson = {
+                {"name", stage.name},
+                {"total_us", summaryJson(stage.total)},
+                {"unmatched", stage.unmatched}
+            };
+            if (!stage.parent.empty()) {
+                stageJson["parent"] = stage.parent;
+                stageJson["stage_us"] = summaryJson(stage.stage);
+            }
+            stages.push_back(std::move(stageJson));
+        }
+        if (reset) {
+            trace->reset();
+        }
+        cameras.push_back({{"camera", trace->getName()}, {"stages", std::move(stages)}});
+    }
+    
+    if (!camera.empty() && cameras.empty()) {
+        return errorResponse(404, "Unknown camera");
+    }
+    
+    json latencyJson;
+    latencyJson["status"] = "success";
+    latencyJson["cameras"] = std::move(cameras);
+    
+    Response response;
+    response.statusCode = 200;
+    response.contentType = "application/json";
+    response.body = latencyJson.dump();
+    return response;
+}
+
+std::string_view ApiServer::Request::queryParam(std::string_view name) const {
+    std::string_view rest = query;
+    while (!rest.empty()) {
+        size_t amp = rest.find('&');
+        std::string_view pair = rest.substr(0, amp);
+        size_t eq = pair.find('=');
+        if (pair.substr(0, eq) == name) {
+            return (eq == std::string_view::npos) ? std::string_view() : pair.substr(eq + 1);
+        }
+        rest = (amp == std::string_view::npos) ? std::string_view() : rest.substr(amp + 1);
+    }
+    return std::string_view();
+}
+
 ApiServer::Response ApiServer::handleNotFound(const Request& request) {
     Response response;
     response.statusCode = 404;
@@ -423,7 +1112,7 @@ ApiServer::Response ApiServer::handleNotFound(const Request& request) {
     json errorJson;
     errorJson["status"] = "error";
     errorJson["message"] = "Endpoint not found";
-    errorJson["path"] = request.path;
+    errorJson["path"] = std::string(request.path);
     
     response.body = errorJson.dump();
     
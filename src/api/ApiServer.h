@@ -4,30 +4,89 @@
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <deque>
 #include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <unordered_map>
+#include "HttpParser.h"
+#include "ResponseCache.h"
 #include "../common/Types.h"
 
+struct iovec;
+
 class DetectionBuffer;
+class DetectionStreamHub;
+class LatencyTrace;
+class Histogram;
 
 class ApiServer {
 public:
+    // 연결 버퍼를 가리키는 view (핸들러 호출 중에만 유효)
     struct Request {
-        std::string method;
-        std::string path;
-        std::string body;
+        std::string_view method;
+        std::string_view path;      // 쿼리 문자열 제외
+        std::string_view query;     // '?' 뒤 (없으면 빈 view)
+        std::string_view version;
+        std::string_view body;
+        bool keepAlive = false;  // 응답 후 연결 유지 여부 (HTTP 버전 + Connection 헤더)
+        const HttpParser* parser = nullptr;
+        
+        // 헤더 조회 (대소문자 무시, 없으면 빈 view)
+        std::string_view header(std::string_view name) const {
+            return parser ? parser->header(name) : std::string_view();
+        }
+        
+        // 쿼리 파라미터 조회 (URL 디코딩 없음, 없으면 빈 view)
+        std::string_view queryParam(std::string_view name) const;
     };
     
+    // 스트리밍 응답 본문 출력 (false = 전송 실패)
+    using BodyWriter = std::function<bool(const char* data, size_t length)>;
+    using StreamHandler = std::function<void(const BodyWriter& write)>;
+    // 헤더 전송 후 소켓 소유권을 넘겨받는다 (false면 서버가 닫음)
+    using TakeoverHandler = std::function<bool(int clientSocket)>;
+    
     struct Response {
         int statusCode;
         std::string contentType;
         std::string body;
+        
+        // 설정되면 body 대신 전송 (캐시된 본문을 복사 없이 공유)
+        ResponseCache::Body sharedBody;
+        
+        // 설정되면 body 대신 chunked transfer encoding으로 스트리밍
+        StreamHandler stream;
+        
+        // 설정되면 길이 없는 헤더만 보내고 연결을 넘긴다 (SSE 등 장기 스트림)
+        TakeoverHandler takeover;
     };
     
     using RequestHandler = std::function<Response(const Request&)>;
     
-    ApiServer(int port);
+    static constexpr size_t DEFAULT_WORKER_THREADS = 4;
+    static constexpr size_t DEFAULT_MAX_CONNECTIONS = 64;
+    static constexpr int DEFAULT_KEEPALIVE_TIMEOUT_MS = 5000;
+    static constexpr int SEND_TIMEOUT_MS = 5000;
+    
+    // 요청 크기 제한
+    static constexpr size_t MAX_HEADER_SIZE = 16 * 1024;
+    static constexpr size_t MAX_BODY_SIZE = 1024 * 1024;
+    
+    // 연결별 수신 버퍼 (처음 크기, 최대 크기)
+    static constexpr size_t INITIAL_BUFFER_SIZE = 4096;
+    static constexpr size_t MAX_BUFFER_SIZE = MAX_HEADER_SIZE + MAX_BODY_SIZE;
+    
+    // 연결당 최대 요청 수 (초과 시 Connection: close)
+    static constexpr size_t MAX_REQUESTS_PER_CONNECTION = 1000;
+    
+    ApiServer(int port, size_t workerThreads = DEFAULT_WORKER_THREADS,
+              size_t maxConnections = DEFAULT_MAX_CONNECTIONS,
+              int keepAliveTimeoutMs = DEFAULT_KEEPALIVE_TIMEOUT_MS);
     ~ApiServer();
     
     bool start();
@@ -37,18 +96,59 @@ public:
     // 검출 버퍼 등록
     void registerDetectionBuffer(CameraType type, DetectionBuffer* buffer);
     
+    // 단계별 지연 추적 등록
+    void registerLatencyTrace(CameraType type, LatencyTrace* trace);
+    
     // 라우트 등록
     void addRoute(const std::string& method, const std::string& path, RequestHandler handler);
     
 private:
+    // 연결 상태 (리액터가 읽기, 워커가 처리/응답)
+    struct Connection {
+        explicit Connection(const HttpParser::Limits& limits) : parser(limits) {}
+        
+        int fd;
+        
+        // 수신 버퍼 [begin, end)는 아직 처리하지 않은 데이터 (연결 수명 동안 재사용)
+        std::vector<char> buffer;
+        size_t begin;
+        size_t end;
+        HttpParser parser;  // buffer + begin 위치의 요청을 증분 파싱
+        
+        size_t requestCount;
+        bool busy;        // 워커가 처리 중 (connectionsMutex_ 보호)
+        bool peerClosed;  // 상대가 쓰기를 닫음
+        std::chrono::steady_clock::time_point lastActivity;
+    };
+    
+    // epoll 리액터 + 워커 풀
     void serverThread();
-    void handleClient(int clientSocket);
-    Request parseRequest(const std::string& rawRequest);
-    std::string buildResponse(const Response& response);
+    void workerThread();
+    void acceptConnections();
+    void readConnection(Connection* conn);
+    bool rearmConnection(Connection* conn);
+    void closeConnection(Connection* conn);
+    int detachConnection(Connection* conn);
+    void closeIdleConnections();
+    void handleClient(Connection* conn);
+    
+    HttpParser::Status parsePending(Connection* conn);
+    // chunked: 스트림 본문을 chunked로 보낼지 (false면 연결 종료로 끝나는 본문, HTTP/1.0)
+    std::string buildResponse(const Response& response, bool keepAlive, bool chunked = true);
+    bool sendResponse(int clientSocket, const Response& response, bool keepAlive = false, bool chunked = true);
+    Response errorResponse(int statusCode, const char* message) const;
+    bool sendAll(int clientSocket, const char* data, size_t length);
+    bool sendAllv(int clientSocket, struct iovec* iov, int count);
+    bool waitWritable(int clientSocket);
     
     // 기본 핸들러들
-    Response handleGetDetections(const Request& request);
+    Response handleGetDetections(const Request& request, bool binary);
     Response handleGetLatest(const Request& request);
+    Response handleStream(const Request& request);
+    Response handleCacheStats(const Request& request);
+    Response handleLogStats(const Request& request);
+    Response handleLatency(const Request& request);
+    Response handleMetrics(const Request& request);
     Response handleNotFound(const Request& request);
     
     // 헬퍼 함수
@@ -57,14 +157,44 @@ private:
 private:
     int port_;
     int serverSocket_;
+    int epollFd_;
+    int wakeFd_;  // stop() 시 리액터 깨우기용 eventfd
     std::atomic<bool> running_;
     std::thread serverThread_;
     
+    // 연결 관리
+    size_t maxConnections_;
+    int keepAliveTimeoutMs_;
+    HttpParser::Limits parserLimits_;
+    std::mutex connectionsMutex_;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections_;
+    
+    // 워커 풀 (요청 큐 크기는 maxConnections_로 제한)
+    size_t workerCount_;
+    std::vector<std::thread> workers_;
+    std::mutex queueMutex_;
+    std::condition_variable queueCond_;
+    std::deque<Connection*> requestQueue_;
+    
     // 검출 버퍼들
     std::vector<DetectionBuffer*> detectionBuffers_;
     
-    // 라우트 맵
-    std::unordered_map<std::string, RequestHandler> routes_;
+    // 카메라별 지연 추적
+    std::vector<LatencyTrace*> latencyTraces_;
+    
+    // 응답 캐시 (검출 버퍼 세대 기준)
+    ResponseCache latestCache_;
+    
+    // 실시간 검출 스트림 (SSE)
+    std::unique_ptr<DetectionStreamHub> streamHub_;
+    
+    // 라우트 맵 (라우트별 처리 지연 히스토그램 포함)
+    struct Route {
+        RequestHandler handler;
+        Histogram* latency;
+    };
+    std::unordered_map<std::string, Route> routes_;
+    Histogram* notFoundLatency_;
 };
 
 #endif // API_SERVER_H
\ No newline at end of file
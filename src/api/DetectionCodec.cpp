@@ -0,0 +1,235 @@
+#include "DetectionCodec.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace DetectionCodec {
+
+namespace {
+    constexpr size_t MAX_FRAME_HEADER_SIZE = 1 + 3 * 10;  // tag + varint 3개
+
+    int16_t clampI16(int value) {
+        return static_cast<int16_t>(std::min<int>(std::max<int>(value, INT16_MIN), INT16_MAX));
+    }
+
+    uint16_t clampU16(int value) {
+        return static_cast<uint16_t>(std::min<int>(std::max<int>(value, 0), UINT16_MAX));
+    }
+
+    // 입력 읽기 헬퍼
+    struct Reader {
+        const uint8_t* data;
+        size_t size;
+        size_t pos;
+
+        bool readByte(uint8_t& value) {
+            if (pos >= size) return false;
+            value = data[pos++];
+            return true;
+        }
+
+        bool readVarint(uint64_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t byte;
+                if (!readByte(byte)) return false;
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return true;
+            }
+            return false;
+        }
+
+        uint16_t u16(const uint8_t* p) const {
+            return static_cast<uint16_t>(p[0] | (p[1] << 8));
+        }
+
+        uint32_t u32(const uint8_t* p) const {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+    };
+
+    bool fail(std::string* error, const char* message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    }
+}
+
+Writer::Writer(Sink sink)
+    : sink_(std::move(sink))
+    , used_(0)
+    , bytesWritten_(0)
+    , ok_(true)
+    , lastTimestamp_(0)
+    , lastFrameNumber_(0) {
+}
+
+void Writer::begin(CameraType cameraType) {
+    lastTimestamp_ = 0;
+    lastFrameNumber_ = 0;
+
+    reserve(HEADER_SIZE);
+    memcpy(buffer_ + used_, MAGIC, sizeof(MAGIC));
+    used_ += sizeof(MAGIC);
+    putU16(VERSION);
+    putByte(static_cast<uint8_t>(cameraType));
+    putByte(static_cast<uint8_t>(OBJECT_RECORD_SIZE));
+}
+
+void Writer::writeDetection(const DetectionView& detection) {
+    reserve(MAX_FRAME_HEADER_SIZE);
+    putByte(TAG_FRAME);
+
+    // 버퍼에서 나오는 타임스탬프는 단조 증가이므로 델타는 음수가 되지 않는다
+    uint64_t timestamp = std::max(detection.timestamp, lastTimestamp_);
+    putVarint(timestamp - lastTimestamp_);
+    lastTimestamp_ = timestamp;
+
+    int64_t frameDelta = static_cast<int64_t>(detection.frameNumber) -
+                         static_cast<int64_t>(lastFrameNumber_);
+    putVarint((static_cast<uint64_t>(frameDelta) << 1) ^ static_cast<uint64_t>(frameDelta >> 63));
+    lastFrameNumber_ = detection.frameNumber;
+
+    putVarint(detection.objectCount);
+
+    for (const DetectedObject& obj : detection) {
+        reserve(OBJECT_RECORD_SIZE);
+
+        uint32_t confidenceBits;
+        memcpy(&confidenceBits, &obj.confidence, sizeof(confidenceBits));
+
+        putByte(static_cast<uint8_t>(obj.classId));
+        putByte(static_cast<uint8_t>(obj.color));
+        putByte(obj.hasBbox ? 1 : 0);
+        putByte(0);
+        putU32(confidenceBits);
+        putU16(static_cast<uint16_t>(clampI16(obj.bbox.x)));
+        putU16(static_cast<uint16_t>(clampI16(obj.bbox.y)));
+        putU16(clampU16(obj.bbox.width));
+        putU16(clampU16(obj.bbox.height));
+    }
+}
+
+void Writer::end() {
+    reserve(1);
+    putByte(TAG_END);
+}
+
+bool Writer::flush() {
+    if (used_ > 0 && ok_) {
+        ok_ = sink_(reinterpret_cast<const char*>(buffer_), used_);
+        if (ok_) {
+            bytesWritten_ += used_;
+        }
+    }
+    used_ = 0;
+    return ok_;
+}
+
+void Writer::reserve(size_t length) {
+    if (BUFFER_SIZE - used_ < length) {
+        flush();
+    }
+}
+
+void Writer::putByte(uint8_t value) {
+    buffer_[used_++] = value;
+}
+
+void Writer::putVarint(uint64_t value) {
+    while (value >= 0x80) {
+        buffer_[used_++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    buffer_[used_++] = static_cast<uint8_t>(value);
+}
+
+void Writer::putU16(uint16_t value) {
+    buffer_[used_++] = static_cast<uint8_t>(value);
+    buffer_[used_++] = static_cast<uint8_t>(value >> 8);
+}
+
+void Writer::putU32(uint32_t value) {
+    buffer_[used_++] = static_cast<uint8_t>(value);
+    buffer_[used_++] = static_cast<uint8_t>(value >> 8);
+    buffer_[used_++] = static_cast<uint8_t>(value >> 16);
+    buffer_[used_++] = static_cast<uint8_t>(value >> 24);
+}
+
+bool decode(const uint8_t* data, size_t size, CameraType& cameraType,
+            std::vector<DetectionData>& detections, std::string* error) {
+    Reader in{data, size, 0};
+
+    if (size < HEADER_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        return fail(error, "bad magic");
+    }
+    if (in.u16(data + 4) != VERSION) {
+        return fail(error, "unsupported version");
+    }
+    if (data[6] > static_cast<uint8_t>(CameraType::THERMAL)) {
+        return fail(error, "bad camera type");
+    }
+    size_t objectSize = data[7];
+    if (objectSize < OBJECT_RECORD_SIZE) {
+        return fail(error, "bad object record size");
+    }
+    cameraType = static_cast<CameraType>(data[6]);
+    in.pos = HEADER_SIZE;
+
+    uint64_t timestamp = 0;
+    uint32_t frameNumber = 0;
+
+    while (true) {
+        uint8_t tag;
+        if (!in.readByte(tag)) {
+            return fail(error, "truncated stream");
+        }
+        if (tag == TAG_END) {
+            return true;
+        }
+        if (tag != TAG_FRAME) {
+            return fail(error, "unknown record tag");
+        }
+
+        uint64_t timestampDelta, frameDelta, objectCount;
+        if (!in.readVarint(timestampDelta) || !in.readVarint(frameDelta) ||
+            !in.readVarint(objectCount)) {
+            return fail(error, "truncated frame header");
+        }
+        if (objectCount > (size - in.pos) / objectSize) {
+            return fail(error, "truncated object records");
+        }
+
+        timestamp += timestampDelta;
+        int64_t delta = static_cast<int64_t>(frameDelta >> 1) ^ -static_cast<int64_t>(frameDelta & 1);
+        frameNumber = static_cast<uint32_t>(static_cast<int64_t>(frameNumber) + delta);
+
+        DetectionData detection;
+        detection.timestamp = timestamp;
+        detection.frameNumber = frameNumber;
+        detection.cameraType = cameraType;
+        detection.objects.resize(objectCount);
+
+        for (DetectedObject& obj : detection.objects) {
+            const uint8_t* p = data + in.pos;
+            uint32_t confidenceBits = in.u32(p + 4);
+
+            obj.classId = p[0];
+            obj.color = static_cast<BboxColor>(std::min<uint8_t>(p[1], static_cast<uint8_t>(BboxColor::NONE)));
+            obj.hasBbox = (p[2] & 1) != 0;
+            memcpy(&obj.confidence, &confidenceBits, sizeof(obj.confidence));
+            obj.bbox.x = static_cast<int16_t>(in.u16(p + 8));
+            obj.bbox.y = static_cast<int16_t>(in.u16(p + 10));
+            obj.bbox.width = in.u16(p + 12);
+            obj.bbox.height = in.u16(p + 14);
+
+            in.pos += objectSize;
+        }
+
+        detections.push_back(std::move(detection));
+    }
+}
+
+}  // namespace DetectionCodec
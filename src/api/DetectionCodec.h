@@ -0,0 +1,85 @@
+#ifndef DETECTION_CODEC_H
+#define DETECTION_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "../detection/DetectionBuffer.h"
+
+// 검출 결과 바이너리 포맷 (리틀 엔디언)
+//
+//   헤더 (8 bytes)
+//     char[4]  magic          "SCDT"
+//     uint16   version        1
+//     uint8    cameraType     CameraType
+//     uint8    objectSize     객체 레코드 크기 (16)
+//
+//   프레임 레코드 (반복)
+//     uint8    tag            1 = 프레임, 0 = 스트림 끝
+//     varint   timestampDelta 직전 프레임 대비 ns (첫 프레임은 절대값)
+//     varint   frameDelta     직전 프레임 번호 대비 차이 (zigzag)
+//     varint   objectCount
+//     object[objectCount]
+//
+//   객체 레코드 (16 bytes 고정)
+//     uint8    classId
+//     uint8    color          BboxColor
+//     uint8    flags          bit0 = hasBbox
+//     uint8    reserved
+//     float32  confidence
+//     int16    x, y
+//     uint16   width, height
+namespace DetectionCodec {
+    constexpr char MAGIC[4] = {'S', 'C', 'D', 'T'};
+    constexpr uint16_t VERSION = 1;
+    constexpr size_t HEADER_SIZE = 8;
+    constexpr size_t OBJECT_RECORD_SIZE = 16;
+    constexpr uint8_t TAG_END = 0;
+    constexpr uint8_t TAG_FRAME = 1;
+
+    constexpr const char* CONTENT_TYPE = "application/vnd.smartcow.detections.v1";
+
+    // 스트리밍 인코더 (JsonDetectionWriter와 같은 방식으로 sink에 조각 단위 출력)
+    class Writer {
+    public:
+        static constexpr size_t BUFFER_SIZE = 16 * 1024;
+
+        using Sink = std::function<bool(const char* data, size_t length)>;
+
+        explicit Writer(Sink sink);
+
+        void begin(CameraType cameraType);
+        void writeDetection(const DetectionView& detection);
+        void end();
+
+        bool flush();
+
+        bool ok() const { return ok_; }
+        size_t bytesWritten() const { return bytesWritten_; }
+
+    private:
+        void reserve(size_t length);
+        void putByte(uint8_t value);
+        void putVarint(uint64_t value);
+        void putU16(uint16_t value);
+        void putU32(uint32_t value);
+
+    private:
+        Sink sink_;
+        uint8_t buffer_[BUFFER_SIZE];
+        size_t used_;
+        size_t bytesWritten_;
+        bool ok_;
+
+        uint64_t lastTimestamp_;
+        uint32_t lastFrameNumber_;
+    };
+
+    // 전체 스트림 디코드 (실패 시 error에 사유)
+    bool decode(const uint8_t* data, size_t size, CameraType& cameraType,
+                std::vector<DetectionData>& detections, std::string* error = nullptr);
+}
+
+#endif // DETECTION_CODEC_H
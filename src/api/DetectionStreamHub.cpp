@@ -0,0 +1,432 @@
+#include "DetectionStreamHub.h"
+#include "JsonDetectionWriter.h"
+#include "../detection/DetectionBuffer.h"
+#include "../utils/Logger.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    // 한 번의 sendmsg로 보낼 최대 메시지 수
+    constexpr int MAX_IOV = 64;
+
+    const char* cameraName(CameraType type) {
+        return (type == CameraType::RGB) ? "RGB_Camera" : "Thermal_Camera";
+    }
+}
+
+DetectionStreamHub::DetectionStreamHub(size_t maxSubscribers)
+    : maxSubscribers_(std::max<size_t>(maxSubscribers, 1))
+    , epollFd_(-1)
+    , wakeFd_(-1)
+    , running_(false)
+    , notified_(false)
+    , subscriberCount_(0) {
+}
+
+DetectionStreamHub::~DetectionStreamHub() {
+    stop();
+}
+
+bool DetectionStreamHub::start() {
+    if (running_) {
+        return true;
+    }
+
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd_ < 0 || wakeFd_ < 0) {
+        LOG_ERROR("Failed to create detection stream epoll/eventfd: %s", strerror(errno));
+        if (epollFd_ >= 0) close(epollFd_);
+        if (wakeFd_ >= 0) close(wakeFd_);
+        epollFd_ = wakeFd_ = -1;
+        return false;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = wakeFd_;
+    epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &ev);
+
+    // 시작 시점 이후의 프레임만 전송
+    for (Source& source : sources_) {
+        if (source.buffer) {
+            source.cursor = source.buffer->getHeadIndex();
+        }
+    }
+
+    lastHeartbeat_ = std::chrono::steady_clock::now();
+    running_ = true;
+    thread_ = std::thread(&DetectionStreamHub::hubThread, this);
+
+    LOG_INFO("Detection stream hub started (max subscribers: %zu)", maxSubscribers_);
+    return true;
+}
+
+void DetectionStreamHub::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    uint64_t one = 1;
+    if (write(wakeFd_, &one, sizeof(one)) < 0) {
+        LOG_WARN("Failed to wake detection stream hub: %s", strerror(errno));
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    for (auto& pair : subscribers_) {
+        close(pair.first);
+    }
+    subscribers_.clear();
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        for (auto& subscriber : pending_) {
+            close(subscriber->fd);
+        }
+        pending_.clear();
+    }
+    subscriberCount_ = 0;
+
+    close(epollFd_);
+    close(wakeFd_);
+    epollFd_ = wakeFd_ = -1;
+
+    LOG_INFO("Detection stream hub stopped");
+}
+
+void DetectionStreamHub::attachBuffer(CameraType type, DetectionBuffer* buffer) {
+    if (!buffer) {
+        return;
+    }
+    if (static_cast<size_t>(type) >= sources_.size()) {
+        sources_.resize(static_cast<size_t>(type) + 1);
+    }
+    sources_[static_cast<size_t>(type)].buffer = buffer;
+    buffer->setDetectionListener([this]() { notify(); });
+}
+
+bool DetectionStreamHub::subscribe(int fd, CameraType camera, uint32_t classMask) {
+    if (!running_ || static_cast<size_t>(camera) >= sources_.size() ||
+        !sources_[static_cast<size_t>(camera)].buffer) {
+        return false;
+    }
+
+    // 구독 수 예약 (허브 스레드가 끊으면 감소)
+    size_t count = subscriberCount_.load();
+    do {
+        if (count >= maxSubscribers_) {
+            LOG_WARN("Detection stream subscriber limit reached (%zu)", maxSubscribers_);
+            return false;
+        }
+    } while (!subscriberCount_.compare_exchange_weak(count, count + 1));
+
+    auto subscriber = std::make_unique<Subscriber>();
+    subscriber->fd = fd;
+    subscriber->camera = camera;
+    subscriber->classMask = classMask;
+    subscriber->headOffset = 0;
+    subscriber->pendingBytes = 0;
+    subscriber->waitingWritable = false;
+
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pending_.push_back(std::move(subscriber));
+    }
+
+    uint64_t one = 1;
+    if (write(wakeFd_, &one, sizeof(one)) < 0) {
+        LOG_WARN("Failed to wake detection stream hub: %s", strerror(errno));
+    }
+    return true;
+}
+
+bool DetectionStreamHub::hasCapacity() const {
+    return running_ && subscriberCount_.load() < maxSubscribers_;
+}
+
+size_t DetectionStreamHub::getSubscriberCount() const {
+    return subscriberCount_.load();
+}
+
+void DetectionStreamHub::notify() {
+    // 생산자 스레드: 허브가 아직 처리하지 않은 알림이 있으면 시스템 콜 생략
+    if (!notified_.exchange(true, std::memory_order_acq_rel)) {
+        uint64_t one = 1;
+        if (write(wakeFd_, &one, sizeof(one)) < 0) {
+            notified_.store(false, std::memory_order_release);
+        }
+    }
+}
+
+void DetectionStreamHub::hubThread() {
+    constexpr int MAX_EVENTS = 64;
+    struct epoll_event events[MAX_EVENTS];
+    const auto heartbeatInterval = std::chrono::milliseconds(HEARTBEAT_INTERVAL_MS);
+
+    while (running_) {
+        int count = epoll_wait(epollFd_, events, MAX_EVENTS, 1000);
+        if (count < 0 && errno != EINTR) {
+            LOG_ERROR("Detection stream epoll_wait failed: %s", strerror(errno));
+        }
+
+        for (int i = 0; i < count; i++) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd_) {
+                uint64_t value;
+                while (read(wakeFd_, &value, sizeof(value)) > 0) {}
+                continue;
+            }
+
+            auto it = subscribers_.find(fd);
+            if (it == subscribers_.end()) {
+                continue;
+            }
+            if (events[i].events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) {
+                removeSubscriber(fd, "closed by client");
+                continue;
+            }
+            if (events[i].events & EPOLLIN) {
+                // 구독자가 보내는 데이터는 버린다
+                char discard[512];
+                ssize_t n = recv(fd, discard, sizeof(discard), 0);
+                if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                    removeSubscriber(fd, "closed by client");
+                    continue;
+                }
+            }
+            if ((events[i].events & EPOLLOUT) && !flush(*it->second)) {
+                removeSubscriber(fd, "send failed");
+            }
+        }
+
+        if (!running_) {
+            break;
+        }
+
+        acceptPending();
+        publishNewDetections();
+
+        // 프록시/클라이언트 유휴 타임아웃 방지
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastHeartbeat_ >= heartbeatInterval) {
+            lastHeartbeat_ = now;
+            static const Message heartbeat = std::make_shared<const std::string>(": ping\n\n");
+            std::vector<int> failed;
+            for (auto& pair : subscribers_) {
+                if (!enqueue(*pair.second, heartbeat) || !flush(*pair.second)) {
+                    failed.push_back(pair.first);
+                }
+            }
+            for (int fd : failed) {
+                removeSubscriber(fd, "heartbeat failed");
+            }
+        }
+    }
+}
+
+void DetectionStreamHub::acceptPending() {
+    std::vector<std::unique_ptr<Subscriber>> accepted;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        accepted.swap(pending_);
+    }
+
+    static const Message hello = std::make_shared<const std::string>("retry: 3000\n\n");
+
+    for (auto& subscriber : accepted) {
+        int fd = subscriber->fd;
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.fd = fd;
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            LOG_ERROR("Failed to register stream subscriber: %s", strerror(errno));
+            close(fd);
+            subscriberCount_--;
+            continue;
+        }
+
+        Subscriber& added = *subscriber;
+        subscribers_[fd] = std::move(subscriber);
+        LOG_INFO("Detection stream subscriber added (fd=%d, camera=%s, mask=0x%x, total=%zu)",
+                 fd, cameraName(added.camera), added.classMask, subscribers_.size());
+
+        if (!enqueue(added, hello) || !flush(added)) {
+            removeSubscriber(fd, "send failed");
+        }
+    }
+}
+
+void DetectionStreamHub::publishNewDetections() {
+    // 알림 소비 후 읽는다 (읽는 동안 게시된 프레임은 다음 알림으로 처리)
+    if (!notified_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    std::string payload;
+    for (size_t type = 0; type < sources_.size(); type++) {
+        Source& source = sources_[type];
+        if (!source.buffer) {
+            continue;
+        }
+        CameraType camera = static_cast<CameraType>(type);
+
+        source.cursor = source.buffer->visitDetectionsSince(source.cursor,
+            [&](const DetectionView& detection) {
+                if (subscribers_.empty()) {
+                    return;
+                }
+
+                uint32_t classBits = 0;
+                for (const DetectedObject& obj : detection) {
+                    if (obj.classId >= 0 && obj.classId < 32) {
+                        classBits |= 1u << obj.classId;
+                    }
+                }
+
+                // 프레임당 한 번만 직렬화
+                payload.clear();
+                char prefix[64];
+                int length = snprintf(prefix, sizeof(prefix), "id: %lu\nevent: detection\ndata: ",
+                                      detection.timestamp);
+                payload.append(prefix, length);
+
+                JsonDetectionWriter writer([&payload](const char* data, size_t size) {
+                    payload.append(data, size);
+                    return true;
+                });
+                writer.writeDetection(detection, cameraName(camera));
+                writer.flush();
+                payload.append("\n\n");
+
+                broadcast(camera, classBits, std::make_shared<const std::string>(payload));
+            });
+    }
+
+    // 큐에 쌓인 데이터 전송
+    std::vector<int> failed;
+    for (auto& pair : subscribers_) {
+        Subscriber& subscriber = *pair.second;
+        if (!subscriber.queue.empty() && !subscriber.waitingWritable && !flush(subscriber)) {
+            failed.push_back(pair.first);
+        }
+    }
+    for (int fd : failed) {
+        removeSubscriber(fd, "send failed");
+    }
+}
+
+void DetectionStreamHub::broadcast(CameraType camera, uint32_t classBits, const Message& message) {
+    std::vector<int> dropped;
+    for (auto& pair : subscribers_) {
+        Subscriber& subscriber = *pair.second;
+        if (subscriber.camera != camera) {
+            continue;
+        }
+        if (subscriber.classMask != 0 && (subscriber.classMask & classBits) == 0) {
+            continue;
+        }
+        if (!enqueue(subscriber, message)) {
+            dropped.push_back(pair.first);
+        }
+    }
+    for (int fd : dropped) {
+        LOG_WARN("Dropping slow detection stream subscriber (fd=%d)", fd);
+        removeSubscriber(fd, "too slow");
+    }
+}
+
+bool DetectionStreamHub::enqueue(Subscriber& subscriber, const Message& message) {
+    // 느린 구독자는 끊는다 (생산자나 다른 구독자를 기다리게 하지 않음)
+    if (subscriber.pendingBytes + message->size() > MAX_PENDING_BYTES) {
+        return false;
+    }
+    subscriber.queue.push_back(message);
+    subscriber.pendingBytes += message->size();
+    return true;
+}
+
+bool DetectionStreamHub::flush(Subscriber& subscriber) {
+    while (!subscriber.queue.empty()) {
+        struct iovec iov[MAX_IOV];
+        int count = 0;
+        for (auto it = subscriber.queue.begin();
+             it != subscriber.queue.end() && count < MAX_IOV; ++it, ++count) {
+            size_t offset = (count == 0) ? subscriber.headOffset : 0;
+            iov[count].iov_base = const_cast<char*>((*it)->data() + offset);
+            iov[count].iov_len = (*it)->size() - offset;
+        }
+
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+
+        ssize_t sent = sendmsg(subscriber.fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                updateInterest(subscriber, true);
+                return true;
+            }
+            return false;
+        }
+
+        // 전송 완료된 메시지 제거
+        subscriber.pendingBytes -= sent;
+        size_t remaining = static_cast<size_t>(sent);
+        while (remaining > 0) {
+            size_t left = subscriber.queue.front()->size() - subscriber.headOffset;
+            if (remaining < left) {
+                subscriber.headOffset += remaining;
+                break;
+            }
+            remaining -= left;
+            subscriber.queue.pop_front();
+            subscriber.headOffset = 0;
+        }
+    }
+
+    updateInterest(subscriber, false);
+    return true;
+}
+
+void DetectionStreamHub::updateInterest(Subscriber& subscriber, bool wantWritable) {
+    if (subscriber.waitingWritable == wantWritable) {
+        return;
+    }
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLRDHUP | (wantWritable ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    ev.data.fd = subscriber.fd;
+    epoll_ctl(epollFd_, EPOLL_CTL_MOD, subscriber.fd, &ev);
+    subscriber.waitingWritable = wantWritable;
+}
+
+void DetectionStreamHub::removeSubscriber(int fd, const char* reason) {
+    auto it = subscribers_.find(fd);
+    if (it == subscribers_.end()) {
+        return;
+    }
+
+    LOG_INFO("Detection stream subscriber removed (fd=%d): %s, %zu bytes pending",
+             fd, reason, it->second->pendingBytes);
+
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    subscribers_.erase(it);
+    subscriberCount_--;
+}
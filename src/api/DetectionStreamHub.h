@@ -0,0 +1,96 @@
+#ifndef DETECTION_STREAM_HUB_H
+#define DETECTION_STREAM_HUB_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../common/Types.h"
+
+class DetectionBuffer;
+
+// 실시간 검출 스트림 (Server-Sent Events)
+// - 검출 버퍼에 새 프레임이 게시되면 허브 스레드가 깨어나 프레임당 한 번만 직렬화하고,
+//   같은 메시지(shared_ptr)를 조건에 맞는 구독자 큐에 넣어 전송한다.
+// - 구독자 소켓은 논블로킹이며 미전송 데이터가 한도를 넘으면 그 구독자만 끊는다
+//   (생산자/다른 구독자는 기다리지 않는다).
+class DetectionStreamHub {
+public:
+    static constexpr size_t DEFAULT_MAX_SUBSCRIBERS = 32;
+    static constexpr size_t MAX_PENDING_BYTES = 512 * 1024;  // 구독자별 미전송 한도
+    static constexpr int HEARTBEAT_INTERVAL_MS = 15000;
+
+    // 알람 클래스 (filter=alarm)
+    static constexpr uint32_t ALARM_CLASS_MASK =
+        (1u << CLASS_FLIP_COW) | (1u << CLASS_LABOR_SIGN_COW);
+
+    explicit DetectionStreamHub(size_t maxSubscribers = DEFAULT_MAX_SUBSCRIBERS);
+    ~DetectionStreamHub();
+
+    bool start();
+    void stop();
+
+    // 검출 버퍼 연결 (start 및 파이프라인 시작 전에 호출)
+    void attachBuffer(CameraType type, DetectionBuffer* buffer);
+
+    // 응답 헤더를 보낸 소켓의 소유권을 넘겨받는다
+    // classMask: 전송할 클래스 비트 (0이면 모든 프레임). 실패 시 false (fd는 호출 측이 닫음)
+    bool subscribe(int fd, CameraType camera, uint32_t classMask);
+    bool hasCapacity() const;
+    size_t getSubscriberCount() const;
+
+private:
+    using Message = std::shared_ptr<const std::string>;
+
+    struct Subscriber {
+        int fd;
+        CameraType camera;
+        uint32_t classMask;
+        std::deque<Message> queue;  // 미전송 메시지 (공유)
+        size_t headOffset;          // queue.front() 중 이미 보낸 바이트
+        size_t pendingBytes;
+        bool waitingWritable;       // EPOLLOUT 대기 중
+    };
+
+    struct Source {
+        DetectionBuffer* buffer = nullptr;
+        uint64_t cursor = 0;  // 다음에 읽을 절대 인덱스
+    };
+
+    void hubThread();
+    void notify();
+    void acceptPending();
+    void publishNewDetections();
+    void broadcast(CameraType camera, uint32_t classBits, const Message& message);
+    bool enqueue(Subscriber& subscriber, const Message& message);
+    bool flush(Subscriber& subscriber);
+    void updateInterest(Subscriber& subscriber, bool wantWritable);
+    void removeSubscriber(int fd, const char* reason);
+
+private:
+    size_t maxSubscribers_;
+    int epollFd_;
+    int wakeFd_;
+    std::atomic<bool> running_;
+    std::atomic<bool> notified_;  // 생산자 -> 허브 알림 중복 방지
+    std::thread thread_;
+
+    std::vector<Source> sources_;  // CameraType 인덱스
+
+    // 허브 스레드 전용
+    std::unordered_map<int, std::unique_ptr<Subscriber>> subscribers_;
+    std::chrono::steady_clock::time_point lastHeartbeat_;
+
+    // 다른 스레드에서 넘겨받은 구독 요청
+    mutable std::mutex pendingMutex_;
+    std::vector<std::unique_ptr<Subscriber>> pending_;
+    std::atomic<size_t> subscriberCount_;
+};
+
+#endif // DETECTION_STREAM_HUB_H
@@ -0,0 +1,285 @@
+#include "HttpParser.h"
+#include <cstring>
+#include <strings.h>
+
+namespace {
+    // RFC 7230 token 문자
+    bool isTokenChar(unsigned char c) {
+        static const bool* table = []() {
+            static bool t[256] = {};
+            for (int c = '0'; c <= '9'; c++) t[c] = true;
+            for (int c = 'a'; c <= 'z'; c++) t[c] = true;
+            for (int c = 'A'; c <= 'Z'; c++) t[c] = true;
+            for (const char* p = "!#$%&'*+-.^_`|~"; *p; p++) t[static_cast<unsigned char>(*p)] = true;
+            return t;
+        }();
+        return table[c];
+    }
+
+    // 제어 문자 (HTAB 제외)
+    bool isControl(unsigned char c) {
+        return (c < 0x20 && c != '\t') || c == 0x7F;
+    }
+
+    bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+        return a.size() == b.size() && strncasecmp(a.data(), b.data(), a.size()) == 0;
+    }
+
+    // 쉼표로 구분된 헤더 값에 토큰이 있는지 (대소문자 무시)
+    bool hasToken(std::string_view value, std::string_view token) {
+        while (!value.empty()) {
+            size_t comma = value.find(',');
+            std::string_view item = value.substr(0, comma);
+            while (!item.empty() && (item.front() == ' ' || item.front() == '\t')) item.remove_prefix(1);
+            while (!item.empty() && (item.back() == ' ' || item.back() == '\t')) item.remove_suffix(1);
+            if (equalsIgnoreCase(item, token)) {
+                return true;
+            }
+            if (comma == std::string_view::npos) {
+                break;
+            }
+            value.remove_prefix(comma + 1);
+        }
+        return false;
+    }
+}
+
+HttpParser::HttpParser()
+    : HttpParser(Limits()) {
+}
+
+HttpParser::HttpParser(const Limits& limits)
+    : limits_(limits) {
+    headers_.reserve(16);
+    reset();
+}
+
+void HttpParser::reset() {
+    state_ = State::REQUEST_LINE;
+    status_ = Status::INCOMPLETE;
+    errorStatus_ = 0;
+    base_ = nullptr;
+    lineStart_ = 0;
+    pos_ = 0;
+    consumed_ = 0;
+    headerLength_ = 0;
+    contentLength_ = 0;
+    hasContentLength_ = false;
+    method_ = path_ = version_ = body_ = Span();
+    headers_.clear();
+}
+
+HttpParser::Status HttpParser::parse(const char* data, size_t size) {
+    base_ = data;
+    if (status_ != Status::INCOMPLETE) {
+        return status_;
+    }
+
+    // 요청 줄 + 헤더: 줄 단위로 이전 위치부터 이어서 검사
+    while (state_ != State::BODY) {
+        const char* lf = static_cast<const char*>(memchr(data + pos_, '\n', size - pos_));
+        if (!lf) {
+            pos_ = size;
+            if (size > limits_.maxHeaderSize) {
+                return fail(431);
+            }
+            return Status::INCOMPLETE;
+        }
+
+        size_t lineEnd = lf - data;
+        pos_ = lineEnd + 1;
+        if (pos_ > limits_.maxHeaderSize) {
+            return fail(431);
+        }
+
+        // 줄 끝은 CRLF만 허용
+        if (lineEnd == lineStart_ || data[lineEnd - 1] != '\r') {
+            return fail(400);
+        }
+        size_t begin = lineStart_;
+        size_t end = lineEnd - 1;
+        lineStart_ = pos_;
+
+        if (state_ == State::REQUEST_LINE) {
+            if (begin == end) {
+                continue;  // 요청 앞의 빈 줄은 무시
+            }
+            if (!parseRequestLine(begin, end)) {
+                return status_;
+            }
+            state_ = State::HEADER_LINE;
+        } else if (begin == end) {
+            headerLength_ = pos_;
+            state_ = State::BODY;
+        } else if (!parseHeaderLine(begin, end)) {
+            return status_;
+        }
+    }
+
+    // 본문 (Content-Length 방식만 지원)
+    if (size - headerLength_ < contentLength_) {
+        return Status::INCOMPLETE;
+    }
+
+    body_.offset = static_cast<uint32_t>(headerLength_);
+    body_.length = static_cast<uint32_t>(contentLength_);
+    consumed_ = headerLength_ + contentLength_;
+    state_ = State::DONE;
+    status_ = Status::COMPLETE;
+    return status_;
+}
+
+bool HttpParser::parseRequestLine(size_t begin, size_t end) {
+    // METHOD SP request-target SP HTTP-version
+    const char* line = base_ + begin;
+    size_t length = end - begin;
+
+    const char* space1 = static_cast<const char*>(memchr(line, ' ', length));
+    if (!space1 || space1 == line) {
+        fail(400);
+        return false;
+    }
+    const char* space2 = static_cast<const char*>(memchr(space1 + 1, ' ', line + length - space1 - 1));
+    if (!space2 || space2 == space1 + 1) {
+        fail(400);
+        return false;
+    }
+
+    for (const char* p = line; p < space1; p++) {
+        if (!isTokenChar(static_cast<unsigned char>(*p))) {
+            fail(400);
+            return false;
+        }
+    }
+    for (const char* p = space1 + 1; p < line + length; p++) {
+        if (p != space2 && (*p == ' ' || isControl(static_cast<unsigned char>(*p)))) {
+            fail(400);
+            return false;
+        }
+    }
+
+    method_ = {static_cast<uint32_t>(begin), static_cast<uint32_t>(space1 - line)};
+    path_ = {static_cast<uint32_t>(begin + (space1 + 1 - line)),
+             static_cast<uint32_t>(space2 - space1 - 1)};
+    version_ = {static_cast<uint32_t>(begin + (space2 + 1 - line)),
+                static_cast<uint32_t>(line + length - space2 - 1)};
+
+    std::string_view version = view(version_);
+    if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+        fail(version.substr(0, 5) == "HTTP/" ? 505 : 400);
+        return false;
+    }
+    return true;
+}
+
+bool HttpParser::parseHeaderLine(size_t begin, size_t end) {
+    if (headers_.size() >= limits_.maxHeaderCount) {
+        fail(431);
+        return false;
+    }
+
+    // 이름: token (줄 앞 공백의 obs-fold, 이름과 콜론 사이 공백은 거부)
+    size_t colon = begin;
+    while (colon < end && base_[colon] != ':') {
+        if (!isTokenChar(static_cast<unsigned char>(base_[colon]))) {
+            fail(400);
+            return false;
+        }
+        colon++;
+    }
+    if (colon == begin || colon == end) {
+        fail(400);
+        return false;
+    }
+
+    // 값: 앞뒤 공백 제거
+    size_t valueBegin = colon + 1;
+    size_t valueEnd = end;
+    while (valueBegin < valueEnd && (base_[valueBegin] == ' ' || base_[valueBegin] == '\t')) valueBegin++;
+    while (valueEnd > valueBegin && (base_[valueEnd - 1] == ' ' || base_[valueEnd - 1] == '\t')) valueEnd--;
+    for (size_t i = valueBegin; i < valueEnd; i++) {
+        if (isControl(static_cast<unsigned char>(base_[i]))) {
+            fail(400);
+            return false;
+        }
+    }
+
+    Header header;
+    header.name = {static_cast<uint32_t>(begin), static_cast<uint32_t>(colon - begin)};
+    header.value = {static_cast<uint32_t>(valueBegin), static_cast<uint32_t>(valueEnd - valueBegin)};
+    headers_.push_back(header);
+
+    std::string_view name = view(header.name);
+    if (equalsIgnoreCase(name, "content-length")) {
+        std::string_view value = view(header.value);
+        if (value.empty()) {
+            fail(400);
+            return false;
+        }
+
+        size_t contentLength = 0;
+        for (char c : value) {
+            if (c < '0' || c > '9') {
+                fail(400);
+                return false;
+            }
+            contentLength = contentLength * 10 + (c - '0');
+            if (contentLength > limits_.maxBodySize) {
+                fail(413);
+                return false;
+            }
+        }
+
+        // 중복 Content-Length는 같은 값일 때만 허용
+        if (hasContentLength_ && contentLength != contentLength_) {
+            fail(400);
+            return false;
+        }
+        contentLength_ = contentLength;
+        hasContentLength_ = true;
+    } else if (equalsIgnoreCase(name, "transfer-encoding")) {
+        fail(501);
+        return false;
+    }
+    return true;
+}
+
+HttpParser::Status HttpParser::fail(int status) {
+    errorStatus_ = status;
+    status_ = Status::ERROR;
+    return status_;
+}
+
+std::string_view HttpParser::header(std::string_view name) const {
+    for (const Header& header : headers_) {
+        if (equalsIgnoreCase(view(header.name), name)) {
+            return view(header.value);
+        }
+    }
+    return std::string_view();
+}
+
+bool HttpParser::hasHeader(std::string_view name) const {
+    for (const Header& header : headers_) {
+        if (equalsIgnoreCase(view(header.name), name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool HttpParser::keepAlive() const {
+    bool http11 = view(version_) == "HTTP/1.1";
+    for (const Header& header : headers_) {
+        if (!equalsIgnoreCase(view(header.name), "connection")) {
+            continue;
+        }
+        if (http11 && hasToken(view(header.value), "close")) {
+            return false;
+        }
+        if (!http11 && hasToken(view(header.value), "keep-alive")) {
+            return true;
+        }
+    }
+    return http11;
+}
@@ -0,0 +1,100 @@
+#ifndef HTTP_PARSER_H
+#define HTTP_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// 증분 HTTP/1.x 요청 파서
+// 연결 버퍼를 제자리에서 해석하며 데이터가 추가될 때마다 이전 위치부터 이어서 파싱한다.
+// 결과(method, path, 헤더, body)는 버퍼를 가리키는 string_view이므로
+// 버퍼를 수정하거나 reset()하기 전까지만 유효하다.
+class HttpParser {
+public:
+    enum class Status {
+        INCOMPLETE,  // 데이터 더 필요
+        COMPLETE,    // 요청 하나 완성 (consumed() 바이트)
+        ERROR        // 잘못된 요청 (errorStatus()에 HTTP 상태 코드)
+    };
+
+    struct Limits {
+        size_t maxHeaderSize = 16 * 1024;   // 요청 줄 + 헤더
+        size_t maxBodySize = 1024 * 1024;
+        size_t maxHeaderCount = 64;
+    };
+
+    HttpParser();
+    explicit HttpParser(const Limits& limits);
+
+    // 다음 요청을 위해 상태 초기화 (헤더 저장 공간은 재사용)
+    void reset();
+
+    // data는 요청 시작부터의 버퍼. 이전 호출 이후 앞부분 내용은 바뀌지 않아야 한다
+    // (버퍼 주소는 바뀌어도 된다).
+    Status parse(const char* data, size_t size);
+
+    Status status() const { return status_; }
+    int errorStatus() const { return errorStatus_; }
+    size_t consumed() const { return consumed_; }
+
+    std::string_view method() const { return view(method_); }
+    std::string_view path() const { return view(path_); }
+    std::string_view version() const { return view(version_); }
+    std::string_view body() const { return view(body_); }
+
+    size_t headerCount() const { return headers_.size(); }
+    std::string_view headerName(size_t index) const { return view(headers_[index].name); }
+    std::string_view headerValue(size_t index) const { return view(headers_[index].value); }
+
+    // 이름으로 헤더 조회 (대소문자 무시, 없으면 빈 view)
+    std::string_view header(std::string_view name) const;
+    bool hasHeader(std::string_view name) const;
+
+    // HTTP/1.1은 Connection: close가 없으면, HTTP/1.0은 Connection: keep-alive가 있으면 true
+    bool keepAlive() const;
+
+private:
+    enum class State { REQUEST_LINE, HEADER_LINE, BODY, DONE };
+
+    // base_ 기준 오프셋 (버퍼가 이동해도 유효)
+    struct Span {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    struct Header {
+        Span name;
+        Span value;
+    };
+
+    bool parseRequestLine(size_t begin, size_t end);
+    bool parseHeaderLine(size_t begin, size_t end);
+    Status fail(int status);
+
+    std::string_view view(const Span& span) const {
+        return std::string_view(base_ + span.offset, span.length);
+    }
+
+private:
+    Limits limits_;
+    State state_;
+    Status status_;
+    int errorStatus_;
+
+    const char* base_;
+    size_t lineStart_;      // 현재 줄 시작
+    size_t pos_;            // 다음에 검사할 위치
+    size_t consumed_;
+    size_t headerLength_;   // 빈 줄까지 포함한 헤더 길이
+    size_t contentLength_;
+    bool hasContentLength_;
+
+    Span method_;
+    Span path_;
+    Span version_;
+    Span body_;
+    std::vector<Header> headers_;
+};
+
+#endif // HTTP_PARSER_H
@@ -0,0 +1,122 @@
+#include "JsonDetectionWriter.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    const char* const COLOR_NAMES[] = {"green", "yellow", "red", "blue", "null"};
+
+    // 객체 하나의 최대 직렬화 길이 (이보다 여유가 적으면 먼저 flush)
+    constexpr size_t MAX_RECORD_LENGTH = 256;
+}
+
+JsonDetectionWriter::JsonDetectionWriter(Sink sink)
+    : sink_(std::move(sink))
+    , used_(0)
+    , bytesWritten_(0)
+    , ok_(true)
+    , firstDetection_(true) {
+}
+
+void JsonDetectionWriter::beginDetections() {
+    firstDetection_ = true;
+    append("{\"detections\":[");
+}
+
+void JsonDetectionWriter::writeDetection(const DetectionView& detection, const char* camera) {
+    // camera는 호출 측에서 검증된 고정 문자열이므로 이스케이프하지 않는다
+    // 키 순서는 기존 nlohmann::json 출력(알파벳 순)과 동일하게 유지
+    appendf("%s{\"camera\":\"%s\",\"frame_number\":%u,\"objects\":[",
+            firstDetection_ ? "" : ",", camera, detection.frameNumber);
+    firstDetection_ = false;
+
+    bool firstObject = true;
+    for (const DetectedObject& obj : detection) {
+        int color = static_cast<int>(obj.color);
+        if (color < 0 || color > static_cast<int>(BboxColor::NONE)) {
+            color = static_cast<int>(BboxColor::NONE);
+        }
+
+        appendf("%s{\"bbox\":[%d,%d,%d,%d],\"bbox_color\":\"%s\",\"class_id\":%d,"
+                "\"confidence\":%.9g,\"has_bbox\":%s}",
+                firstObject ? "" : ",",
+                obj.bbox.x, obj.bbox.y,
+                obj.bbox.x + obj.bbox.width, obj.bbox.y + obj.bbox.height,
+                COLOR_NAMES[color], obj.classId,
+                static_cast<double>(obj.confidence),
+                obj.hasBbox ? "true" : "false");
+        firstObject = false;
+    }
+
+    appendf("],\"timestamp\":%lu}", detection.timestamp);
+}
+
+void JsonDetectionWriter::endDetections() {
+    append("],\"status\":\"success\"}");
+}
+
+bool JsonDetectionWriter::flush() {
+    if (used_ > 0 && ok_) {
+        ok_ = sink_(buffer_, used_);
+        if (ok_) {
+            bytesWritten_ += used_;
+        }
+    }
+    used_ = 0;
+    return ok_;
+}
+
+void JsonDetectionWriter::append(const char* text) {
+    append(text, strlen(text));
+}
+
+void JsonDetectionWriter::append(const char* data, size_t length) {
+    if (!ok_) {
+        return;
+    }
+    if (used_ + length > BUFFER_SIZE) {
+        flush();
+    }
+    if (length > BUFFER_SIZE) {
+        // 버퍼보다 큰 조각은 그대로 전송
+        ok_ = ok_ && sink_(data, length);
+        if (ok_) {
+            bytesWritten_ += length;
+        }
+        return;
+    }
+    memcpy(buffer_ + used_, data, length);
+    used_ += length;
+}
+
+void JsonDetectionWriter::appendf(const char* format, ...) {
+    if (!ok_) {
+        return;
+    }
+    if (BUFFER_SIZE - used_ < MAX_RECORD_LENGTH) {
+        flush();
+    }
+
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer_ + used_, BUFFER_SIZE - used_, format, args);
+    va_end(args);
+
+    if (length < 0) {
+        return;
+    }
+    if (static_cast<size_t>(length) >= BUFFER_SIZE - used_) {
+        // 여유 공간 부족 - 비우고 다시 출력
+        flush();
+        va_start(args, format);
+        length = vsnprintf(buffer_, BUFFER_SIZE, format, args);
+        va_end(args);
+        if (length < 0) {
+            return;
+        }
+        used_ = std::min(static_cast<size_t>(length), BUFFER_SIZE - 1);
+        return;
+    }
+    used_ += length;
+}
@@ -0,0 +1,45 @@
+#ifndef JSON_DETECTION_WRITER_H
+#define JSON_DETECTION_WRITER_H
+
+#include <cstddef>
+#include <functional>
+#include "../detection/DetectionBuffer.h"
+
+// 검출 결과 스트리밍 JSON 인코더
+// DOM을 만들지 않고 고정 크기 버퍼에 직접 직렬화하며, 버퍼가 차면 sink로 내보낸다.
+// 출력 형식은 기존 /api/get_detections 응답과 동일하다.
+class JsonDetectionWriter {
+public:
+    static constexpr size_t BUFFER_SIZE = 16 * 1024;
+
+    // 반환값 false = 전송 실패 (이후 출력은 버려짐)
+    using Sink = std::function<bool(const char* data, size_t length)>;
+
+    explicit JsonDetectionWriter(Sink sink);
+
+    // {"detections":[ ... ],"status":"success"}
+    void beginDetections();
+    void writeDetection(const DetectionView& detection, const char* camera);
+    void endDetections();
+
+    // 남은 데이터 전송
+    bool flush();
+
+    bool ok() const { return ok_; }
+    size_t bytesWritten() const { return bytesWritten_; }
+
+private:
+    void append(const char* text);
+    void append(const char* data, size_t length);
+    void appendf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+private:
+    Sink sink_;
+    char buffer_[BUFFER_SIZE];
+    size_t used_;
+    size_t bytesWritten_;
+    bool ok_;
+    bool firstDetection_;
+};
+
+#endif // JSON_DETECTION_WRITER_H
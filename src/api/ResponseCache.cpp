@@ -0,0 +1,54 @@
+#include "ResponseCache.h"
+
+ResponseCache::ResponseCache(size_t maxEntries)
+    : maxEntries_(maxEntries)
+    , hits_(0)
+    , misses_(0) {
+}
+
+ResponseCache::Body ResponseCache::lookup(const std::string& key, uint64_t generation) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end() && it->second.generation == generation) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return it->second.body;
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void ResponseCache::store(const std::string& key, uint64_t generation, Body body) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        // 동시에 만든 응답 중 더 새로운 세대를 유지
+        if (generation >= it->second.generation) {
+            it->second.generation = generation;
+            it->second.body = std::move(body);
+        }
+        return;
+    }
+
+    // 키 종류는 라우트 파라미터 조합으로 제한되지만, 만약을 위해 상한을 둔다
+    if (entries_.size() >= maxEntries_) {
+        entries_.clear();
+    }
+    entries_.emplace(key, Entry{generation, std::move(body)});
+}
+
+ResponseCache::Stats ResponseCache::getStats() const {
+    Stats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.entries = entries_.size();
+    return stats;
+}
+
+void ResponseCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
@@ -0,0 +1,48 @@
+#ifndef RESPONSE_CACHE_H
+#define RESPONSE_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// 라우트별 직렬화 응답 캐시
+// 키(파라미터 조합)마다 마지막 본문과 그 본문을 만들 때의 데이터 세대를 보관하고,
+// 세대가 같을 때만 재사용한다. 본문은 shared_ptr로 공유되어 복사 없이 전송된다.
+class ResponseCache {
+public:
+    using Body = std::shared_ptr<const std::string>;
+
+    struct Stats {
+        uint64_t hits;
+        uint64_t misses;
+        size_t entries;
+    };
+
+    explicit ResponseCache(size_t maxEntries = 64);
+
+    // 같은 세대의 본문이 있으면 반환 (없으면 nullptr, miss로 집계)
+    Body lookup(const std::string& key, uint64_t generation);
+
+    // generation은 본문을 만들기 전에 읽은 값이어야 한다
+    void store(const std::string& key, uint64_t generation, Body body);
+
+    Stats getStats() const;
+    void clear();
+
+private:
+    struct Entry {
+        uint64_t generation;
+        Body body;
+    };
+
+    size_t maxEntries_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> misses_;
+};
+
+#endif // RESPONSE_CACHE_H
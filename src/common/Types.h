@@ -42,6 +42,7 @@ struct DetectedObject {
     BoundingBox bbox;
     BboxColor color;
     bool hasBbox;
+    uint64_t trackId = UINT64_MAX;  // 추적기 ID (추적기가 없으면 UNTRACKED_OBJECT_ID)
 };
 
 struct DetectionData {
@@ -105,5 +106,15 @@ struct SystemConfig {
     std::vector<CameraConfig> cameras;
     std::string snapshotPath;
     int apiPort;
+    int apiWorkerThreads;
+    int apiMaxConnections;
+    int apiKeepAliveTimeoutMs;
+    std::string logOverflowPolicy;  // "drop" | "block"
+    std::string logFormat;          // "text" | "binary"
+    int logMaxFileSizeMb;           // 같은 날 회전 크기 (0: 날짜 회전만)
+    bool logCompress;               // 회전된 로그 gzip 압축
+    int logMaxArchives;             // 보관 파일 수 (0: 제한 없음)
+    int logRetentionDays;           // 보관 기간 (0: 제한 없음)
+    int logRateLimitPerSec;         // 호출 위치당 초당 로그 수 (0: 제한 없음)
 };
 #endif // TYPES_H
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "PTZController.h"
 #include "../utils/SerialComm.h"
 #include "../utils/Logger.h"
+#include "../utils/Metrics.h"
 #include <sstream>
 #include <cstring>
 #include <unistd.h>
@@ -15,6 +16,16 @@ PTZController::PTZController()
     // 위치 배열 초기화
     memset(ptzPositions_, 0, sizeof(ptzPositions_));
     memset(ranchPositions_, 0, sizeof(ranchPositions_));
+    
+    MetricsRegistry& registry = MetricsRegistry::getInstance();
+    const char* name = "ptz_command_duration_seconds";
+    const char* help = "PTZ command latency including the serial response wait";
+    const std::vector<double>& buckets = Histogram::latencyBuckets();
+    moveLatency_ = &registry.histogram(name, help, buckets, {{"command", "move"}});
+    stopLatency_ = &registry.histogram(name, help, buckets, {{"command", "stop"}});
+    presetLatency_ = &registry.histogram(name, help, buckets, {{"command", "preset"}});
+    ranchLatency_ = &registry.histogram(name, help, buckets, {{"command", "ranch"}});
+    pipeLatency_ = &registry.histogram(name, help, buckets, {{"command", "pipe"}});
 }
 
 PTZController::~PTZController() {
@@ -48,6 +59,7 @@ void PTZController::close() {
 }
 
 bool PTZController::sendMoveCommand(Direction direction, int speed) {
+    Histogram::Timer timer((speed > 0) ? *moveLatency_ : *stopLatency_);
     std::lock_guard<std::mutex> lock(controlMutex_);
     
     if (!serial_ || !serial_->isOpen()) {
@@ -136,6 +148,11 @@ bool PTZController::sendMoveCommand(Direction direction, int speed) {
     
     moveSpeed_ = speed;
     LOG_DEBUG("PTZ move command sent: direction=%d, speed=%d", direction, speed);
+    
+    // 수동 이동이면 더 이상 프리셋 화면이 아니다
+    if (speed > 0 && presetCallback_) {
+        presetCallback_(-1);
+    }
     return true;
 }
 
@@ -201,6 +218,7 @@ bool PTZController::moveToPTZPosition(int index, bool isAutoMode) {
         return false;
     }
     
+    Histogram::Timer timer(*presetLatency_);
     std::lock_guard<std::mutex> lock(controlMutex_);
     
     if (!serial_ || !serial_->isOpen()) {
@@ -238,6 +256,9 @@ bool PTZController::moveToPTZPosition(int index, bool isAutoMode) {
     int ret = serial_->readWithTimeout(response, sizeof(response), 1000);
     if (ret > 0 && response[5] == 0x00) {
         LOG_INFO("Moving to PTZ position %d", index);
+        if (presetCallback_) {
+            presetCallback_(index);
+        }
         return true;
     }
     
@@ -304,6 +325,7 @@ bool PTZController::moveToRanchPosition(int index) {
     stopAutoMove();
     
     // PTZ 이동과 동일한 방식
+    Histogram::Timer timer(*ranchLatency_);
     std::lock_guard<std::mutex> lock(controlMutex_);
     
     uint8_t cmd[32];
@@ -319,7 +341,15 @@ bool PTZController::moveToRanchPosition(int index) {
     cmd[15] = 0x40;  // Ranch 속도
     cmd[16] = calculateChecksum(cmd, 16);
     
-    return serial_->write(cmd, 17);
+    if (!serial_->write(cmd, 17)) {
+        return false;
+    }
+    
+    // Ranch 위치는 프리셋 마스크 대상이 아니다
+    if (presetCallback_) {
+        presetCallback_(-1);
+    }
+    return true;
 }
 
 bool PTZController::startAutoMove(const std::string& sequence) {
@@ -372,6 +402,7 @@ bool PTZController::isAutoMoveRunning() const {
 }
 
 void PTZController::sendPipeCommand(const std::string& command) {
+    Histogram::Timer timer(*pipeLatency_);
     if (command == "up") {
         uint8_t cmd[] = {0x96, 0x0, 0x14, 0x1, 0x6, 0x81, 0x1, 0x4, 0x16, 0x1, 0xFF, 0x4D};
         serial_->write(cmd, sizeof(cmd));
@@ -5,9 +5,11 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <functional>
 #include <vector>
 
 class SerialComm;
+class Histogram;
 
 class PTZController {
 public:
@@ -29,6 +31,9 @@ public:
     static constexpr int MAX_RANCH_POS = 32;
     static constexpr int PTZ_POS_SIZE = 11;
     
+    // 프리셋으로 이동하면 프리셋 번호, 수동/Ranch 이동이면 -1 (제어 스레드에서 호출)
+    using PresetCallback = std::function<void(int preset)>;
+    
     struct PTZPosition {
         bool isSet;
         uint8_t data[PTZ_POS_SIZE];
@@ -66,6 +71,9 @@ public:
     // 특수 명령
     void sendPipeCommand(const std::string& command);
     
+    // 위치 변경 알림 (init 전에 한 번 설정)
+    void setPresetCallback(PresetCallback callback) { presetCallback_ = callback; }
+    
 private:
     void autoMoveThread();
     bool parseAutoMoveSequence(const std::string& sequence, std::vector<int>& positions);
@@ -88,6 +96,14 @@ private:
     std::atomic<ErrorCode> lastError_;
     std::atomic<int> moveSpeed_;
     std::mutex controlMutex_;
+    PresetCallback presetCallback_;
+    
+    // 명령 지연 지표 (잠금 대기 + 시리얼 송신 + 응답 대기)
+    Histogram* moveLatency_;
+    Histogram* stopLatency_;
+    Histogram* presetLatency_;
+    Histogram* ranchLatency_;
+    Histogram* pipeLatency_;
 };
 
 #endif // PTZ_CONTROLLER_H
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef DEEPSTREAM_META_H
+#define DEEPSTREAM_META_H
+
+// DeepStream 배치 메타데이터 타입
+// - HAVE_DEEPSTREAM (ENABLE_DEEPSTREAM=ON): SDK 헤더를 그대로 쓴다
+// - 그 외: 검출 코드가 읽는 필드만 같은 이름으로 가진 CPU 대체 타입.
+//   CPU 대체 요소(identity)는 배치 메타를 붙이지 않으므로 gst_buffer_get_nvds_batch_meta는 항상 nullptr이고,
+//   벤치마크/테스트는 이 타입으로 메타데이터를 직접 만들어 Detector::processBatchMeta에 넘길 수 있다
+
+#ifdef HAVE_DEEPSTREAM
+
+#include <nvdsmeta.h>
+#include <gstnvdsmeta.h>
+
+#else
+
+#include <cstdint>
+
+#define UNTRACKED_OBJECT_ID 0xFFFFFFFFFFFFFFFF
+
+struct NvDsMetaList {
+    void* data;
+    NvDsMetaList* next;
+    NvDsMetaList* prev;
+};
+
+struct NvOSD_RectParams {
+    float left;
+    float top;
+    float width;
+    float height;
+};
+
+struct NvDsObjectMeta {
+    int class_id;
+    uint64_t object_id;
+    float confidence;
+    NvOSD_RectParams rect_params;
+};
+
+struct NvDsFrameMeta {
+    unsigned int source_id;
+    int frame_num;
+    uint64_t buf_pts;
+    uint64_t ntp_timestamp;
+    NvDsMetaList* obj_meta_list;
+};
+
+struct NvDsBatchMeta {
+    unsigned int num_frames_in_batch;
+    NvDsMetaList* frame_meta_list;
+};
+
+typedef struct _GstBuffer GstBuffer;
+
+inline NvDsBatchMeta* gst_buffer_get_nvds_batch_meta(GstBuffer* buffer) {
+    (void)buffer;
+    return nullptr;
+}
+
+#endif // HAVE_DEEPSTREAM
+
+#endif // DEEPSTREAM_META_H
@@ -2,13 +2,39 @@
 #include "../utils/Logger.h"
 #include <algorithm>
 #include <chrono>
+#include <cstring>
 
-DetectionBuffer::DetectionBuffer(CameraType cameraType, size_t maxSize)
+namespace {
+    // 범위 조회 시 한 번에 복사/검증하는 프레임 수
+    constexpr size_t READ_CHUNK_FRAMES = 64;
+    // 최신 프레임 조회 재시도 횟수 (재시도 상한이 있으므로 wait-free)
+    constexpr int LATEST_READ_ATTEMPTS = 4;
+}
+
+struct DetectionBuffer::ReaderScratch {
+    std::vector<FrameCopy> frames;
+    std::vector<DetectedObject> objects;
+
+    void reset() {
+        frames.clear();
+        objects.clear();
+    }
+};
+
+DetectionBuffer::DetectionBuffer(CameraType cameraType, size_t maxSize, size_t objectCapacity)
     : cameraType_(cameraType)
-    , maxSize_(maxSize) {
-    
-    LOG_INFO("Detection buffer created for %s camera (max size: %zu)",
-             (cameraType == CameraType::RGB) ? "RGB" : "THERMAL", maxSize);
+    , maxSize_(std::max<size_t>(maxSize, 1))
+    , objectCapacity_(objectCapacity > 0 ? objectCapacity : maxSize_ * DEFAULT_OBJECTS_PER_FRAME)
+    , frames_(new FrameSlot[maxSize_])
+    , head_(0)
+    , tail_(0)
+    , generation_(0)
+    , objectPool_(new DetectedObject[objectCapacity_])
+    , objectCursor_(0)
+    , lastTimestamp_(0) {
+
+    LOG_INFO("Detection buffer created for %s camera (max size: %zu, object pool: %zu)",
+             (cameraType == CameraType::RGB) ? "RGB" : "THERMAL", maxSize_, objectCapacity_);
 }
 
 DetectionBuffer::~DetectionBuffer() {
@@ -16,90 +42,321 @@ DetectionBuffer::~DetectionBuffer() {
 }
 
 void DetectionBuffer::addDetection(const DetectionData& detection) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
+    addDetection(detection.timestamp, detection.frameNumber,
+                 detection.objects.data(), detection.objects.size());
+}
+
+void DetectionBuffer::addDetection(uint64_t timestamp, uint32_t frameNumber,
+                                   const DetectedObject* objects, size_t objectCount) {
     // 타임스탬프가 없으면 현재 시간 사용
-    DetectionData data = detection;
-    if (data.timestamp == 0) {
+    if (timestamp == 0) {
         auto now = std::chrono::system_clock::now();
         auto duration = now.time_since_epoch();
-        data.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
-    }
-    
-    // 카메라 타입 설정
-    data.cameraType = cameraType_;
-    
-    // 버퍼에 추가
-    buffer_.push_back(data);
-    
-    // 버퍼 크기 제한
-    if (buffer_.size() > maxSize_) {
-        buffer_.pop_front();
-    }
-    
-    // 오래된 데이터 제거
-    removeOldDetections();
-    
-    LOG_TRACE("Detection added: frame=%u, objects=%zu, buffer_size=%zu",
-              data.frameNumber, data.objects.size(), buffer_.size());
+        timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    }
+
+    // 이진 탐색을 위해 타임스탬프 단조 증가 유지
+    // 조금 뒤로 가면 직전 값으로 보정한다. 크게 뒤로 가면 (NTP/RTC 조정 후 Detector가 재기준) 보정 시
+    // 단계 크기만큼 모든 프레임이 옛 시각에 묶이므로, 이전 프레임을 퇴역시키고 새 시각부터 다시 쌓는다
+    if (timestamp < lastTimestamp_) {
+        if (lastTimestamp_ - timestamp >= CLOCK_STEP_NS) {
+            uint64_t head = head_.load(std::memory_order_relaxed);
+            uint64_t tail = tail_.load(std::memory_order_relaxed);
+            retireUntil(head);
+            LOG_WARN("Detection buffer clock stepped back %.3f s, retired %lu frames",
+                     (lastTimestamp_ - timestamp) / 1e9, head - tail);
+        } else {
+            timestamp = lastTimestamp_;
+        }
+    }
+    lastTimestamp_ = timestamp;
+
+    // 풀보다 큰 프레임은 잘라냄
+    if (objectCount > objectCapacity_) {
+        LOG_WARN("Detection frame %u has %zu objects, truncated to %zu",
+                 frameNumber, objectCount, objectCapacity_);
+        objectCount = objectCapacity_;
+    }
+
+    // 프레임의 객체가 풀 끝에서 잘리지 않도록 필요하면 처음으로 넘김
+    uint64_t objectBegin = objectCursor_;
+    size_t offset = objectBegin % objectCapacity_;
+    if (offset + objectCount > objectCapacity_) {
+        objectBegin += objectCapacity_ - offset;
+        offset = 0;
+    }
+    uint64_t objectEnd = objectBegin + objectCount;
+
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+
+    // 덮어쓸 프레임 슬롯과 객체 영역을 가진 프레임을 먼저 퇴역시킨다
+    uint64_t newTail = std::max(tail, (head + 1 > maxSize_) ? head + 1 - maxSize_ : 0);
+    if (objectEnd > objectCapacity_) {
+        uint64_t validFrom = objectEnd - objectCapacity_;
+        while (newTail < head &&
+               slot(newTail).objectBegin.load(std::memory_order_relaxed) < validFrom) {
+            newTail++;
+        }
+    }
+    if (newTail > tail) {
+        retireUntil(newTail);
+    }
+
+    // 퇴역을 먼저 보이게 한 뒤 데이터를 쓴다 (독자는 읽은 뒤 tail로 검증)
+    std::atomic_thread_fence(std::memory_order_release);
+
+    FrameSlot& record = slot(head);
+    record.timestamp.store(timestamp, std::memory_order_relaxed);
+    record.frameNumber.store(frameNumber, std::memory_order_relaxed);
+    record.objectCount.store(static_cast<uint32_t>(objectCount), std::memory_order_relaxed);
+    record.objectBegin.store(objectBegin, std::memory_order_relaxed);
+
+    if (objectCount > 0) {
+        memcpy(objectPool_.get() + offset, objects, objectCount * sizeof(DetectedObject));
+    }
+    objectCursor_ = objectEnd;
+
+    // 게시
+    head_.store(head + 1, std::memory_order_release);
+    generation_.fetch_add(1, std::memory_order_release);
+    if (listener_) {
+        listener_();
+    }
+
+    // 오래된 데이터 제거 (새 항목 시각 기준, 일괄 처리)
+    if (timestamp > BUFFER_DURATION_NS) {
+        tail = tail_.load(std::memory_order_relaxed);
+        uint64_t expired = lowerBound(tail, head + 1, timestamp - BUFFER_DURATION_NS);
+        if (expired > tail) {
+            retireUntil(expired);
+            LOG_TRACE("Removed %lu old detections", expired - tail);
+        }
+    }
+
+    LOG_TRACE("Detection added: frame=%u, objects=%zu, buffer_size=%lu",
+              frameNumber, objectCount, head + 1 - tail_.load(std::memory_order_relaxed));
 }
 
 std::vector<DetectionData> DetectionBuffer::getDetectionsInTimeRange(
     uint64_t startTime, uint64_t endTime) const {
-    
-    std::lock_guard<std::mutex> lock(mutex_);
+
     std::vector<DetectionData> results;
-    
-    for (const auto& detection : buffer_) {
-        if (detection.timestamp >= startTime && detection.timestamp <= endTime) {
-            results.push_back(detection);
+
+    visitDetectionsInTimeRange(startTime, endTime, [&results](const DetectionView& view) {
+        DetectionData data;
+        data.timestamp = view.timestamp;
+        data.frameNumber = view.frameNumber;
+        data.cameraType = view.cameraType;
+        data.objects.assign(view.begin(), view.end());
+        results.push_back(std::move(data));
+    });
+
+    return results;
+}
+
+bool DetectionBuffer::getLatestDetection(DetectionData& detection) const {
+    return visitLatestDetection([&detection](const DetectionView& view) {
+        detection.timestamp = view.timestamp;
+        detection.frameNumber = view.frameNumber;
+        detection.cameraType = view.cameraType;
+        detection.objects.assign(view.begin(), view.end());
+    });
+}
+
+size_t DetectionBuffer::visitDetectionsInTimeRange(uint64_t startTime, uint64_t endTime,
+                                                   const DetectionVisitor& visitor) const {
+    if (startTime > endTime) {
+        return 0;
+    }
+
+    // 1. 범위 경계 탐색 (탐색 중 덮어쓰기가 있었으면 다시 탐색)
+    uint64_t first, last;
+    while (true) {
+        uint64_t tail = tail_.load(std::memory_order_acquire);
+        uint64_t head = head_.load(std::memory_order_acquire);
+        first = lowerBound(tail, head, startTime);
+        last = upperBound(first, head, endTime);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (tail_.load(std::memory_order_relaxed) <= tail) {
+            break;
         }
     }
-    
+
+    size_t visited = visitIndexRange(first, last, visitor);
+
     LOG_DEBUG("Found %zu detections in time range [%lu - %lu]",
-              results.size(), startTime, endTime);
-    
-    return results;
+              visited, startTime, endTime);
+
+    return visited;
 }
 
-bool DetectionBuffer::getLatestDetection(DetectionData& detection) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (buffer_.empty()) {
-        return false;
+uint64_t DetectionBuffer::getGeneration() const {
+    return generation_.load(std::memory_order_acquire);
+}
+
+uint64_t DetectionBuffer::getHeadIndex() const {
+    return head_.load(std::memory_order_acquire);
+}
+
+uint64_t DetectionBuffer::visitDetectionsSince(uint64_t index,
+                                               const DetectionVisitor& visitor) const {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t first = std::max(index, tail_.load(std::memory_order_acquire));
+    if (first < head) {
+        visitIndexRange(first, head, visitor);
     }
-    
-    detection = buffer_.back();
-    return true;
+    return std::max(index, head);
+}
+
+void DetectionBuffer::setDetectionListener(DetectionListener listener) {
+    listener_ = std::move(listener);
+}
+
+size_t DetectionBuffer::visitIndexRange(uint64_t first, uint64_t last,
+                                        const DetectionVisitor& visitor) const {
+    // 청크 단위로 복사 -> 검증 -> 방문 (메모리 사용량은 청크 크기로 제한)
+    thread_local ReaderScratch scratch;
+    size_t visited = 0;
+    uint64_t index = first;
+
+    while (index < last) {
+        uint64_t chunkEnd = std::min<uint64_t>(last, index + READ_CHUNK_FRAMES);
+
+        scratch.reset();
+        for (uint64_t i = index; i < chunkEnd; i++) {
+            copyFrame(i, scratch);
+        }
+
+        // 복사 도중 퇴역(덮어쓰기 포함)된 프레임은 버린다
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t validFrom = tail_.load(std::memory_order_relaxed);
+
+        for (const FrameCopy& frame : scratch.frames) {
+            if (frame.index >= validFrom) {
+                visitor(makeView(frame, scratch));
+                visited++;
+            }
+        }
+
+        index = std::max(chunkEnd, validFrom);
+    }
+
+    return visited;
+}
+
+bool DetectionBuffer::visitLatestDetection(const DetectionVisitor& visitor) const {
+    thread_local ReaderScratch scratch;
+
+    for (int attempt = 0; attempt < LATEST_READ_ATTEMPTS; attempt++) {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        if (head == 0 || tail_.load(std::memory_order_acquire) >= head) {
+            return false;
+        }
+
+        scratch.reset();
+        copyFrame(head - 1, scratch);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (tail_.load(std::memory_order_relaxed) < head) {
+            visitor(makeView(scratch.frames.front(), scratch));
+            return true;
+        }
+    }
+
+    return false;
 }
 
 void DetectionBuffer::clearOldDetections() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    removeOldDetections();
+    auto now = std::chrono::system_clock::now();
+    auto duration = now.time_since_epoch();
+    uint64_t currentTime = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    retireUntil(lowerBound(tail, head, currentTime - BUFFER_DURATION_NS));
 }
 
 size_t DetectionBuffer::getBufferSize() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return buffer_.size();
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    return (head > tail) ? static_cast<size_t>(head - tail) : 0;
 }
 
 void DetectionBuffer::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    buffer_.clear();
+    retireUntil(head_.load(std::memory_order_acquire));
     LOG_INFO("Detection buffer cleared");
 }
 
-void DetectionBuffer::removeOldDetections() {
-    auto now = std::chrono::system_clock::now();
-    auto duration = now.time_since_epoch();
-    uint64_t currentTime = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
-    uint64_t cutoffTime = currentTime - BUFFER_DURATION_NS;
-    
-    // 오래된 데이터 제거
-    auto it = buffer_.begin();
-    while (it != buffer_.end() && it->timestamp < cutoffTime) {
-        it = buffer_.erase(it);
-    }
-    
-    LOG_TRACE("Removed old detections, buffer size: %zu", buffer_.size());
-}
\ No newline at end of file
+DetectionBuffer::FrameSlot& DetectionBuffer::slot(uint64_t index) const {
+    return frames_[index % maxSize_];
+}
+
+uint64_t DetectionBuffer::lowerBound(uint64_t lo, uint64_t hi, uint64_t timestamp) const {
+    // [lo, hi) 에서 timestamp 이상인 첫 절대 인덱스
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (slot(mid).timestamp.load(std::memory_order_relaxed) < timestamp) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+uint64_t DetectionBuffer::upperBound(uint64_t lo, uint64_t hi, uint64_t timestamp) const {
+    // [lo, hi) 에서 timestamp 초과인 첫 절대 인덱스
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (slot(mid).timestamp.load(std::memory_order_relaxed) <= timestamp) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+void DetectionBuffer::copyFrame(uint64_t index, ReaderScratch& scratch) const {
+    const FrameSlot& record = slot(index);
+
+    FrameCopy frame;
+    frame.index = index;
+    frame.timestamp = record.timestamp.load(std::memory_order_relaxed);
+    frame.frameNumber = record.frameNumber.load(std::memory_order_relaxed);
+    frame.objectCount = record.objectCount.load(std::memory_order_relaxed);
+    frame.objectOffset = scratch.objects.size();
+
+    // 덮어쓰는 중인 값일 수 있으므로 풀 범위를 벗어나지 않게 제한 (검증 단계에서 버려짐)
+    size_t poolOffset = record.objectBegin.load(std::memory_order_relaxed) % objectCapacity_;
+    frame.objectCount = std::min(frame.objectCount, objectCapacity_ - poolOffset);
+
+    scratch.objects.insert(scratch.objects.end(),
+                           objectPool_.get() + poolOffset,
+                           objectPool_.get() + poolOffset + frame.objectCount);
+    scratch.frames.push_back(frame);
+}
+
+DetectionView DetectionBuffer::makeView(const FrameCopy& frame, const ReaderScratch& scratch) const {
+    DetectionView view;
+    view.timestamp = frame.timestamp;
+    view.frameNumber = frame.frameNumber;
+    view.cameraType = cameraType_;
+    view.objects = scratch.objects.data() + frame.objectOffset;
+    view.objectCount = frame.objectCount;
+    return view;
+}
+
+void DetectionBuffer::retireUntil(uint64_t index) {
+    // tail은 앞으로만 이동 (생산자와 clear()가 동시에 호출할 수 있음)
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    while (tail < index) {
+        if (tail_.compare_exchange_weak(tail, index, std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+            generation_.fetch_add(1, std::memory_order_release);
+            break;
+        }
+    }
+}
@@ -3,39 +3,122 @@
 
 #include <memory>
 #include <vector>
-#include <mutex>
-#include <deque>
+#include <atomic>
+#include <functional>
 #include "../common/Types.h"
 
+// 읽기 전용 검출 프레임 뷰 (방문 콜백 안에서만 유효)
+struct DetectionView {
+    uint64_t timestamp;
+    uint32_t frameNumber;
+    CameraType cameraType;
+    const DetectedObject* objects;
+    size_t objectCount;
+
+    const DetectedObject* begin() const { return objects; }
+    const DetectedObject* end() const { return objects + objectCount; }
+};
+
+// 단일 생산자 / 다중 독자 검출 버퍼
+// - addDetection은 하나의 스레드(파이프라인 스트리밍 스레드)에서만 호출하며 락을 잡지 않는다.
+// - 독자는 락 없이 읽고, 읽는 도중 덮어써진 프레임은 버리고 다시 시도한다.
 class DetectionBuffer {
 public:
     static constexpr size_t DEFAULT_BUFFER_SIZE = 3600;  // 120초 * 30fps
+    static constexpr size_t DEFAULT_OBJECTS_PER_FRAME = 16;  // 객체 풀 크기 산정용 평균값
     static constexpr uint64_t BUFFER_DURATION_NS = 120ULL * 1000000000ULL;  // 120초
-    
-    DetectionBuffer(CameraType cameraType, size_t maxSize = DEFAULT_BUFFER_SIZE);
+    // 타임스탬프가 이 이상 뒤로 가면 벽시계 조정으로 보고 이전 프레임을 퇴역시킨다 (그 미만은 직전 값으로 보정)
+    static constexpr uint64_t CLOCK_STEP_NS = 1000000000ULL;  // 1초
+
+    using DetectionVisitor = std::function<void(const DetectionView&)>;
+    // 새 프레임 게시 알림 (생산자 스레드에서 호출되므로 가볍게 유지할 것)
+    using DetectionListener = std::function<void()>;
+
+    // objectCapacity가 0이면 maxSize * DEFAULT_OBJECTS_PER_FRAME
+    DetectionBuffer(CameraType cameraType, size_t maxSize = DEFAULT_BUFFER_SIZE,
+                    size_t objectCapacity = 0);
     ~DetectionBuffer();
-    
-    // 검출 데이터 추가
+
+    // 검출 데이터 추가 (생산자 스레드 전용)
     void addDetection(const DetectionData& detection);
-    
-    // 검출 데이터 조회
+    void addDetection(uint64_t timestamp, uint32_t frameNumber,
+                      const DetectedObject* objects, size_t objectCount);
+
+    // 검출 데이터 조회 (복사본)
     std::vector<DetectionData> getDetectionsInTimeRange(uint64_t startTime, uint64_t endTime) const;
     bool getLatestDetection(DetectionData& detection) const;
-    
+
+    // 검출 데이터 조회 (뷰, 반환값은 방문한 프레임 수)
+    // 뷰는 호출 스레드의 스크래치 영역을 가리키므로 콜백 안에서 다른 조회를 중첩 호출하지 말 것
+    size_t visitDetectionsInTimeRange(uint64_t startTime, uint64_t endTime,
+                                      const DetectionVisitor& visitor) const;
+    bool visitLatestDetection(const DetectionVisitor& visitor) const;
+
+    // 절대 인덱스 기반 조회 (구독자용)
+    // index 이후 게시된 프레임을 순서대로 방문하고, 다음에 이어서 읽을 인덱스를 반환한다.
+    // 이미 퇴역한 프레임은 건너뛴다.
+    uint64_t getHeadIndex() const;
+    uint64_t visitDetectionsSince(uint64_t index, const DetectionVisitor& visitor) const;
+
+    // 게시 알림 등록 (생산자 시작 전에 설정)
+    void setDetectionListener(DetectionListener listener);
+
+    // 내용이 바뀔 때마다(게시/퇴역) 증가하는 세대 번호 (응답 캐시 무효화용)
+    // 세대를 먼저 읽고 데이터를 읽으면, 같은 세대의 캐시는 그 데이터보다 오래되지 않았다.
+    uint64_t getGeneration() const;
+
     // 버퍼 관리
     void clearOldDetections();
     size_t getBufferSize() const;
     void clear();
-    
+
 private:
-    void removeOldDetections();
-    
+    // 프레임 슬롯: 객체는 objectPool_에 연속 저장, 오프셋/개수만 보관
+    // 독자가 쓰기 도중에 읽을 수 있으므로 필드는 relaxed 원자 변수로 둔다
+    struct FrameSlot {
+        std::atomic<uint64_t> timestamp{0};
+        std::atomic<uint64_t> objectBegin{0};  // 객체 풀의 절대 위치 (단조 증가)
+        std::atomic<uint32_t> frameNumber{0};
+        std::atomic<uint32_t> objectCount{0};
+    };
+
+    // 독자 측 스크래치에 복사한 프레임
+    struct FrameCopy {
+        uint64_t index;
+        uint64_t timestamp;
+        uint32_t frameNumber;
+        size_t objectOffset;
+        size_t objectCount;
+    };
+    struct ReaderScratch;
+
+    // 절대 인덱스 기반 접근 (index % maxSize_)
+    FrameSlot& slot(uint64_t index) const;
+    uint64_t lowerBound(uint64_t lo, uint64_t hi, uint64_t timestamp) const;
+    uint64_t upperBound(uint64_t lo, uint64_t hi, uint64_t timestamp) const;
+    size_t visitIndexRange(uint64_t first, uint64_t last, const DetectionVisitor& visitor) const;
+    void copyFrame(uint64_t index, ReaderScratch& scratch) const;
+    DetectionView makeView(const FrameCopy& frame, const ReaderScratch& scratch) const;
+    void retireUntil(uint64_t index);
+
 private:
     CameraType cameraType_;
     size_t maxSize_;
-    
-    mutable std::mutex mutex_;
-    std::deque<DetectionData> buffer_;
+    size_t objectCapacity_;
+
+    // 고정 크기 프레임 링 (타임스탬프 오름차순 유지)
+    std::unique_ptr<FrameSlot[]> frames_;
+    alignas(64) std::atomic<uint64_t> head_;  // 다음에 쓸 프레임의 절대 인덱스 (게시 위치)
+    alignas(64) std::atomic<uint64_t> tail_;  // 가장 오래된 유효 프레임의 절대 인덱스
+    std::atomic<uint64_t> generation_;
+
+    // 모든 프레임의 객체를 담는 연속 풀 (미리 할당)
+    std::unique_ptr<DetectedObject[]> objectPool_;
+
+    // 생산자 전용 상태
+    uint64_t objectCursor_;   // 다음 객체 쓰기 위치 (절대 위치)
+    uint64_t lastTimestamp_;
+    DetectionListener listener_;
 };
 
-#endif // DETECTION_BUFFER_H
\ No newline at end of file
+#endif // DETECTION_BUFFER_H
@@ -0,0 +1,442 @@
+#include "DetectionRules.h"
+#include "../utils/Logger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+    // 기존 하드코딩 값
+    const float DEFAULT_MIN_CONFIDENCE = 0.3f;
+    const float DEFAULT_MIN_DIAGONAL = 40.0f;
+    const float DEFAULT_MAX_DIAGONAL = 1000.0f;
+
+    // 이벤트 기본값: 최근 30 처리 프레임 중 20 프레임, 5 프레임 이하로 줄면 재무장, 같은 트랙은 5분에 한 번
+    const int DEFAULT_EVENT_WINDOW = 30;
+    const int DEFAULT_EVENT_HITS = 20;
+    const int DEFAULT_EVENT_RELEASE = 5;
+    const double DEFAULT_EVENT_COOLDOWN_SEC = 300.0;
+
+    bool parseColor(const std::string& name, BboxColor& color) {
+        if (name == "green") color = BboxColor::GREEN;
+        else if (name == "yellow") color = BboxColor::YELLOW;
+        else if (name == "red") color = BboxColor::RED;
+        else if (name == "blue") color = BboxColor::BLUE;
+        else if (name == "none") color = BboxColor::NONE;
+        else return false;
+        return true;
+    }
+
+    bool parseConfirmFlag(const std::string& name, uint32_t& flag) {
+        if (name == "resnet50") flag = DetectionRules::CONFIRM_RESNET50;
+        else if (name == "opt_flow") flag = DetectionRules::CONFIRM_OPT_FLOW;
+        else return false;
+        return true;
+    }
+
+    int cameraIndex(CameraType camera) {
+        return (camera == CameraType::RGB) ? 0 : 1;
+    }
+
+    bool parsePolygons(const json& list, std::vector<RoiMask::Polygon>& polygons) {
+        for (const auto& points : list) {
+            RoiMask::Polygon polygon;
+            for (const auto& point : points) {
+                if (!point.is_array() || point.size() != 2) {
+                    LOG_ERROR("Detection rules: polygon point must be [x, y]");
+                    return false;
+                }
+                polygon.push_back({point[0].get<float>(), point[1].get<float>()});
+            }
+            polygons.push_back(std::move(polygon));
+        }
+        return true;
+    }
+
+    // "mask" 항목의 프리셋 하나를 래스터화
+    bool buildMask(const json& config, const json& preset, RoiMask& mask) {
+        int frameWidth = 1280;
+        int frameHeight = 720;
+        if (config.contains("frame")) {
+            frameWidth = config["frame"].at(0).get<int>();
+            frameHeight = config["frame"].at(1).get<int>();
+        }
+        int cellSize = config.value("cell_size", 16);
+        std::string modeName = config.value("mode", "center");
+        if (modeName != "center" && modeName != "overlap") {
+            LOG_ERROR("Detection rules: unknown mask mode '%s'", modeName.c_str());
+            return false;
+        }
+        RoiMask::Mode mode = (modeName == "overlap") ? RoiMask::Mode::OVERLAP : RoiMask::Mode::CENTER;
+        float minOverlap = config.value("min_overlap", 0.5f);
+
+        std::vector<RoiMask::Polygon> include;
+        std::vector<RoiMask::Polygon> exclude;
+        if ((preset.contains("include") && !parsePolygons(preset["include"], include)) ||
+            (preset.contains("exclude") && !parsePolygons(preset["exclude"], exclude))) {
+            return false;
+        }
+        return mask.build(frameWidth, frameHeight, cellSize, include, exclude, mode, minOverlap);
+    }
+}
+
+DetectionRules::DetectionRules() {
+    for (ClassRule& rule : classes_) {
+        rule.minConfidence = DEFAULT_MIN_CONFIDENCE;
+        rule.colors[0] = BboxColor::GREEN;
+        rule.colors[1] = BboxColor::GREEN;
+        rule.confirmFlags = 0;
+        rule.roiCount = 0;
+    }
+    for (CameraRule& rule : cameras_) {
+        rule.minDiagonalSq = DEFAULT_MIN_DIAGONAL * DEFAULT_MIN_DIAGONAL;
+        rule.maxDiagonalSq = DEFAULT_MAX_DIAGONAL * DEFAULT_MAX_DIAGONAL;
+    }
+    for (EventRule& rule : events_) {
+        rule.window = 0;
+        rule.hits = 0;
+        rule.release = 0;
+        rule.confirmFlags = 0;
+        rule.cooldownNs = 0;
+    }
+    masks_.resize(1);
+    for (auto& camera : maskIndex_) {
+        for (int& index : camera) {
+            index = 0;
+        }
+    }
+}
+
+std::unique_ptr<DetectionRules> DetectionRules::defaults() {
+    std::unique_ptr<DetectionRules> rules(new DetectionRules());
+
+    // 발정 소: ResNet50 적용 시 확정 (빨강)
+    ClassRule& heat = rules->classes_[CLASS_HEAT_COW];
+    heat.colors[0] = BboxColor::YELLOW;
+    heat.colors[1] = BboxColor::RED;
+    heat.confirmFlags = CONFIRM_RESNET50;
+
+    // 뒤집힌 소: Optical Flow 적용 시 확정 (빨강)
+    ClassRule& flip = rules->classes_[CLASS_FLIP_COW];
+    flip.colors[0] = BboxColor::YELLOW;
+    flip.colors[1] = BboxColor::RED;
+    flip.confirmFlags = CONFIRM_OPT_FLOW;
+
+    rules->classes_[CLASS_LABOR_SIGN_COW].colors[0] = BboxColor::RED;
+    rules->classes_[CLASS_LABOR_SIGN_COW].colors[1] = BboxColor::RED;
+    rules->classes_[CLASS_OVER_TEMP].colors[0] = BboxColor::BLUE;
+    rules->classes_[CLASS_OVER_TEMP].colors[1] = BboxColor::BLUE;
+
+    // 이벤트: 분만 징후는 항상, 발정/전도는 확정(빨강)된 프레임만 센다
+    const int eventClasses[] = {CLASS_LABOR_SIGN_COW, CLASS_FLIP_COW, CLASS_HEAT_COW};
+    for (int id : eventClasses) {
+        EventRule& event = rules->events_[id];
+        event.window = DEFAULT_EVENT_WINDOW;
+        event.hits = DEFAULT_EVENT_HITS;
+        event.release = DEFAULT_EVENT_RELEASE;
+        event.confirmFlags = rules->classes_[id].confirmFlags;
+        event.cooldownNs = static_cast<uint64_t>(DEFAULT_EVENT_COOLDOWN_SEC * 1e9);
+    }
+    return rules;
+}
+
+std::unique_ptr<DetectionRules> DetectionRules::compile(const std::string& text) {
+    std::unique_ptr<DetectionRules> rules = defaults();
+
+    try {
+        json j = json::parse(text);
+
+        auto parseClass = [](const json& entry, ClassRule& rule) -> bool {
+            rule.minConfidence = entry.value("min_confidence", rule.minConfidence);
+
+            if (entry.contains("color")) {
+                if (!parseColor(entry["color"].get<std::string>(), rule.colors[0])) {
+                    LOG_ERROR("Detection rules: unknown color '%s'", entry["color"].get<std::string>().c_str());
+                    return false;
+                }
+                rule.colors[1] = rule.colors[0];
+            }
+
+            if (entry.contains("confirm_by")) {
+                rule.confirmFlags = 0;
+                for (const auto& name : entry["confirm_by"]) {
+                    uint32_t flag;
+                    if (!parseConfirmFlag(name.get<std::string>(), flag)) {
+                        LOG_ERROR("Detection rules: unknown confirm flag '%s'", name.get<std::string>().c_str());
+                        return false;
+                    }
+                    rule.confirmFlags |= flag;
+                }
+            }
+
+            if (entry.contains("confirmed_color")) {
+                if (!parseColor(entry["confirmed_color"].get<std::string>(), rule.colors[1])) {
+                    LOG_ERROR("Detection rules: unknown color '%s'",
+                              entry["confirmed_color"].get<std::string>().c_str());
+                    return false;
+                }
+            }
+
+            if (entry.contains("roi")) {
+                const json& rois = entry["roi"];
+                if (rois.size() > static_cast<size_t>(MAX_ROIS)) {
+                    LOG_ERROR("Detection rules: at most %d ROIs per class (got %zu)", MAX_ROIS, rois.size());
+                    return false;
+                }
+                rule.roiCount = 0;
+                for (const auto& rect : rois) {
+                    if (!rect.is_array() || rect.size() != 4) {
+                        LOG_ERROR("Detection rules: ROI must be [x, y, width, height]");
+                        return false;
+                    }
+                    Roi& roi = rule.rois[rule.roiCount++];
+                    roi.x0 = rect[0].get<float>();
+                    roi.y0 = rect[1].get<float>();
+                    roi.x1 = roi.x0 + rect[2].get<float>();
+                    roi.y1 = roi.y0 + rect[3].get<float>();
+                }
+            }
+            return true;
+        };
+
+        // confirmed_only의 확인 플래그는 클래스 규칙을 모두 읽은 뒤 confirm_by에서 가져온다
+        bool confirmedOnly[MAX_CLASSES];
+        for (int id = 0; id < MAX_CLASSES; id++) {
+            confirmedOnly[id] = (rules->events_[id].confirmFlags != 0);
+        }
+
+        auto parseEvent = [](const json& entry, EventRule& rule, bool& confirmed) -> bool {
+            if (entry.is_null()) {
+                rule.window = 0;
+                return true;
+            }
+            if (rule.window == 0) {
+                rule.window = DEFAULT_EVENT_WINDOW;
+                rule.hits = DEFAULT_EVENT_HITS;
+                rule.release = DEFAULT_EVENT_RELEASE;
+                rule.cooldownNs = static_cast<uint64_t>(DEFAULT_EVENT_COOLDOWN_SEC * 1e9);
+            }
+            rule.window = entry.value("window", rule.window);
+            rule.hits = entry.value("hits", std::min(rule.hits, rule.window));
+            rule.release = entry.value("release", std::min(rule.release, rule.hits - 1));
+            double cooldown = entry.value("cooldown", static_cast<double>(rule.cooldownNs) / 1e9);
+            rule.cooldownNs = static_cast<uint64_t>(std::max(cooldown, 0.0) * 1e9);
+            confirmed = entry.value("confirmed_only", confirmed);
+
+            if (rule.window < 1 || rule.window > MAX_EVENT_WINDOW ||
+                rule.hits < 1 || rule.hits > rule.window ||
+                rule.release < 0 || rule.release >= rule.hits) {
+                LOG_ERROR("Detection rules: invalid event window %d / hits %d / release %d "
+                          "(need 0 <= release < hits <= window <= %d)",
+                          rule.window, rule.hits, rule.release, MAX_EVENT_WINDOW);
+                return false;
+            }
+            return true;
+        };
+
+        // default 규칙은 클래스별 규칙의 출발점이므로 먼저 적용
+        if (j.contains("default")) {
+            ClassRule fallback = rules->classes_[MAX_CLASSES];
+            if (!parseClass(j["default"], fallback)) {
+                return nullptr;
+            }
+            for (ClassRule& rule : rules->classes_) {
+                rule.minConfidence = fallback.minConfidence;
+            }
+            rules->classes_[MAX_CLASSES] = fallback;
+        }
+
+        if (j.contains("classes")) {
+            for (const auto& entry : j["classes"]) {
+                int id = entry.value("id", -1);
+                if (id < 0 || id >= MAX_CLASSES) {
+                    LOG_ERROR("Detection rules: class id %d out of range [0, %d)", id, MAX_CLASSES);
+                    return nullptr;
+                }
+                if (!parseClass(entry, rules->classes_[id])) {
+                    return nullptr;
+                }
+                if (entry.contains("event") &&
+                    !parseEvent(entry["event"], rules->events_[id], confirmedOnly[id])) {
+                    return nullptr;
+                }
+            }
+        }
+
+        for (int id = 0; id < MAX_CLASSES; id++) {
+            EventRule& event = rules->events_[id];
+            event.confirmFlags = confirmedOnly[id] ? rules->classes_[id].confirmFlags : 0u;
+            if (event.window > 0 && confirmedOnly[id] && event.confirmFlags == 0) {
+                LOG_ERROR("Detection rules: class %d event is confirmed_only but has no confirm_by", id);
+                return nullptr;
+            }
+        }
+
+        if (j.contains("cameras")) {
+            const char* names[] = {"rgb", "thermal"};
+            for (int i = 0; i < 2; i++) {
+                if (!j["cameras"].contains(names[i])) {
+                    continue;
+                }
+                const json& cam = j["cameras"][names[i]];
+                float minDiagonal = cam.value("min_diagonal", DEFAULT_MIN_DIAGONAL);
+                float maxDiagonal = cam.value("max_diagonal", DEFAULT_MAX_DIAGONAL);
+                rules->cameras_[i].minDiagonalSq = minDiagonal * minDiagonal;
+                rules->cameras_[i].maxDiagonalSq = maxDiagonal * maxDiagonal;
+
+                if (!cam.contains("mask") || !cam["mask"].contains("presets")) {
+                    continue;
+                }
+                const json& maskConfig = cam["mask"];
+                int* index = rules->maskIndex_[i];
+
+                // default를 먼저 만들어 두고, 마스크가 없는 프리셋은 default를 가리킨다
+                const json& presets = maskConfig["presets"];
+                if (presets.contains("default")) {
+                    rules->masks_.emplace_back();
+                    if (!buildMask(maskConfig, presets["default"], rules->masks_.back())) {
+                        return nullptr;
+                    }
+                    for (int p = 0; p <= MAX_PRESETS; p++) {
+                        index[p] = static_cast<int>(rules->masks_.size()) - 1;
+                    }
+                }
+
+                for (auto it = presets.begin(); it != presets.end(); ++it) {
+                    if (it.key() == "default") {
+                        continue;
+                    }
+                    char* end = nullptr;
+                    long preset = std::strtol(it.key().c_str(), &end, 10);
+                    if (*end != '\0' || end == it.key().c_str() || preset < 0 || preset >= MAX_PRESETS) {
+                        LOG_ERROR("Detection rules: invalid PTZ preset '%s' for %s mask",
+                                  it.key().c_str(), names[i]);
+                        return nullptr;
+                    }
+                    rules->masks_.emplace_back();
+                    if (!buildMask(maskConfig, it.value(), rules->masks_.back())) {
+                        return nullptr;
+                    }
+                    index[preset + 1] = static_cast<int>(rules->masks_.size()) - 1;
+                }
+                LOG_INFO("Detection rules: %s masks for %zu presets", names[i], presets.size());
+            }
+        }
+
+    } catch (const json::exception& e) {
+        LOG_ERROR("Detection rules parsing error: %s", e.what());
+        return nullptr;
+    }
+
+    return rules;
+}
+
+std::unique_ptr<DetectionRules> DetectionRules::loadFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open detection rules file: %s", filename.c_str());
+        return nullptr;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    return compile(text.str());
+}
+
+const RoiMask& DetectionRules::mask(CameraType camera, int ptzPreset) const {
+    unsigned int slot = static_cast<unsigned int>(ptzPreset + 1);
+    return masks_[maskIndex_[cameraIndex(camera)][slot <= static_cast<unsigned int>(MAX_PRESETS) ? slot : 0]];
+}
+
+size_t DetectionRules::apply(CameraType camera, int ptzPreset, uint32_t confirmFlags,
+                             DetectedObject* objects, size_t count) const {
+    const CameraRule& cameraRule = cameras_[cameraIndex(camera)];
+    const RoiMask& roiMask = mask(camera, ptzPreset);
+
+    // 마스크 유무는 프레임마다 한 번만 가른다 (마스크가 없는 카메라는 객체당 조회 비용이 없다)
+    if (roiMask.empty()) {
+        return applyRules<false>(cameraRule, roiMask, confirmFlags, objects, count);
+    }
+    return applyRules<true>(cameraRule, roiMask, confirmFlags, objects, count);
+}
+
+template <bool Masked>
+size_t DetectionRules::applyRules(const CameraRule& cameraRule, const RoiMask& roiMask, uint32_t confirmFlags,
+                                  DetectedObject* objects, size_t count) const {
+    size_t kept = 0;
+
+    // 분기 대신 비교 결과를 값으로 쓰고, 남길 객체는 쓰기 위치만 전진시켜 압축한다
+    for (size_t i = 0; i < count; i++) {
+        DetectedObject obj = objects[i];
+        unsigned int slot = static_cast<unsigned int>(obj.classId);
+        const ClassRule& rule = classes_[slot < static_cast<unsigned int>(MAX_CLASSES) ? slot : MAX_CLASSES];
+
+        float width = static_cast<float>(obj.bbox.width);
+        float height = static_cast<float>(obj.bbox.height);
+        float diagonalSq = width * width + height * height;
+        bool sized = (diagonalSq >= cameraRule.minDiagonalSq) & (diagonalSq <= cameraRule.maxDiagonalSq);
+
+        float centerX = obj.bbox.x + width * 0.5f;
+        float centerY = obj.bbox.y + height * 0.5f;
+        bool inRoi = (rule.roiCount == 0);
+        for (int r = 0; r < rule.roiCount; r++) {
+            const Roi& roi = rule.rois[r];
+            inRoi |= (centerX >= roi.x0) & (centerX < roi.x1) & (centerY >= roi.y0) & (centerY < roi.y1);
+        }
+
+        bool confirmed = (rule.confirmFlags & confirmFlags) != 0;
+        obj.color = sized ? rule.colors[confirmed] : BboxColor::NONE;
+        obj.hasBbox = (obj.color != BboxColor::NONE);
+
+        objects[kept] = obj;
+        bool inMask = !Masked || roiMask.accepts(obj.bbox);
+        kept += static_cast<size_t>((obj.confidence > rule.minConfidence) & inRoi & inMask);
+    }
+    return kept;
+}
+
+DetectionRuleStore& DetectionRuleStore::getInstance() {
+    static DetectionRuleStore instance;
+    return instance;
+}
+
+DetectionRuleStore::DetectionRuleStore() {
+    tables_.push_back(DetectionRules::defaults());
+    current_.store(tables_.back().get(), std::memory_order_release);
+}
+
+bool DetectionRuleStore::load(const std::string& filename) {
+    std::unique_ptr<DetectionRules> rules = DetectionRules::loadFile(filename);
+    if (!rules) {
+        LOG_WARN("Keeping previous detection rules");
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        filename_ = filename;
+    }
+    publish(std::move(rules));
+    LOG_INFO("Detection rules loaded from %s", filename.c_str());
+    return true;
+}
+
+bool DetectionRuleStore::reload() {
+    std::string filename;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        filename = filename_;
+    }
+    if (filename.empty()) {
+        LOG_WARN("No detection rules file to reload");
+        return false;
+    }
+    return load(filename);
+}
+
+void DetectionRuleStore::publish(std::unique_ptr<DetectionRules> rules) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tables_.push_back(std::move(rules));
+    current_.store(tables_.back().get(), std::memory_order_release);
+}
@@ -0,0 +1,151 @@
+#ifndef DETECTION_RULES_H
+#define DETECTION_RULES_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../common/Types.h"
+#include "RoiMask.h"
+
+// 검출 필터/색상 규칙 표 (설정 파일에서 컴파일, 읽기 전용)
+// - 클래스별: 신뢰도 임계값, 기본 색상, 확인 플래그가 켜졌을 때의 색상, ROI 사각형
+// - 카메라별: 바운딩 박스 대각선 길이 범위 (벗어나면 박스 없음)
+// - 카메라 × PTZ 프리셋별: 다각형 ROI/축사 마스크 비트맵 (RoiMask, 밖이면 제거)
+// 규칙 파일 형식 (모든 항목 선택, 빠진 값은 기본 규칙):
+//   {
+//     "default": {"min_confidence": 0.3, "color": "green"},
+//     "classes": [
+//       {"id": 3, "min_confidence": 0.4, "color": "yellow",
+//        "confirmed_color": "red", "confirm_by": ["resnet50"],
+//        "roi": [[x, y, width, height], ...],
+//        "event": {"window": 30, "hits": 20, "release": 5, "cooldown": 300, "confirmed_only": true}}
+//     ],
+//     "cameras": {
+//       "rgb": {"min_diagonal": 40, "max_diagonal": 1000,
+//               "mask": {"frame": [1280, 720], "cell_size": 16, "mode": "center" | "overlap",
+//                        "min_overlap": 0.5,
+//                        "presets": {"default": {"include": [[[x, y], ...]], "exclude": [...]},
+//                                    "3": {...}}}},
+//       "thermal": {...}
+//     }
+//   }
+// 프리셋 키는 PTZ 프리셋 번호(0 ~ MAX_PRESETS-1). 마스크가 없는 프리셋과 수동 조작(-1)은 "default"를 쓴다
+// "event"는 EventConfirmer의 시간 확정 조건 (window는 처리한 프레임 수, cooldown은 초, "event": null이면 끔)
+class DetectionRules {
+public:
+    static constexpr int MAX_CLASSES = 16;  // 이 이상의 클래스 ID는 default 규칙
+    static constexpr int MAX_ROIS = 4;      // 클래스당 ROI 사각형 수
+    static constexpr int MAX_PRESETS = 12;  // PTZController::MAX_PTZ_PRESET
+    static constexpr int MAX_EVENT_WINDOW = 64;  // EventConfirmer의 창 비트 수
+
+    // 확인 플래그 (DeviceSetting의 분석 옵션)
+    enum ConfirmFlag : uint32_t {
+        CONFIRM_RESNET50 = 1u << 0,
+        CONFIRM_OPT_FLOW = 1u << 1
+    };
+
+    // 시간 확정 이벤트 조건 (window가 0이면 이벤트를 만들지 않는 클래스)
+    struct EventRule {
+        int window;             // 최근 처리 프레임 수 (1 ~ MAX_EVENT_WINDOW)
+        int hits;               // 창 안에서 이만큼 보이면 이벤트
+        int release;            // 이 이하로 줄어야 같은 트랙에서 다시 이벤트를 낼 수 있다
+        uint32_t confirmFlags;  // 0이 아니면 이 확인 플래그가 켜진 프레임만 증거로 센다
+        uint64_t cooldownNs;    // 같은 트랙/클래스의 이벤트 최소 간격
+    };
+
+    // 내장 기본 규칙 (규칙 파일이 없을 때)
+    static std::unique_ptr<DetectionRules> defaults();
+
+    // JSON 규칙을 컴파일. 실패하면 nullptr (오류는 로그로 남김)
+    static std::unique_ptr<DetectionRules> compile(const std::string& text);
+    static std::unique_ptr<DetectionRules> loadFile(const std::string& filename);
+
+    // 한 프레임의 객체 배열을 평가한다.
+    // 색상/hasBbox를 채우고, 신뢰도 미달이거나 클래스 ROI 밖이거나 현재 프리셋 마스크에서 벗어난 객체는
+    // 제거해 앞으로 모은다. 반환값은 남은 객체 수
+    size_t apply(CameraType camera, int ptzPreset, uint32_t confirmFlags,
+                 DetectedObject* objects, size_t count) const;
+
+    // 카메라/프리셋의 마스크 (없으면 빈 마스크)
+    const RoiMask& mask(CameraType camera, int ptzPreset) const;
+
+    const EventRule& event(int classId) const {
+        unsigned int slot = static_cast<unsigned int>(classId);
+        return events_[slot < static_cast<unsigned int>(MAX_CLASSES) ? slot : MAX_CLASSES];
+    }
+
+private:
+    // ROI는 [x0, x1) × [y0, y1) 픽셀 범위, 박스 중심으로 판정
+    struct Roi {
+        float x0;
+        float y0;
+        float x1;
+        float y1;
+    };
+
+    struct ClassRule {
+        float minConfidence;
+        BboxColor colors[2];   // [0]: 기본, [1]: confirmFlags가 켜졌을 때
+        uint32_t confirmFlags;
+        int roiCount;          // 0이면 화면 전체
+        Roi rois[MAX_ROIS];
+    };
+
+    struct CameraRule {
+        float minDiagonalSq;
+        float maxDiagonalSq;
+    };
+
+    DetectionRules();
+
+    template <bool Masked>
+    size_t applyRules(const CameraRule& cameraRule, const RoiMask& roiMask, uint32_t confirmFlags,
+                      DetectedObject* objects, size_t count) const;
+
+    // classes_[MAX_CLASSES]는 default 규칙
+    ClassRule classes_[MAX_CLASSES + 1];
+    CameraRule cameras_[2];
+    // events_[MAX_CLASSES]는 이벤트 없음
+    EventRule events_[MAX_CLASSES + 1];
+
+    // masks_[0]은 빈 마스크. maskIndex_[카메라][0]은 default, [프리셋 + 1]은 각 프리셋
+    std::vector<RoiMask> masks_;
+    int maskIndex_[2][MAX_PRESETS + 1];
+};
+
+// 현재 규칙 표 (프로세스 전역, 실행 중 교체 가능)
+// 파이프라인 스레드는 current()로 포인터를 한 번 읽을 뿐 잠금을 잡지 않는다.
+// 교체된 표는 아직 읽는 스레드가 있을 수 있어 프로세스 수명 동안 보관한다 (교체는 운영자 명령으로만 일어남)
+class DetectionRuleStore {
+public:
+    static DetectionRuleStore& getInstance();
+
+    // 규칙 파일을 읽어 교체. 실패하면 기존 표를 유지하고 false
+    bool load(const std::string& filename);
+    // 마지막으로 읽은 파일을 다시 읽음
+    bool reload();
+
+    void publish(std::unique_ptr<DetectionRules> rules);
+
+    const DetectionRules& current() const {
+        return *current_.load(std::memory_order_acquire);
+    }
+
+private:
+    DetectionRuleStore();
+    DetectionRuleStore(const DetectionRuleStore&) = delete;
+    DetectionRuleStore& operator=(const DetectionRuleStore&) = delete;
+
+    std::atomic<const DetectionRules*> current_;
+
+    std::mutex mutex_;  // 교체하는 쪽만 사용
+    std::vector<std::unique_ptr<const DetectionRules>> tables_;
+    std::string filename_;
+};
+
+#endif // DETECTION_RULES_H
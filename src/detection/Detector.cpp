@@ -1,16 +1,53 @@
 #include "Detector.h"
+#include "DetectionRules.h"
 #include "../utils/Logger.h"
 #include "../utils/DeviceSetting.h"
-#include <gstnvdsmeta.h>
-#include <nvdsinfer.h>
+#include "../utils/Metrics.h"
 #include <chrono>
 #include <fstream>
-#include <cmath>
+
+// 추적기가 없는 객체는 클래스 단위로 확정한다
+static_assert(EventConfirmer::UNTRACKED == UNTRACKED_OBJECT_ID, "untracked object id mismatch");
+
+namespace {
+    // GST_CLOCK_TIME_NONE (CPU 대체 빌드에는 GStreamer 헤더가 없다)
+    const uint64_t INVALID_PTS = UINT64_MAX;
+    
+    // PTS 기준 벽시계와 실제 벽시계의 차이를 PTS 1초마다 확인하고, 1초 넘게 벌어지면 기준을 다시 잡는다
+    // (RTC 없는 보드에서 NTP가 나중에 시계를 맞추거나 시계가 점프한 경우)
+    const uint64_t CLOCK_CHECK_INTERVAL_NS = 1000000000ULL;
+    const int64_t MAX_CLOCK_DRIFT_NS = 1000000000LL;
+    
+    int64_t wallClockNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+}
 
 Detector::Detector(CameraType cameraType)
     : cameraType_(cameraType)
     , enabled_(true)
-    , interval_(0) {
+    , interval_(0)
+    , minPeriodNs_(0)
+    , ptzPreset_(-1)
+    , sampled_(false)
+    , lastProcessedFrame_(0)
+    , lastProcessedNs_(0)
+    , ptsAnchored_(false)
+    , lastPts_(0)
+    , ptsOffsetNs_(0)
+    , lastClockCheckPts_(0) {
+    
+    MetricsRegistry& registry = MetricsRegistry::getInstance();
+    MetricLabels labels = {{"camera", (cameraType == CameraType::RGB) ? "RGB_Camera" : "Thermal_Camera"}};
+    framesCounter_ = &registry.counter("detection_frames_total",
+        "Frames whose inference metadata was processed", labels);
+    objectsCounter_ = &registry.counter("detection_objects_total",
+        "Detected objects above the confidence threshold", labels);
+    eventsCounter_ = &registry.counter("detection_events_total",
+        "Temporally confirmed detection events", labels);
+    
+    events_.reserve(EventConfirmer::MAX_TRACKS);
     
     LOG_INFO("Detector created for %s camera",
              (cameraType == CameraType::RGB) ? "RGB" : "THERMAL");
@@ -37,17 +74,33 @@ void Detector::setDetectionCallback(DetectionCallback callback) {
     callback_ = callback;
 }
 
+void Detector::setEventCallback(EventCallback callback) {
+    eventCallback_ = callback;
+}
+
 void Detector::processBatchMeta(NvDsBatchMeta* batchMeta, uint32_t frameNumber) {
-    if (!enabled_ || !batchMeta || !callback_) {
+    if (!enabled_.load(std::memory_order_relaxed) || !batchMeta || !callback_) {
         return;
     }
     
-    // 인터벌 체크
-    static uint32_t lastProcessedFrame = 0;
-    if (interval_ > 0 && (frameNumber - lastProcessedFrame) < static_cast<uint32_t>(interval_)) {
+    // 인터벌/처리율 체크
+    if (!shouldSample(frameNumber)) {
         return;
     }
-    lastProcessedFrame = frameNumber;
+    
+    // 규칙 표와 확인 플래그는 배치마다 한 번만 읽는다 (규칙 교체는 다음 배치부터 적용)
+    const DetectionRules& rules = DetectionRuleStore::getInstance().current();
+    const DeviceSetting::Settings& settings = DeviceSetting::getInstance().get();
+    uint32_t confirmFlags = (settings.resnet50Apply ? DetectionRules::CONFIRM_RESNET50 : 0u) |
+                            (settings.optFlowApply ? DetectionRules::CONFIRM_OPT_FLOW : 0u);
+    int ptzPreset = ptzPreset_.load(std::memory_order_relaxed);
+    
+    // 스레드마다 하나의 DetectionData를 재사용 (객체 벡터 용량이 유지되어 정상 상태에서는 할당 없음)
+    thread_local DetectionData detection;
+    
+    uint64_t frames = 0;
+    uint64_t objects = 0;
+    events_.clear();
     
     // 프레임 메타데이터 순회
     for (NvDsMetaList* l_frame = batchMeta->frame_meta_list; 
@@ -56,15 +109,10 @@ void Detector::processBatchMeta(NvDsBatchMeta* batchMeta, uint32_t frameNumber)
         NvDsFrameMeta* frameMeta = reinterpret_cast<NvDsFrameMeta*>(l_frame->data);
         if (!frameMeta) continue;
         
-        // DetectionData 생성
-        DetectionData detection;
         detection.frameNumber = frameNumber;
         detection.cameraType = cameraType_;
-        
-        // 타임스탬프 설정
-        auto now = std::chrono::system_clock::now();
-        auto duration = now.time_since_epoch();
-        detection.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        detection.timestamp = frameTimestamp(frameMeta->buf_pts);
+        detection.objects.clear();
         
         // 객체 메타데이터 처리
         for (NvDsMetaList* l_obj = frameMeta->obj_meta_list;
@@ -73,15 +121,20 @@ void Detector::processBatchMeta(NvDsBatchMeta* batchMeta, uint32_t frameNumber)
             NvDsObjectMeta* objMeta = reinterpret_cast<NvDsObjectMeta*>(l_obj->data);
             if (!objMeta) continue;
             
-            // 검출된 객체를 DetectedObject로 변환
-            DetectedObject obj = convertToDetectedObject(objMeta);
-            
-            // 필터링 (신뢰도 임계값)
-            if (obj.confidence > 0.3) {
-                detection.objects.push_back(obj);
-            }
+            detection.objects.emplace_back();
+            convertToDetectedObject(objMeta, detection.objects.back());
         }
         
+        // 필터링 (클래스별 신뢰도/ROI, 프리셋 마스크) 및 색상 결정
+        detection.objects.resize(rules.apply(cameraType_, ptzPreset, confirmFlags,
+                                             detection.objects.data(), detection.objects.size()));
+        
+        frames++;
+        objects += detection.objects.size();
+        
+        // 시간 확정 (객체가 없는 프레임도 창을 흘려보내야 하므로 항상 호출)
+        confirmer_.update(rules, confirmFlags, detection, events_);
+        
         // 콜백 호출
         if (!detection.objects.empty()) {
             callback_(detection);
@@ -90,85 +143,111 @@ void Detector::processBatchMeta(NvDsBatchMeta* batchMeta, uint32_t frameNumber)
                       frameNumber, detection.objects.size());
         }
     }
+    
+    // 이벤트는 검출 데이터를 모두 넘긴 뒤 배치 단위로 알린다
+    if (eventCallback_) {
+        for (const DetectionEvent& event : events_) {
+            eventCallback_(event);
+        }
+    }
+    
+    framesCounter_->inc(frames);
+    objectsCounter_->inc(objects);
+    if (!events_.empty()) {
+        eventsCounter_->inc(events_.size());
+    }
+}
+
+uint64_t Detector::frameTimestamp(uint64_t pts) {
+    if (pts == INVALID_PTS) {
+        return wallClockNs();
+    }
+    
+    if (!ptsAnchored_ || pts < lastPts_) {
+        ptsOffsetNs_ = wallClockNs() - static_cast<int64_t>(pts);
+        ptsAnchored_ = true;
+        lastClockCheckPts_ = pts;
+    } else if (pts - lastClockCheckPts_ >= CLOCK_CHECK_INTERVAL_NS) {
+        lastClockCheckPts_ = pts;
+        int64_t wallNs = wallClockNs();
+        int64_t drift = wallNs - (ptsOffsetNs_ + static_cast<int64_t>(pts));
+        if (drift > MAX_CLOCK_DRIFT_NS || drift < -MAX_CLOCK_DRIFT_NS) {
+            ptsOffsetNs_ = wallNs - static_cast<int64_t>(pts);
+            LOG_WARN("Detector wall clock re-anchored (drift %.3f s)", drift / 1e9);
+        }
+    }
+    lastPts_ = pts;
+    return static_cast<uint64_t>(ptsOffsetNs_ + static_cast<int64_t>(pts));
+}
+
+bool Detector::shouldSample(uint32_t frameNumber) {
+    int interval = interval_.load(std::memory_order_relaxed);
+    int64_t minPeriodNs = minPeriodNs_.load(std::memory_order_relaxed);
+    
+    int64_t nowNs = 0;
+    if (minPeriodNs > 0) {
+        nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+    // 첫 배치는 항상 처리 (이전 프레임 번호가 없으므로)
+    if (sampled_.load(std::memory_order_relaxed)) {
+        // 부호 없는 뺄셈이라 프레임 번호가 되감겨도 (파이프라인 재시작) 큰 값이 되어 바로 처리된다
+        if (interval > 0 &&
+            frameNumber - lastProcessedFrame_.load(std::memory_order_relaxed) < static_cast<uint32_t>(interval)) {
+            return false;
+        }
+        
+        if (minPeriodNs > 0) {
+            // 같은 배치를 두 스레드가 동시에 처리하지 않도록 시각은 CAS로 차지한다
+            int64_t last = lastProcessedNs_.load(std::memory_order_relaxed);
+            if (nowNs - last < minPeriodNs ||
+                !lastProcessedNs_.compare_exchange_strong(last, nowNs, std::memory_order_relaxed)) {
+                return false;
+            }
+        }
+    } else {
+        lastProcessedNs_.store(nowNs, std::memory_order_relaxed);
+        sampled_.store(true, std::memory_order_relaxed);
+    }
+    
+    lastProcessedFrame_.store(frameNumber, std::memory_order_relaxed);
+    return true;
 }
 
 void Detector::setEnabled(bool enabled) {
-    enabled_ = enabled;
+    enabled_.store(enabled, std::memory_order_relaxed);
     LOG_INFO("Detector %s", enabled ? "enabled" : "disabled");
 }
 
 bool Detector::isEnabled() const {
-    return enabled_;
+    return enabled_.load(std::memory_order_relaxed);
 }
 
 void Detector::setInterval(int interval) {
-    interval_ = interval;
+    interval_.store(interval, std::memory_order_relaxed);
     LOG_INFO("Detector interval set to: %d", interval);
 }
 
-DetectedObject Detector::convertToDetectedObject(NvDsObjectMeta* objMeta) {
-    DetectedObject obj;
-    
+void Detector::setMaxRate(double perSecond) {
+    int64_t periodNs = (perSecond > 0.0) ? static_cast<int64_t>(1e9 / perSecond) : 0;
+    minPeriodNs_.store(periodNs, std::memory_order_relaxed);
+    LOG_INFO("Detector max rate set to: %.2f/s", perSecond);
+}
+
+void Detector::setPtzPreset(int preset) {
+    ptzPreset_.store(preset, std::memory_order_relaxed);
+    LOG_DEBUG("Detector PTZ preset set to: %d", preset);
+}
+
+void Detector::convertToDetectedObject(const NvDsObjectMeta* objMeta, DetectedObject& obj) const {
     obj.classId = objMeta->class_id;
     obj.confidence = objMeta->confidence;
+    obj.trackId = objMeta->object_id;
     
     // 바운딩 박스
     obj.bbox.x = static_cast<int>(objMeta->rect_params.left);
     obj.bbox.y = static_cast<int>(objMeta->rect_params.top);
     obj.bbox.width = static_cast<int>(objMeta->rect_params.width);
     obj.bbox.height = static_cast<int>(objMeta->rect_params.height);
-    
-    // 색상 결정
-    obj.color = determineColor(obj.classId, obj);
-    obj.hasBbox = (obj.color != BboxColor::NONE);
-    
-    return obj;
 }
-
-BboxColor Detector::determineColor(int classId, const DetectedObject& obj) {
-    // PTZ 이동 중이면 박스 없음
-    // TODO: g_move_speed 체크 (전역 변수 대신 상태 관리 필요)
-    
-    // 너무 작거나 큰 객체 필터링
-    float diagonal = std::sqrt(obj.bbox.width * obj.bbox.width + 
-                              obj.bbox.height * obj.bbox.height);
-    
-    float minDiag = (cameraType_ == CameraType::RGB) ? 40.0f : 40.0f;
-    float maxDiag = (cameraType_ == CameraType::RGB) ? 1000.0f : 1000.0f;
-    
-    if (diagonal < minDiag || diagonal > maxDiag) {
-        return BboxColor::NONE;
-    }
-    
-    // 클래스별 색상 결정
-    switch (classId) {
-        case CLASS_NORMAL_COW:
-        case CLASS_NORMAL_COW_SITTING:
-            return BboxColor::GREEN;
-            
-        case CLASS_HEAT_COW:
-            // ResNet50 적용 체크
-            if (DeviceSetting::getInstance().get().resnet50Apply) {
-                // TODO: heat_count는 별도 추적 필요
-                return BboxColor::RED;
-            }
-            return BboxColor::YELLOW;
-            
-        case CLASS_FLIP_COW:
-            // Optical Flow 적용 체크
-            if (DeviceSetting::getInstance().get().optFlowApply) {
-                // TODO: opt_flow_detected_count는 별도 추적 필요
-                return BboxColor::RED;
-            }
-            return BboxColor::YELLOW;
-            
-        case CLASS_LABOR_SIGN_COW:
-            return BboxColor::RED;
-            
-        case CLASS_OVER_TEMP:
-            return BboxColor::BLUE;
-            
-        default:
-            return BboxColor::GREEN;
-    }
-}
\ No newline at end of file
@@ -1,42 +1,88 @@
 #ifndef DETECTOR_H
 #define DETECTOR_H
 
+#include <atomic>
 #include <memory>
 #include <functional>
-#include <gst/gst.h>
 #include <iostream>
-#include <nvdsmeta.h>
+#include <vector>
 
 #include "../common/Types.h"
+#include "DeepStreamMeta.h"
+#include "EventConfirmer.h"
+
+class Counter;
 
 class Detector {
 public:
     using DetectionCallback = std::function<void(const DetectionData&)>;
+    using EventCallback = std::function<void(const DetectionEvent&)>;
     
     Detector(CameraType cameraType);
     ~Detector();
     
     bool init(const std::string& configFile);
     void setDetectionCallback(DetectionCallback callback);
+    // 시간 확정 이벤트 (규칙의 "event" 조건, 트랙/클래스마다 한 번). 검출 콜백과 같은 스레드에서 호출된다
+    void setEventCallback(EventCallback callback);
     
     // DeepStream 메타데이터 처리
+    // 프레임마다 스레드 로컬 DetectionData를 재사용해 콜백에 넘긴다 (콜백 밖으로 참조를 보관하지 말 것)
     void processBatchMeta(NvDsBatchMeta* batchMeta, uint32_t frameNumber);
     
-    // 설정
+    // 설정 (다른 스레드에서 호출해도 된다)
     void setEnabled(bool enabled);
     bool isEnabled() const;
+    // 프레임 간격: 마지막 처리 프레임에서 interval 프레임이 지나기 전의 배치는 건너뜀 (0이면 매 프레임)
     void setInterval(int interval);
+    // 시간 기준 상한: 초당 처리 배치 수 (0이면 제한 없음). 프레임 간격과 함께 적용된다
+    void setMaxRate(double perSecond);
+    // 현재 PTZ 프리셋 (-1: 수동 조작/알 수 없음). 프리셋별 ROI 마스크 선택에 쓴다
+    void setPtzPreset(int preset);
     
 private:
-    DetectedObject convertToDetectedObject(NvDsObjectMeta* objMeta);
-    BboxColor determineColor(int classId, const DetectedObject& obj);
+    // 이 배치를 처리할지 결정하고, 처리한다면 마지막 처리 프레임/시각을 갱신한다
+    bool shouldSample(uint32_t frameNumber);
+    
+    // 버퍼 PTS를 벽시계 나노초로 변환 (첫 프레임에서 기준을 잡고, PTS가 되감기거나
+    // 벽시계가 1초 넘게 벗어나면 다시 잡는다. 벽시계 확인은 PTS 1초마다 한 번)
+    // 뒤로 다시 잡힌 타임스탬프는 DetectionBuffer가 CLOCK_STEP_NS 기준으로 받아 이전 프레임을 퇴역시킨다
+    uint64_t frameTimestamp(uint64_t pts);
+    
+    // 메타데이터 필드만 옮긴다 (필터와 색상은 DetectionRules가 프레임 단위로 결정)
+    void convertToDetectedObject(const NvDsObjectMeta* objMeta, DetectedObject& obj) const;
     
 private:
     CameraType cameraType_;
     DetectionCallback callback_;
-    bool enabled_;
-    int interval_;
+    EventCallback eventCallback_;
     std::string configFile_;
+    
+    // 샘플링 설정 (명령 파이프 스레드에서 갱신)
+    std::atomic<bool> enabled_;
+    std::atomic<int> interval_;
+    std::atomic<int64_t> minPeriodNs_;
+    std::atomic<int> ptzPreset_;
+    
+    // 샘플링 상태 (검출기 인스턴스별)
+    std::atomic<bool> sampled_;
+    std::atomic<uint32_t> lastProcessedFrame_;
+    std::atomic<int64_t> lastProcessedNs_;
+    
+    // PTS → 벽시계 변환 기준 (스트리밍 스레드에서만 접근)
+    bool ptsAnchored_;
+    uint64_t lastPts_;
+    int64_t ptsOffsetNs_;
+    uint64_t lastClockCheckPts_;
+    
+    // 이벤트 확정 상태 (스트리밍 스레드에서만 접근, 이벤트 벡터는 용량을 유지해 재사용)
+    EventConfirmer confirmer_;
+    std::vector<DetectionEvent> events_;
+    
+    // 지표 (처리한 프레임, 임계값을 넘은 객체, 확정 이벤트)
+    Counter* framesCounter_;
+    Counter* objectsCounter_;
+    Counter* eventsCounter_;
 };
 
 #endif // DETECTOR_H
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "EventConfirmer.h"
+#include "DetectionRules.h"
+
+EventConfirmer::EventConfirmer() {
+    reset();
+}
+
+void EventConfirmer::reset() {
+    for (Slot& slot : slots_) {
+        slot.trackId = UNTRACKED;
+        slot.classId = -1;
+        slot.armed = true;
+        slot.bits = 0;
+        slot.lastFrame = 0;
+        slot.nextEventNs = 0;
+    }
+    frame_ = 0;
+}
+
+size_t EventConfirmer::update(const DetectionRules& rules, uint32_t confirmFlags,
+                              const DetectionData& detection, std::vector<DetectionEvent>& events) {
+    frame_++;
+    size_t emitted = 0;
+
+    for (const DetectedObject& obj : detection.objects) {
+        // 크기 범위 밖이라 박스가 없는 객체는 증거로 세지 않는다 (예전의 color == RED 조건)
+        if (!obj.hasBbox) {
+            continue;
+        }
+        const DetectionRules::EventRule& rule = rules.event(obj.classId);
+        if (rule.window == 0 || (rule.confirmFlags != 0 && (rule.confirmFlags & confirmFlags) == 0)) {
+            continue;
+        }
+
+        Slot* found = acquire(obj.trackId, obj.classId, detection.timestamp);
+        if (!found) {
+            continue;
+        }
+        Slot& slot = *found;
+        uint64_t gap = frame_ - slot.lastFrame;
+        if (gap == 0) {
+            // 같은 프레임에서 이미 셌다 (추적기 없이 같은 클래스 객체가 여럿)
+            continue;
+        }
+
+        // 보이지 않은 프레임만큼 0을 밀어 넣는다. 비트 0은 이번 프레임
+        slot.bits = (gap >= static_cast<uint64_t>(DetectionRules::MAX_EVENT_WINDOW)) ? 0 : (slot.bits << gap);
+        slot.lastFrame = frame_;
+
+        uint64_t windowMask = (rule.window >= DetectionRules::MAX_EVENT_WINDOW)
+                                  ? ~uint64_t(0) : ((uint64_t(1) << rule.window) - 1);
+        int before = __builtin_popcountll(slot.bits & windowMask);
+        if (!slot.armed && before <= rule.release) {
+            slot.armed = true;
+        }
+        slot.bits |= 1;
+        int hits = before + 1;
+
+        if (slot.armed && hits >= rule.hits && detection.timestamp >= slot.nextEventNs) {
+            slot.armed = false;
+            slot.nextEventNs = detection.timestamp + rule.cooldownNs;
+
+            DetectionEvent event;
+            event.cameraType = detection.cameraType;
+            event.classId = obj.classId;
+            event.trackId = obj.trackId;
+            event.frameNumber = detection.frameNumber;
+            event.timestamp = detection.timestamp;
+            event.bbox = obj.bbox;
+            event.confidence = obj.confidence;
+            event.hits = hits;
+            event.window = rule.window;
+            events.push_back(event);
+            emitted++;
+        }
+    }
+    return emitted;
+}
+
+EventConfirmer::Slot* EventConfirmer::acquire(uint64_t trackId, int classId, uint64_t now) {
+    Slot* empty = nullptr;
+    Slot* oldest = nullptr;
+
+    for (Slot& slot : slots_) {
+        if (slot.classId == classId && slot.trackId == trackId) {
+            return &slot;
+        }
+        if (slot.classId < 0) {
+            if (!empty) {
+                empty = &slot;
+            }
+        } else if (now >= slot.nextEventNs && (!oldest || slot.lastFrame < oldest->lastFrame)) {
+            // 쿨다운 중인 슬롯은 창이 비었어도 남겨 둔다
+            oldest = &slot;
+        }
+    }
+
+    Slot* slot = empty ? empty : oldest;
+    if (!slot) {
+        return nullptr;
+    }
+    slot->trackId = trackId;
+    slot->classId = classId;
+    slot->armed = true;
+    slot->bits = 0;
+    slot->lastFrame = 0;
+    slot->nextEventNs = 0;
+    return slot;
+}
+
+int EventConfirmer::activeTracks() const {
+    int count = 0;
+    for (const Slot& slot : slots_) {
+        if (slot.classId >= 0 && frame_ - slot.lastFrame < static_cast<uint64_t>(DetectionRules::MAX_EVENT_WINDOW)) {
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,69 @@
+#ifndef EVENT_CONFIRMER_H
+#define EVENT_CONFIRMER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../common/Types.h"
+
+class DetectionRules;
+
+// 시간 확정된 검출 이벤트 (분만 징후, 전도, 발정 등)
+struct DetectionEvent {
+    CameraType cameraType;
+    int classId;
+    uint64_t trackId;      // EventConfirmer::UNTRACKED면 카메라 단위로 모은 클래스 이벤트
+    uint32_t frameNumber;
+    uint64_t timestamp;    // 확정된 프레임의 시각 (벽시계 나노초)
+    BoundingBox bbox;      // 확정된 프레임의 박스
+    float confidence;
+    int hits;              // 창 안에서 보인 프레임 수
+    int window;
+};
+
+// 트랙 × 클래스별 슬라이딩 윈도우 확정기
+// 프레임마다 울리던 경보 대신, 최근 window 처리 프레임 중 hits 프레임 이상 보인 트랙에서 이벤트를 한 번만 낸다.
+// - 창은 64비트 시프트 레지스터 (비트 0이 최근 프레임). 보이지 않은 프레임만큼 한 번에 밀어 넣는다
+// - 이벤트를 낸 트랙은 창의 개수가 release 이하로 떨어져야 다시 무장되고, cooldown 안에는 다시 내지 않는다
+// - 추적기가 없으면 (trackId == UNTRACKED) 같은 클래스의 객체를 하나의 트랙으로 본다
+// - 박스가 없는 객체(hasBbox == false, 대각선 범위 밖)는 증거가 아니다
+// 슬롯 수가 고정이라 메모리와 이벤트 수가 트랙 수에 비례해 제한된다.
+// 쿨다운 중인 슬롯은 재사용하지 않는다 (잠깐 사라졌다 돌아온 트랙이 쿨다운을 잃고 다시 울리지 않도록).
+// 모든 슬롯이 쿨다운 중이면 새 트랙은 쿨다운이 끝날 때까지 세지 않는다
+// 검출기의 스트리밍 스레드에서만 사용한다 (잠금 없음)
+class EventConfirmer {
+public:
+    static constexpr int MAX_TRACKS = 64;
+    static constexpr uint64_t UNTRACKED = UINT64_MAX;
+
+    EventConfirmer();
+
+    // 처리한 프레임 하나를 반영한다 (객체가 없는 프레임도 호출해야 창이 흐른다).
+    // 확정된 이벤트를 events 뒤에 붙이고, 붙인 개수를 반환한다
+    size_t update(const DetectionRules& rules, uint32_t confirmFlags,
+                  const DetectionData& detection, std::vector<DetectionEvent>& events);
+
+    void reset();
+
+    int activeTracks() const;
+
+private:
+    struct Slot {
+        uint64_t trackId;
+        int classId;           // -1이면 빈 슬롯
+        bool armed;
+        uint64_t bits;         // 최근 프레임 관측 비트
+        uint64_t lastFrame;    // bits를 마지막으로 민 처리 프레임 번호
+        uint64_t nextEventNs;  // 쿨다운이 끝나는 시각
+    };
+
+    // 트랙의 슬롯을 찾거나 새로 잡는다.
+    // 빈 슬롯을 먼저 쓰고, 없으면 쿨다운이 끝난 슬롯 중 가장 오래 보이지 않은 것을 재사용한다 (없으면 nullptr)
+    Slot* acquire(uint64_t trackId, int classId, uint64_t now);
+
+    Slot slots_[MAX_TRACKS];
+    uint64_t frame_;           // 처리한 프레임 수 (검출기 프레임 번호와 무관하게 단조 증가)
+};
+
+#endif // EVENT_CONFIRMER_H
@@ -0,0 +1,105 @@
+#include "RoiMask.h"
+#include "../utils/Logger.h"
+
+RoiMask::RoiMask()
+    : cols_(0)
+    , rows_(0)
+    , wordsPerRow_(0)
+    , invCellSize_(0.0f)
+    , mode_(Mode::CENTER)
+    , minOverlap_(0.0f) {}
+
+bool RoiMask::build(int frameWidth, int frameHeight, int cellSize,
+                    const std::vector<Polygon>& include, const std::vector<Polygon>& exclude,
+                    Mode mode, float minOverlap) {
+    if (frameWidth <= 0 || frameHeight <= 0 || cellSize <= 0) {
+        LOG_ERROR("Invalid ROI mask geometry: %dx%d, cell %d", frameWidth, frameHeight, cellSize);
+        return false;
+    }
+    for (const Polygon& polygon : include) {
+        if (polygon.size() < 3) {
+            LOG_ERROR("ROI polygon needs at least 3 points (got %zu)", polygon.size());
+            return false;
+        }
+    }
+    for (const Polygon& polygon : exclude) {
+        if (polygon.size() < 3) {
+            LOG_ERROR("ROI polygon needs at least 3 points (got %zu)", polygon.size());
+            return false;
+        }
+    }
+
+    cols_ = (frameWidth + cellSize - 1) / cellSize;
+    rows_ = (frameHeight + cellSize - 1) / cellSize;
+    wordsPerRow_ = (cols_ + 63) / 64;
+    invCellSize_ = 1.0f / cellSize;
+    mode_ = mode;
+    minOverlap_ = minOverlap;
+    bits_.assign(static_cast<size_t>(rows_) * wordsPerRow_, 0);
+    integral_.assign(static_cast<size_t>(rows_ + 1) * (cols_ + 1), 0);
+
+    // 셀 중심으로 판정 (설정 시 한 번만 하므로 단순한 짝홀 규칙으로 충분)
+    for (int row = 0; row < rows_; row++) {
+        float y = (row + 0.5f) * cellSize;
+        for (int col = 0; col < cols_; col++) {
+            float x = (col + 0.5f) * cellSize;
+
+            bool allowed = include.empty();
+            for (const Polygon& polygon : include) {
+                if (insidePolygon(polygon, x, y)) {
+                    allowed = true;
+                    break;
+                }
+            }
+            for (const Polygon& polygon : exclude) {
+                if (allowed && insidePolygon(polygon, x, y)) {
+                    allowed = false;
+                }
+            }
+
+            if (allowed) {
+                bits_[row * wordsPerRow_ + (col >> 6)] |= uint64_t(1) << (col & 63);
+            }
+            integral_[(row + 1) * (cols_ + 1) + col + 1] =
+                (allowed ? 1u : 0u) +
+                integral_[row * (cols_ + 1) + col + 1] +
+                integral_[(row + 1) * (cols_ + 1) + col] -
+                integral_[row * (cols_ + 1) + col];
+        }
+    }
+    return true;
+}
+
+float RoiMask::overlap(const BoundingBox& bbox) const {
+    if (cols_ == 0) {
+        return 1.0f;
+    }
+    int col0 = cellColumn(static_cast<float>(bbox.x));
+    int row0 = cellRow(static_cast<float>(bbox.y));
+    int col1 = cellColumn(static_cast<float>(bbox.x + bbox.width - 1)) + 1;
+    int row1 = cellRow(static_cast<float>(bbox.y + bbox.height - 1)) + 1;
+    if (col1 <= col0 || row1 <= row0) {
+        return containsCenter(bbox) ? 1.0f : 0.0f;
+    }
+
+    int stride = cols_ + 1;
+    uint32_t allowed = integral_[row1 * stride + col1] - integral_[row0 * stride + col1] -
+                       integral_[row1 * stride + col0] + integral_[row0 * stride + col0];
+    return static_cast<float>(allowed) / ((col1 - col0) * (row1 - row0));
+}
+
+int RoiMask::allowedCells() const {
+    return cols_ ? static_cast<int>(integral_.back()) : 0;
+}
+
+bool RoiMask::insidePolygon(const Polygon& polygon, float x, float y) {
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const Point& a = polygon[i];
+        const Point& b = polygon[j];
+        if (((a.y > y) != (b.y > y)) && (x < (b.x - a.x) * (y - a.y) / (b.y - a.y) + a.x)) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
@@ -0,0 +1,84 @@
+#ifndef ROI_MASK_H
+#define ROI_MASK_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../common/Types.h"
+
+// 관심 영역 / 축사 마스크 비트맵
+// 다각형(포함/제외)을 한 번 격자 셀 단위로 래스터화해 두고, 바운딩 박스는 표 조회로 판정한다.
+// - 셀 중심이 포함 다각형 안(포함 다각형이 없으면 화면 전체)이고 어떤 제외 다각형에도 없으면 허용 셀
+// - CENTER: 박스 중심이 있는 셀 하나의 비트
+// - OVERLAP: 박스가 덮는 셀 중 허용 셀 비율 (적분표로 네 번 조회) ≥ minOverlap
+// 좌표는 검출기가 보는 프레임(추론 해상도)의 픽셀. 프레임 밖 좌표는 가장자리 셀로 붙인다
+class RoiMask {
+public:
+    struct Point {
+        float x;
+        float y;
+    };
+    using Polygon = std::vector<Point>;
+
+    enum class Mode {
+        CENTER,
+        OVERLAP
+    };
+
+    // 빈 마스크는 모든 박스를 허용한다
+    RoiMask();
+
+    bool build(int frameWidth, int frameHeight, int cellSize,
+               const std::vector<Polygon>& include, const std::vector<Polygon>& exclude,
+               Mode mode = Mode::CENTER, float minOverlap = 0.5f);
+
+    bool empty() const { return cols_ == 0; }
+
+    bool accepts(const BoundingBox& bbox) const {
+        if (cols_ == 0) {
+            return true;
+        }
+        if (mode_ == Mode::CENTER) {
+            return containsCenter(bbox);
+        }
+        return overlap(bbox) >= minOverlap_;
+    }
+
+    bool containsCenter(const BoundingBox& bbox) const {
+        int col = cellColumn(bbox.x + bbox.width * 0.5f);
+        int row = cellRow(bbox.y + bbox.height * 0.5f);
+        return (bits_[row * wordsPerRow_ + (col >> 6)] >> (col & 63)) & 1u;
+    }
+
+    // 박스가 덮는 셀 중 허용 셀 비율 (0..1)
+    float overlap(const BoundingBox& bbox) const;
+
+    int columns() const { return cols_; }
+    int rows() const { return rows_; }
+    int allowedCells() const;
+
+private:
+    int cellColumn(float x) const {
+        int col = static_cast<int>(x * invCellSize_);
+        return col < 0 ? 0 : (col >= cols_ ? cols_ - 1 : col);
+    }
+
+    int cellRow(float y) const {
+        int row = static_cast<int>(y * invCellSize_);
+        return row < 0 ? 0 : (row >= rows_ ? rows_ - 1 : row);
+    }
+
+    static bool insidePolygon(const Polygon& polygon, float x, float y);
+
+    int cols_;
+    int rows_;
+    int wordsPerRow_;
+    float invCellSize_;
+    Mode mode_;
+    float minOverlap_;
+
+    std::vector<uint64_t> bits_;       // 행마다 wordsPerRow_ 워드, 1 = 허용 셀
+    std::vector<uint32_t> integral_;   // (rows_ + 1) × (cols_ + 1) 허용 셀 누적 합
+};
+
+#endif // ROI_MASK_H
@@ -26,6 +26,9 @@
 // API
 #include "api/ApiServer.h"
 
+// Detection
+#include "detection/DetectionRules.h"
+
 // Signaling & WebRTC
 #include "signaling/SignalingClient.h"
 #include "webrtc/PeerManager.h"
@@ -166,6 +169,36 @@ static void cleanup() {
     LOG_INFO("Cleanup completed");
 }
 
+// 분석 설정을 실행 중인 검출기에 반영 (커맨드 파이프 스레드)
+static void applyAnalysisSettings(const DeviceSetting::Settings& settings) {
+    if (!g_pipeline) {
+        return;
+    }
+    for (int i = 0; i < g_pipeline->getCameraCount(); i++) {
+        CameraSource* camera = g_pipeline->getCamera(i);
+        Detector* detector = camera ? camera->getDetector() : nullptr;
+        if (detector) {
+            detector->setEnabled(settings.analysisStatus);
+            detector->setInterval(settings.nvInterval);
+            detector->setMaxRate(settings.nvMaxRate);
+        }
+    }
+}
+
+// PTZ 프리셋 변경을 검출기에 반영 (프리셋별 ROI 마스크 선택)
+static void applyPtzPreset(int preset) {
+    if (!g_pipeline) {
+        return;
+    }
+    for (int i = 0; i < g_pipeline->getCameraCount(); i++) {
+        CameraSource* camera = g_pipeline->getCamera(i);
+        Detector* detector = camera ? camera->getDetector() : nullptr;
+        if (detector) {
+            detector->setPtzPreset(preset);
+        }
+    }
+}
+
 // 커맨드 파이프 핸들러
 static void handlePipeCommand(const std::string& command) {
     LOG_INFO("Received pipe command: %s", command.c_str());
@@ -201,10 +234,17 @@ static void handlePipeCommand(const std::string& command) {
         auto& settings = DeviceSetting::getInstance().getMutable();
         settings.analysisStatus = 1;
         settings.nvInterval = 0;
+        applyAnalysisSettings(settings);
     } else if (command == "analysis_off") {
         auto& settings = DeviceSetting::getInstance().getMutable();
         settings.analysisStatus = 0;
         settings.nvInterval = INT32_MAX;
+        applyAnalysisSettings(settings);
+    }
+    
+    // 검출 규칙 다시 읽기 (파이프라인은 다음 배치부터 새 규칙 사용)
+    else if (command == "rules_reload") {
+        DetectionRuleStore::getInstance().reload();
     }
 }
 
@@ -337,10 +377,34 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         
+        // 로그 큐가 가득 찼을 때의 정책
+        Logger::getInstance().setOverflowPolicy(
+            g_config->getLogOverflowPolicy() == "block" ? LogOverflowPolicy::BLOCK
+                                                        : LogOverflowPolicy::DROP);
+        
+        // 로그 회전/보관 정책
+        Logger::getInstance().setRotationPolicy(g_config->getLogRotationPolicy());
+        
+        // 호출 위치별 속도 제한 (장애 시 같은 로그가 초당 수천 번 찍히는 것 방지)
+        int logRateLimit = g_config->getLogRateLimit();
+        Logger::getInstance().setRateLimit(logRateLimit > 0 ? static_cast<uint32_t>(logRateLimit) : 0);
+        
+        // 바이너리 로그 모드 (logdecode로 텍스트 변환)
+        if (g_config->getLogFormat() == "binary") {
+            LOG_INFO("Switching to binary log format");
+            Logger::getInstance().setBinaryMode(true);
+        }
+        
         // 디바이스 설정 로드
         std::string deviceSettingPath = "device_setting.json";
         DeviceSetting::getInstance().load(deviceSettingPath);
         
+        // 검출 규칙 로드 (실패하면 내장 기본 규칙 유지)
+        std::string rulesPath = g_config->getDetectionRulesPath();
+        if (!rulesPath.empty()) {
+            DetectionRuleStore::getInstance().load(rulesPath);
+        }
+        
         // 커맨드 파이프 생성
         g_commandPipe = std::make_unique<CommandPipe>(pipePathStr);
         g_commandPipe->setCommandCallback(handlePipeCommand);
@@ -354,6 +418,7 @@ int main(int argc, char* argv[]) {
         
         if (!serialDevice.empty()) {
             g_ptzController = std::make_unique<PTZController>();
+            g_ptzController->setPresetCallback(applyPtzPreset);
             if (!g_ptzController->init(serialDevice, serialBaudrate)) {
                 LOG_WARN("PTZ controller initialization failed");
                 g_ptzController.reset();
@@ -368,7 +433,10 @@ int main(int argc, char* argv[]) {
         }
         
         // API 서버 시작
-        g_apiServer = std::make_unique<ApiServer>(g_config->getApiPort());
+        g_apiServer = std::make_unique<ApiServer>(g_config->getApiPort(),
+                                                  g_config->getApiWorkerThreads(),
+                                                  g_config->getApiMaxConnections(),
+                                                  g_config->getApiKeepAliveTimeoutMs());
         
         // 카메라별 검출 버퍼 등록
         for (int i = 0; i < g_config->getDeviceCount(); i++) {
@@ -377,6 +445,7 @@ int main(int argc, char* argv[]) {
             if (cameraSource) {
                 g_apiServer->registerDetectionBuffer(camConfig.type, 
                                                    cameraSource->getDetectionBuffer());
+                g_apiServer->registerLatencyTrace(camConfig.type, cameraSource->getLatencyTrace());
             }
         }
         
@@ -1,14 +1,17 @@
 #include "CameraSource.h"
+#include "ElementFactory.h"
+#include "LatencyProbe.h"
+#include "LatencyTrace.h"
+#include "PipelineMonitor.h"
 #include "../detection/DetectionBuffer.h"
 #include "../utils/Logger.h"
 #include "../utils/DeviceSetting.h"
 #include <gst/gst.h>
 #include <gst/rtp/gstrtpbuffer.h>
 #include <gst/rtp/rtp.h>
-#include <nvdsmeta.h>
 #include <cmath>
 #include <fstream>
-#include <map>
+#include <atomic>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -23,6 +26,11 @@ CameraSource::CameraSource(CameraType type, int index)
     // 검출 버퍼 생성
     detectionBuffer_ = std::make_unique<DetectionBuffer>(type);
     
+    // 지연 추적 (API의 카메라 이름 사용)
+    latencyTrace_ = std::make_unique<LatencyTrace>(
+        (type == CameraType::RGB) ? "RGB_Camera" : "Thermal_Camera");
+    monitor_ = std::make_unique<PipelineMonitor>(latencyTrace_->getName());
+    
     LOG_INFO("CameraSource created: %s camera (index=%d)",
              (type == CameraType::RGB) ? "RGB" : "THERMAL", index);
 }
@@ -80,15 +88,18 @@ bool CameraSource::init(const CameraConfig& config, GstElement* pipeline) {
         // 검출 콜백 설정 - DetectionBuffer에 저장
         detector_->setDetectionCallback([this](const DetectionData& detection) {
             detectionBuffer_->addDetection(detection);
-            
-            // 이벤트 발생 시 추가 처리
-            handleDetectionEvent(detection);
+        });
+        
+        // 시간 확정 이벤트 (트랙/클래스마다 한 번, 규칙 파일의 "event" 조건)
+        detector_->setEventCallback([this](const DetectionEvent& event) {
+            handleDetectionEvent(event);
         });
         
         // 설정 적용
         auto& settings = DeviceSetting::getInstance().get();
         detector_->setEnabled(settings.analysisStatus);
         detector_->setInterval(settings.nvInterval);
+        detector_->setMaxRate(settings.nvMaxRate);
     }
 
     LOG_INFO("CameraSource initialized: %s camera (inference=%s)",
@@ -126,21 +137,24 @@ GstPadProbeReturn CameraSource::osdSinkPadProbe(GstPad* pad, GstPadProbeInfo* in
 }
 
 bool CameraSource::createSourceChain(const CameraConfig& config) {
+    ElementFactory& factory = ElementFactory::getInstance();
     gchar elementName[64];
     
     g_snprintf(elementName, sizeof(elementName), "shmsrc_%d", index_);
-    elements_.shmsrc = gst_element_factory_make("shmsrc", elementName);
+    elements_.shmsrc = factory.make("shmsrc", elementName);
 
     const char* socket_path = (type_ == CameraType::RGB) 
         ? "/tmp/RGB_Camera.sock" 
         : "/tmp/Thermal_Camera.sock";
 
-    g_object_set(elements_.shmsrc,
-                "socket-path", socket_path,
-                "is-live", TRUE,
-                nullptr);
+    if (!ElementFactory::isSubstitute(elements_.shmsrc)) {
+        g_object_set(elements_.shmsrc,
+                    "socket-path", socket_path,
+                    "is-live", TRUE,
+                    nullptr);
+    }
     
-    elements_.shm_capsfilter = gst_element_factory_make("capsfilter", nullptr);
+    elements_.shm_capsfilter = factory.make("capsfilter", nullptr);
     GstCaps* shm_caps = gst_caps_new_simple("video/x-raw",
         "format", G_TYPE_STRING, "I420",
         "width", G_TYPE_INT, config.source.width,
@@ -151,20 +165,20 @@ bool CameraSource::createSourceChain(const CameraConfig& config) {
     gst_caps_unref(shm_caps);
     
     // 컨버터
-    elements_.converter1 = gst_element_factory_make("nvvideoconvert", nullptr);
+    elements_.converter1 = factory.make("nvvideoconvert", nullptr);
     
     // 클럭 오버레이
-    elements_.clockoverlay = gst_element_factory_make("clockoverlay", nullptr);
+    elements_.clockoverlay = factory.make("clockoverlay", nullptr);
     g_object_set(elements_.clockoverlay,
                  "time-format", "%D %H:%M:%S",
                  "font-desc", "Arial, 18",
                  nullptr);
     
     // 비디오 레이트
-    elements_.videorate = gst_element_factory_make("videorate", nullptr);
+    elements_.videorate = factory.make("videorate", nullptr);
     
     // Caps 필터
-    elements_.capsfilter = gst_element_factory_make("capsfilter", nullptr);
+    elements_.capsfilter = factory.make("capsfilter", nullptr);
     GstCaps* caps = gst_caps_new_simple("video/x-raw",
         "width", G_TYPE_INT, config.source.width,
         "height", G_TYPE_INT, config.source.height,
@@ -174,21 +188,23 @@ bool CameraSource::createSourceChain(const CameraConfig& config) {
     gst_caps_unref(caps);
     
     // 큐와 Tee
-    elements_.queue1 = gst_element_factory_make("queue", nullptr);
+    elements_.queue1 = factory.make("queue", nullptr);
     g_object_set(elements_.queue1,
                  "max-size-buffers", 5,
                  "leaky", 2, // downstream
                  nullptr);
     
-    elements_.tee = gst_element_factory_make("tee", nullptr);
+    elements_.tee = factory.make("tee", nullptr);
     g_object_set(elements_.tee, "allow-not-linked", TRUE, nullptr);
     
     return true;
 }
 
 bool CameraSource::createInferenceChain(const CameraConfig& config) {
+    ElementFactory& factory = ElementFactory::getInstance();
+    
     // 추론을 위한 체인
-    elements_.queue2 = gst_element_factory_make("queue", nullptr);
+    elements_.queue2 = factory.make("queue", nullptr);
     if (elements_.queue2) {
         // Queue 속성 설정 (버퍼링 문제일 수 있음)
         g_object_set(elements_.queue2,
@@ -199,8 +215,8 @@ bool CameraSource::createInferenceChain(const CameraConfig& config) {
         LOG_INFO("Queue2 생성 및 설정 완료");
     }
 
-    elements_.videoscale = gst_element_factory_make("videoscale", nullptr);
-    elements_.videoscale_capsfilter = gst_element_factory_make("capsfilter", nullptr);
+    elements_.videoscale = factory.make("videoscale", nullptr);
+    elements_.videoscale_capsfilter = factory.make("capsfilter", nullptr);
     GstCaps* videoscale_caps = gst_caps_new_simple("video/x-raw",
         "width", G_TYPE_INT, config.inference.scale_width,
         "height", G_TYPE_INT, config.inference.scale_height,
@@ -208,8 +224,8 @@ bool CameraSource::createInferenceChain(const CameraConfig& config) {
     g_object_set(elements_.videoscale_capsfilter, "caps", videoscale_caps, nullptr);
     gst_caps_unref(videoscale_caps);
 
-    elements_.converter2 = gst_element_factory_make("nvvideoconvert", nullptr);
-    elements_.converter2_capsfilter = gst_element_factory_make("capsfilter", nullptr);
+    elements_.converter2 = factory.make("nvvideoconvert", nullptr);
+    elements_.converter2_capsfilter = factory.make("capsfilter", nullptr);
     GstCaps* converter_caps = gst_caps_new_simple("video/x-raw",
         "format", G_TYPE_STRING, "NV12",
         "width", G_TYPE_INT, config.inference.scale_width,
@@ -222,30 +238,34 @@ bool CameraSource::createInferenceChain(const CameraConfig& config) {
     gst_caps_unref(converter_caps);
 
     // Mux
-    elements_.mux = gst_element_factory_make("nvstreammux", nullptr);
-    g_object_set(elements_.mux,
-                    "batch-size", 1,
-                    "width", config.inference.scale_width,
-                    "height", config.inference.scale_height,
-                    "live-source", 1,
-                    "batched-push-timeout", 33000,  // 40000 -> 33000 (30fps 기준)
-                    "enable-padding", 0,
-                    nullptr);
+    elements_.mux = factory.make("nvstreammux", nullptr);
+    if (!ElementFactory::isSubstitute(elements_.mux)) {
+        g_object_set(elements_.mux,
+                        "batch-size", 1,
+                        "width", config.inference.scale_width,
+                        "height", config.inference.scale_height,
+                        "live-source", 1,
+                        "batched-push-timeout", 33000,  // 40000 -> 33000 (30fps 기준)
+                        "enable-padding", 0,
+                        nullptr);
+    }
     
     // 추론
-    elements_.infer = gst_element_factory_make("nvinfer", nullptr);
+    elements_.infer = factory.make("nvinfer", nullptr);
 
-    g_object_set(elements_.infer,
-                "config-file-path", config.inference.config_file.c_str(),
-                "unique-id", index_ + 1,
-                nullptr);
+    if (!ElementFactory::isSubstitute(elements_.infer)) {
+        g_object_set(elements_.infer,
+                    "config-file-path", config.inference.config_file.c_str(),
+                    "unique-id", index_ + 1,
+                    nullptr);
+    }
     
     // 후처리
-    elements_.nvof = gst_element_factory_make("nvof", nullptr);
-    elements_.converter3 = gst_element_factory_make("nvvideoconvert", nullptr);
-    elements_.postproc = gst_element_factory_make("dspostproc", nullptr);
-    elements_.osd = gst_element_factory_make("nvdsosd", nullptr);
-    elements_.converter4 = gst_element_factory_make("nvvideoconvert", nullptr);
+    elements_.nvof = factory.make("nvof", nullptr);
+    elements_.converter3 = factory.make("nvvideoconvert", nullptr);
+    elements_.postproc = factory.make("dspostproc", nullptr);
+    elements_.osd = factory.make("nvdsosd", nullptr);
+    elements_.converter4 = factory.make("nvvideoconvert", nullptr);
     
     return true;
 }
@@ -269,6 +289,8 @@ bool CameraSource::linkElements(const CameraConfig& config) {
         return false;
     }
     
+    ElementFactory& factory = ElementFactory::getInstance();
+    
     // ========== 1. 기본 소스 체인 생성 ==========
     gst_bin_add_many(GST_BIN(pipeline_),
         elements_.shmsrc, elements_.shm_capsfilter, elements_.converter1, /*elements_.clockoverlay,*/
@@ -327,7 +349,7 @@ bool CameraSource::linkElements(const CameraConfig& config) {
         gst_caps_unref(scale_caps);
         
         GstPad* conv_pad = gst_element_get_static_pad(elements_.converter2, "src");
-        GstPad* mux_pad = gst_element_get_request_pad(elements_.mux, "sink_0");
+        GstPad* mux_pad = ElementFactory::getSinkPad(elements_.mux, "sink_0");
         
         if (gst_pad_link(conv_pad, mux_pad) != GST_PAD_LINK_OK) {
             LOG_ERROR("Failed to link converter to mux");
@@ -347,7 +369,7 @@ bool CameraSource::linkElements(const CameraConfig& config) {
         char main_tee_name[32];
         snprintf(main_tee_name, sizeof(main_tee_name), "main_tee_%d", index_);
         
-        GstElement* main_tee = gst_element_factory_make("tee", main_tee_name);
+        GstElement* main_tee = factory.make("tee", main_tee_name);
         g_object_set(main_tee, "allow-not-linked", TRUE, NULL);
         gst_bin_add(GST_BIN(pipeline_), main_tee);
         
@@ -366,10 +388,10 @@ bool CameraSource::linkElements(const CameraConfig& config) {
         snprintf(webrtc_caps_name, sizeof(webrtc_caps_name), "webrtc_caps_%d", index_);
         snprintf(webrtc_sink_name, sizeof(webrtc_sink_name), "webrtc_shmsink_%d", index_);
 
-        GstElement* webrtc_queue = gst_element_factory_make("queue", webrtc_queue_name);
-        GstElement* webrtc_conv = gst_element_factory_make("nvvideoconvert", webrtc_conv_name);
-        GstElement* webrtc_caps = gst_element_factory_make("capsfilter", webrtc_caps_name);
-        GstElement* webrtc_sink = gst_element_factory_make("shmsink", webrtc_sink_name);
+        GstElement* webrtc_queue = factory.make("queue", webrtc_queue_name);
+        GstElement* webrtc_conv = factory.make("nvvideoconvert", webrtc_conv_name);
+        GstElement* webrtc_caps = factory.make("capsfilter", webrtc_caps_name);
+        GstElement* webrtc_sink = factory.make("shmsink", webrtc_sink_name);
 
         // shmsink 소켓 경로 설정
         const char* shm_socket_path = nullptr;
@@ -401,13 +423,15 @@ bool CameraSource::linkElements(const CameraConfig& config) {
         g_object_set(webrtc_caps, "caps", caps, nullptr);
 
         // shmsink 속성 설정
-        g_object_set(webrtc_sink, 
-            "socket-path", shm_socket_path,
-            "wait-for-connection", FALSE,
-            "shm-size", 10485760,  // 10MB 공유 메모리
-            "buffer-time", 100000000,  // 100ms
-            "sync", FALSE,
-            nullptr);
+        if (!ElementFactory::isSubstitute(webrtc_sink)) {
+            g_object_set(webrtc_sink, 
+                "socket-path", shm_socket_path,
+                "wait-for-connection", FALSE,
+                "shm-size", 10485760,  // 10MB 공유 메모리
+                "buffer-time", 100000000,  // 100ms
+                "sync", FALSE,
+                nullptr);
+        }
 
         g_object_set(webrtc_queue, "max-size-buffers", 5, "leaky", 2, nullptr);
 
@@ -455,9 +479,9 @@ bool CameraSource::linkElements(const CameraConfig& config) {
         snprintf(webrtc_conv_name, sizeof(webrtc_conv_name), "webrtc_conv_%d", index_);
         snprintf(webrtc_sink_name, sizeof(webrtc_sink_name), "webrtc_shmsink_%d", index_);
 
-        GstElement* webrtc_queue = gst_element_factory_make("queue", webrtc_queue_name);
-        GstElement* webrtc_conv = gst_element_factory_make("nvvideoconvert", webrtc_conv_name);
-        GstElement* webrtc_sink = gst_element_factory_make("shmsink", webrtc_sink_name);
+        GstElement* webrtc_queue = factory.make("queue", webrtc_queue_name);
+        GstElement* webrtc_conv = factory.make("nvvideoconvert", webrtc_conv_name);
+        GstElement* webrtc_sink = factory.make("shmsink", webrtc_sink_name);
 
         // shmsink 소켓 경로 설정
         const char* shm_socket_path = nullptr;
@@ -468,13 +492,15 @@ bool CameraSource::linkElements(const CameraConfig& config) {
         }
         
         // shmsink 속성 설정
-        g_object_set(webrtc_sink, 
-            "socket-path", shm_socket_path,
-            "wait-for-connection", FALSE,
-            "shm-size", 10485760,  // 10MB 공유 메모리
-            "buffer-time", 100000000,  // 100ms
-            "sync", FALSE,
-            nullptr);
+        if (!ElementFactory::isSubstitute(webrtc_sink)) {
+            g_object_set(webrtc_sink, 
+                "socket-path", shm_socket_path,
+                "wait-for-connection", FALSE,
+                "shm-size", 10485760,  // 10MB 공유 메모리
+                "buffer-time", 100000000,  // 100ms
+                "sync", FALSE,
+                nullptr);
+        }
             
         g_object_set(webrtc_queue, "max-size-buffers", 5, "leaky", 2, nullptr);
 
@@ -622,22 +648,30 @@ bool CameraSource::addProbes() {
     //     LOG_WARN("WebRTC elements not found for camera %d", index_);
     // }
 
+    // 프로브마다 상태를 따로 둔다 (카메라끼리 공유하지 않음)
+    struct CapsProbeState {
+        std::string name;
+        std::atomic<bool> printed{false};
+    };
+    
     auto addCapsProbe = [this](GstElement* element, const char* elementName) {
         if (!element) return;
         
         GstPad* srcPad = gst_element_get_static_pad(element, "src");
         if (!srcPad) return;
         
+        CapsProbeState* state = new CapsProbeState();
+        state->name = std::string(elementName) + "_" + std::to_string(index_);
+        
         gst_pad_add_probe(srcPad, GST_PAD_PROBE_TYPE_BUFFER,
             [](GstPad* pad, GstPadProbeInfo* info, gpointer userData) -> GstPadProbeReturn {
-                const char* name = (const char*)userData;
-                static std::map<std::string, bool> printed;
+                CapsProbeState* state = static_cast<CapsProbeState*>(userData);
                 
                 // 각 요소당 한 번만 출력
-                if (printed[name]) {
+                if (state->printed.exchange(true)) {
                     return GST_PAD_PROBE_OK;
                 }
-                printed[name] = true;
+                const char* name = state->name.c_str();
                 
                 GstCaps* caps = gst_pad_get_current_caps(pad);
                 if (caps) {
@@ -663,7 +697,7 @@ bool CameraSource::addProbes() {
                 }
                 
                 return GST_PAD_PROBE_OK;
-            }, (gpointer)g_strdup(elementName), g_free);
+            }, state, [](gpointer userData) { delete static_cast<CapsProbeState*>(userData); });
             
         gst_object_unref(srcPad);
     };
@@ -833,9 +867,79 @@ bool CameraSource::addProbes() {
         }
     }
     
+    addLatencyProbes();
+    addMetricsProbes();
+    
     return true;
 }
 
+// 단계별 지연: shmsrc 출력을 기준으로 각 요소 출력과 WebRTC shmsink 입력까지
+// (추론 체인은 tee 분기이므로 WebRTC 단계의 부모는 추론 출력, 추론이 꺼져 있으면 queue1)
+void CameraSource::addLatencyProbes() {
+    LatencyTrace* trace = latencyTrace_.get();
+    
+    size_t source = trace->addStage("shmsrc");
+    attachLatencyProbe(trace, source, elements_.shmsrc, "src");
+    
+    size_t convert = trace->addStage("convert", source);
+    attachLatencyProbe(trace, convert, elements_.converter1, "src");
+    
+    size_t queue = trace->addStage("queue1", convert);
+    attachLatencyProbe(trace, queue, elements_.queue1, "src");
+    
+    size_t last = queue;
+    if (config_.inference.enabled) {
+        size_t mux = trace->addStage("mux", queue);
+        attachLatencyProbe(trace, mux, elements_.mux, "src");
+        
+        size_t infer = trace->addStage("infer", mux);
+        attachLatencyProbe(trace, infer, elements_.infer, "src");
+        
+        size_t osd = trace->addStage("osd", infer);
+        attachLatencyProbe(trace, osd, elements_.osd, "src");
+        
+        last = trace->addStage("output", osd);
+        attachLatencyProbe(trace, last, elements_.converter4, "src");
+    }
+    
+    char sinkName[32];
+    snprintf(sinkName, sizeof(sinkName), "webrtc_shmsink_%d", index_);
+    GstElement* webrtcSink = gst_bin_get_by_name(GST_BIN(pipeline_), sinkName);
+    if (webrtcSink) {
+        size_t sink = trace->addStage("webrtc_sink", last);
+        attachLatencyProbe(trace, sink, webrtcSink, "sink");
+        gst_object_unref(webrtcSink);
+    }
+    
+    LOG_INFO("Latency tracing enabled for camera %d", index_);
+}
+
+// 요소별 지표: leaky 큐는 드롭/채움 정도까지, 나머지는 처리량만
+void CameraSource::addMetricsProbes() {
+    monitor_->watchElement(elements_.shmsrc, "shmsrc");
+    monitor_->watchQueue(elements_.queue1, "queue1");
+    
+    if (config_.inference.enabled) {
+        monitor_->watchQueue(elements_.queue2, "queue2");
+        monitor_->watchElement(elements_.infer, "infer");
+    }
+    
+    char name[32];
+    snprintf(name, sizeof(name), "webrtc_queue_%d", index_);
+    GstElement* webrtcQueue = gst_bin_get_by_name(GST_BIN(pipeline_), name);
+    if (webrtcQueue) {
+        monitor_->watchQueue(webrtcQueue, "webrtc_queue");
+        gst_object_unref(webrtcQueue);
+    }
+    
+    snprintf(name, sizeof(name), "webrtc_shmsink_%d", index_);
+    GstElement* webrtcSink = gst_bin_get_by_name(GST_BIN(pipeline_), name);
+    if (webrtcSink) {
+        monitor_->watchElement(webrtcSink, "webrtc_sink", "sink");
+        gst_object_unref(webrtcSink);
+    }
+}
+
 bool CameraSource::addPeerOutput(const std::string& peerId) {
     LOG_INFO("Using fixed WebRTC channel for peer %s", peerId.c_str());
     return true;
@@ -847,34 +951,33 @@ bool CameraSource::removePeerOutput(const std::string& peerId) {
     return true;
 }
 
-void CameraSource::handleDetectionEvent(const DetectionData& detection) {
-    // 중요 이벤트 처리
-    for (const auto& obj : detection.objects) {
-        switch (obj.classId) {
-            case CLASS_LABOR_SIGN_COW:
-                LOG_WARN("분만 징후 감지! Camera: %s, Frame: %u",
-                        (type_ == CameraType::RGB) ? "RGB" : "THERMAL",
-                        detection.frameNumber);
-                // TODO: 알림 전송
-                break;
-                
-            case CLASS_FLIP_COW:
-                if (obj.color == BboxColor::RED) {
-                    LOG_WARN("전도 소 확정! Camera: %s, Frame: %u",
-                            (type_ == CameraType::RGB) ? "RGB" : "THERMAL",
-                            detection.frameNumber);
-                    // TODO: 긴급 알림
-                }
-                break;
-                
-            case CLASS_HEAT_COW:
-                if (obj.color == BboxColor::RED) {
-                    LOG_INFO("발정 소 확정! Camera: %s, Frame: %u",
-                            (type_ == CameraType::RGB) ? "RGB" : "THERMAL",
-                            detection.frameNumber);
-                    // TODO: 기록 및 알림
-                }
-                break;
-        }
+void CameraSource::handleDetectionEvent(const DetectionEvent& event) {
+    // 중요 이벤트 처리 (EventConfirmer가 확정한 이벤트만 들어온다)
+    const char* camera = (type_ == CameraType::RGB) ? "RGB" : "THERMAL";
+    long long trackId = (event.trackId == EventConfirmer::UNTRACKED) ? -1 : static_cast<long long>(event.trackId);
+    
+    switch (event.classId) {
+        case CLASS_LABOR_SIGN_COW:
+            LOG_WARN("분만 징후 감지! Camera: %s, Frame: %u, Track: %lld (%d/%d frames)",
+                    camera, event.frameNumber, trackId, event.hits, event.window);
+            // TODO: 알림 전송
+            break;
+            
+        case CLASS_FLIP_COW:
+            LOG_WARN("전도 소 확정! Camera: %s, Frame: %u, Track: %lld (%d/%d frames)",
+                    camera, event.frameNumber, trackId, event.hits, event.window);
+            // TODO: 긴급 알림
+            break;
+            
+        case CLASS_HEAT_COW:
+            LOG_INFO("발정 소 확정! Camera: %s, Frame: %u, Track: %lld (%d/%d frames)",
+                    camera, event.frameNumber, trackId, event.hits, event.window);
+            // TODO: 기록 및 알림
+            break;
+            
+        default:
+            LOG_INFO("Detection event! Camera: %s, Class: %d, Frame: %u, Track: %lld (%d/%d frames)",
+                    camera, event.classId, event.frameNumber, trackId, event.hits, event.window);
+            break;
     }
 }
\ No newline at end of file
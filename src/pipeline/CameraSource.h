@@ -4,13 +4,14 @@
 #include <memory>
 #include <string>
 #include <gst/gst.h>
-#include <gstnvdsmeta.h>
 #include <unordered_map>
 #include <mutex>
 #include "../common/Types.h"
 #include "../detection/Detector.h"
 
 class DetectionBuffer;
+class LatencyTrace;
+class PipelineMonitor;
 
 class CameraSource {
 public:
@@ -22,6 +23,12 @@ public:
     // 검출 버퍼 접근
     DetectionBuffer* getDetectionBuffer() const { return detectionBuffer_.get(); }
     
+    // 검출기 접근 (추론이 꺼져 있으면 nullptr)
+    Detector* getDetector() const { return detector_.get(); }
+    
+    // 단계별 프레임 지연 추적 접근
+    LatencyTrace* getLatencyTrace() const { return latencyTrace_.get(); }
+    
     // 동적 피어 관리
     bool addPeerOutput(const std::string& peerId);
     bool removePeerOutput(const std::string& peerId);
@@ -35,12 +42,14 @@ private:
     bool createInferenceChain(const CameraConfig& config);
     bool linkElements(const CameraConfig& config);
     bool addProbes();
+    void addLatencyProbes();
+    void addMetricsProbes();
     
     // 프로브 콜백
     static GstPadProbeReturn osdSinkPadProbe(GstPad* pad, GstPadProbeInfo* info, gpointer userData);
     
     // 이벤트 처리
-    void handleDetectionEvent(const DetectionData& detection);
+    void handleDetectionEvent(const DetectionEvent& event);
     
 private:
     CameraType type_;
@@ -51,6 +60,12 @@ private:
     std::unique_ptr<Detector> detector_;
     std::unique_ptr<DetectionBuffer> detectionBuffer_;
     
+    // 단계별 지연 추적 (버퍼 PTS 기준 패드 프로브)
+    std::unique_ptr<LatencyTrace> latencyTrace_;
+    
+    // 요소별 처리량/큐 드롭 지표 (/metrics)
+    std::unique_ptr<PipelineMonitor> monitor_;
+    
     // 설정
     CameraConfig config_;
     
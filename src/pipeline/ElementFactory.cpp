@@ -0,0 +1,95 @@
+#include "ElementFactory.h"
+#include "../utils/Logger.h"
+
+namespace {
+    const char* SUBSTITUTE_KEY = "element-factory-substitute-for";
+}
+
+ElementFactory& ElementFactory::getInstance() {
+    static ElementFactory instance;
+    return instance;
+}
+
+ElementFactory::ElementFactory() {
+#ifndef HAVE_DEEPSTREAM
+    // DeepStream 없이 빌드하면 NVIDIA 요소는 처음부터 CPU 대체 요소로 만든다
+    useCpuSubstitutions();
+#endif
+}
+
+GstElement* ElementFactory::make(const char* factory, const char* name) {
+    std::string description;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!substitutions_.empty()) {
+            auto it = substitutions_.find(factory);
+            if (it != substitutions_.end()) {
+                description = it->second;
+            }
+        }
+    }
+    if (description.empty()) {
+        return gst_element_factory_make(factory, name);
+    }
+
+    GError* error = nullptr;
+    GstElement* element;
+    if (description.find('!') != std::string::npos) {
+        element = gst_parse_bin_from_description(description.c_str(), TRUE, &error);
+    } else {
+        element = gst_parse_launch(description.c_str(), &error);
+    }
+    if (!element || error) {
+        LOG_ERROR("Failed to create substitute for %s (%s): %s", factory, description.c_str(),
+                  error ? error->message : "unknown error");
+        g_clear_error(&error);
+        if (element) {
+            gst_object_unref(element);
+        }
+        return nullptr;
+    }
+
+    if (name) {
+        gst_object_set_name(GST_OBJECT(element), name);
+    }
+    // 팩토리 이름은 프로세스 수명 동안 유지되는 intern 문자열로 남긴다
+    g_object_set_data(G_OBJECT(element), SUBSTITUTE_KEY,
+                      const_cast<gchar*>(g_intern_string(factory)));
+    LOG_DEBUG("Substituted %s with '%s' (%s)", factory, description.c_str(), GST_ELEMENT_NAME(element));
+    return element;
+}
+
+void ElementFactory::setSubstitution(const std::string& factory, const std::string& description) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    substitutions_[factory] = description;
+}
+
+void ElementFactory::clearSubstitutions() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    substitutions_.clear();
+}
+
+void ElementFactory::useCpuSubstitutions() {
+    // nvvideoconvert는 포맷/해상도 변환을 함께 하므로 CPU 쪽은 세 요소로 나눈다
+    // (WebRTC 출력 caps가 해상도와 프레임레이트를 고정하는 경우도 협상되도록)
+    setSubstitution("nvvideoconvert", "videoconvert ! videoscale ! videorate");
+    setSubstitution("nvstreammux", "identity");
+    setSubstitution("nvinfer", "identity");
+    setSubstitution("nvof", "identity");
+    setSubstitution("dspostproc", "identity");
+    setSubstitution("nvdsosd", "identity");
+}
+
+const char* ElementFactory::substitutedFactory(GstElement* element) {
+    if (!element) {
+        return nullptr;
+    }
+    return static_cast<const char*>(g_object_get_data(G_OBJECT(element), SUBSTITUTE_KEY));
+}
+
+GstPad* ElementFactory::getSinkPad(GstElement* element, const char* requestName) {
+    if (isSubstitute(element)) {
+        return gst_element_get_static_pad(element, "sink");
+    }
+    return gst_element_get_request_pad(element, requestName);
+}
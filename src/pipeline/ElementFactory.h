@@ -0,0 +1,44 @@
+#ifndef ELEMENT_FACTORY_H
+#define ELEMENT_FACTORY_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <gst/gst.h>
+
+// GStreamer 요소 생성 (대체 표 적용)
+// - 대체 표가 비어 있으면 gst_element_factory_make와 같다
+// - 표에 있는 팩토리는 대신 지정한 설명으로 만든다. 설명은 gst-launch 형식이며
+//   "videotestsrc is-live=true" 같은 단일 요소 또는 "videoconvert ! videoscale" 같은 체인(ghost 패드 bin)
+// - 대체된 요소에는 원래 팩토리 이름을 남겨, 호출한 쪽이 전용 속성/요청 패드 처리를 건너뛸 수 있다
+// NVIDIA 플러그인이 없는 환경에서 같은 토폴로지를 돌리기 위한 것 (useCpuSubstitutions).
+// HAVE_DEEPSTREAM 없이 빌드하면 처음부터 CPU 대체 표가 적용된다
+class ElementFactory {
+public:
+    static ElementFactory& getInstance();
+
+    GstElement* make(const char* factory, const char* name = nullptr);
+
+    void setSubstitution(const std::string& factory, const std::string& description);
+    void clearSubstitutions();
+
+    // NVIDIA 요소만 대체: nvvideoconvert → videoconvert/videoscale/videorate, nvinfer 등 → identity
+    void useCpuSubstitutions();
+
+    // 대체된 요소면 원래 팩토리 이름, 아니면 nullptr
+    static const char* substitutedFactory(GstElement* element);
+    static bool isSubstitute(GstElement* element) { return substitutedFactory(element) != nullptr; }
+
+    // 요청 싱크 패드 (nvstreammux의 sink_%u 등). 대체된 요소는 정적 "sink" 패드를 준다
+    static GstPad* getSinkPad(GstElement* element, const char* requestName);
+
+private:
+    ElementFactory();
+    ElementFactory(const ElementFactory&) = delete;
+    ElementFactory& operator=(const ElementFactory&) = delete;
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::string> substitutions_;
+};
+
+#endif // ELEMENT_FACTORY_H
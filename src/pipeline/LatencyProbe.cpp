@@ -0,0 +1,41 @@
+#include "LatencyProbe.h"
+#include "LatencyTrace.h"
+#include "../utils/Logger.h"
+
+namespace {
+    struct ProbeContext {
+        LatencyTrace* trace;
+        size_t stage;
+    };
+
+    GstPadProbeReturn latencyProbe(GstPad* pad, GstPadProbeInfo* info, gpointer userData) {
+        (void)pad;
+        ProbeContext* context = static_cast<ProbeContext*>(userData);
+        GstBuffer* buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+        if (buffer && GST_BUFFER_PTS_IS_VALID(buffer)) {
+            context->trace->stamp(context->stage, GST_BUFFER_PTS(buffer));
+        }
+        return GST_PAD_PROBE_OK;
+    }
+
+    void destroyContext(gpointer userData) {
+        delete static_cast<ProbeContext*>(userData);
+    }
+}
+
+bool attachLatencyProbe(LatencyTrace* trace, size_t stage, GstElement* element, const char* padName) {
+    if (!trace || !element || stage == LatencyTrace::NO_PARENT) {
+        return false;
+    }
+
+    GstPad* pad = gst_element_get_static_pad(element, padName);
+    if (!pad) {
+        LOG_WARN("Latency probe: %s has no %s pad", GST_ELEMENT_NAME(element), padName);
+        return false;
+    }
+
+    gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, latencyProbe,
+                      new ProbeContext{trace, stage}, destroyContext);
+    gst_object_unref(pad);
+    return true;
+}
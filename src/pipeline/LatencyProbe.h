@@ -0,0 +1,14 @@
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+#include <cstddef>
+#include <gst/gst.h>
+
+class LatencyTrace;
+
+// 요소의 패드에 버퍼 프로브를 걸어 trace의 stage 단계로 기록한다
+// (PTS가 없는 버퍼는 건너뜀). 요청 패드는 지원하지 않는다
+// trace는 파이프라인이 멈출 때까지 살아 있어야 한다
+bool attachLatencyProbe(LatencyTrace* trace, size_t stage, GstElement* element, const char* padName);
+
+#endif // LATENCY_PROBE_H
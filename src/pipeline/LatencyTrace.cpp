@@ -0,0 +1,131 @@
+#include "LatencyTrace.h"
+#include <chrono>
+
+LatencyTrace::LatencyTrace(const std::string& name)
+    : name_(name)
+    , stageCount_(0)
+    , slots_(new Slot[SLOT_COUNT]) {
+    stages_.reserve(MAX_STAGES);
+    for (size_t i = 0; i < SLOT_COUNT; i++) {
+        for (size_t stage = 0; stage < MAX_STAGES; stage++) {
+            slots_[i].times[stage].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+LatencyTrace::~LatencyTrace() = default;
+
+size_t LatencyTrace::addStage(const std::string& name, size_t parent) {
+    size_t index = stages_.size();
+    if (index >= MAX_STAGES) {
+        return NO_PARENT;
+    }
+    if (index == 0) {
+        parent = NO_PARENT;
+    } else if (parent == NO_PARENT || parent >= index) {
+        parent = index - 1;
+    }
+
+    auto stage = std::make_unique<Stage>();
+    stage->name = name;
+    stage->parent = parent;
+    stages_.push_back(std::move(stage));
+    stageCount_.store(stages_.size(), std::memory_order_release);
+    return index;
+}
+
+size_t LatencyTrace::findStage(const std::string& name) const {
+    for (size_t i = 0; i < stages_.size(); i++) {
+        if (stages_[i]->name == name) {
+            return i;
+        }
+    }
+    return NO_PARENT;
+}
+
+// PTS는 보통 프레임 간격의 배수라 곱셈 해시로 섞고, 이웃 PROBE_LENGTH개 슬롯 안에서 찾는다
+size_t LatencyTrace::slotIndex(uint64_t pts) {
+    return static_cast<size_t>((pts * 0x9E3779B97F4A7C15ull) >> 56);
+}
+
+void LatencyTrace::stamp(size_t stage, uint64_t pts) {
+    int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    stamp(stage, pts, nowNs);
+}
+
+void LatencyTrace::stamp(size_t stage, uint64_t pts, int64_t nowNs) {
+    if (stage >= stageCount_.load(std::memory_order_acquire)) {
+        return;
+    }
+    size_t base = slotIndex(pts);
+
+    // 기준 단계: 이웃 슬롯 중 가장 오래된 것을 이 PTS로 새로 채운다
+    if (stage == 0) {
+        Slot* oldest = &slots_[base];
+        for (size_t i = 1; i < PROBE_LENGTH; i++) {
+            Slot& candidate = slots_[(base + i) % SLOT_COUNT];
+            if (candidate.times[0].load(std::memory_order_relaxed) <
+                oldest->times[0].load(std::memory_order_relaxed)) {
+                oldest = &candidate;
+            }
+        }
+        Slot& slot = *oldest;
+        slot.pts.store(UINT64_MAX, std::memory_order_relaxed);
+        for (size_t i = 1; i < MAX_STAGES; i++) {
+            slot.times[i].store(0, std::memory_order_relaxed);
+        }
+        slot.times[0].store(nowNs, std::memory_order_relaxed);
+        slot.pts.store(pts, std::memory_order_release);
+        return;
+    }
+
+    Stage& current = *stages_[stage];
+    Slot* slot = nullptr;
+    for (size_t i = 0; i < PROBE_LENGTH && !slot; i++) {
+        Slot& candidate = slots_[(base + i) % SLOT_COUNT];
+        if (candidate.pts.load(std::memory_order_acquire) == pts) {
+            slot = &candidate;
+        }
+    }
+    if (!slot) {
+        current.unmatched.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    slot->times[stage].store(nowNs, std::memory_order_relaxed);
+
+    int64_t originNs = slot->times[0].load(std::memory_order_relaxed);
+    if (originNs > 0 && nowNs >= originNs) {
+        current.totalLatency.record(static_cast<uint64_t>(nowNs - originNs) / 1000);
+    }
+    int64_t parentNs = slot->times[current.parent].load(std::memory_order_relaxed);
+    if (parentNs > 0 && nowNs >= parentNs) {
+        current.stageLatency.record(static_cast<uint64_t>(nowNs - parentNs) / 1000);
+    }
+}
+
+std::vector<LatencyTrace::StageStats> LatencyTrace::getStats() const {
+    size_t count = stageCount_.load(std::memory_order_acquire);
+    std::vector<StageStats> stats;
+    stats.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        const Stage& stage = *stages_[i];
+        StageStats entry;
+        entry.name = stage.name;
+        entry.parent = (stage.parent == NO_PARENT) ? std::string() : stages_[stage.parent]->name;
+        entry.stage = stage.stageLatency.summarize();
+        entry.total = stage.totalLatency.summarize();
+        entry.unmatched = stage.unmatched.load(std::memory_order_relaxed);
+        stats.push_back(std::move(entry));
+    }
+    return stats;
+}
+
+void LatencyTrace::reset() {
+    size_t count = stageCount_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        stages_[i]->stageLatency.reset();
+        stages_[i]->totalLatency.reset();
+        stages_[i]->unmatched.store(0, std::memory_order_relaxed);
+    }
+}
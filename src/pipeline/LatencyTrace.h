@@ -0,0 +1,75 @@
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../utils/LatencyHistogram.h"
+
+// 카메라 파이프라인 단계별 지연 추적 (버퍼 PTS 기준)
+// - 기준 단계(0번, 보통 shmsrc src 패드)가 PTS마다 도착 시각을 남기고
+//   이후 단계들은 같은 PTS의 기록을 찾아 구간 지연(부모 단계부터)과 누적 지연(기준 단계부터)을 잰다
+// - PTS 기록은 고정 크기 링에 두므로, 링 크기보다 많은 프레임이 파이프라인 안에 있거나
+//   PTS가 바뀌는 요소 뒤의 단계는 매칭되지 않고 unmatched로만 센다
+// - 단계 구성(addStage)은 파이프라인 재생 전에 끝내야 한다. stamp()는 스트리밍 스레드에서 잠금 없이 호출된다
+// GStreamer에 의존하지 않는다 (패드 프로브 연결은 LatencyProbe)
+class LatencyTrace {
+public:
+    static constexpr size_t MAX_STAGES = 16;
+    static constexpr size_t NO_PARENT = static_cast<size_t>(-1);
+
+    struct StageStats {
+        std::string name;
+        std::string parent;                 // 기준 단계는 빈 문자열
+        LatencyHistogram::Summary stage;    // 부모 단계부터 (us)
+        LatencyHistogram::Summary total;    // 기준 단계부터 (us)
+        uint64_t unmatched;                 // PTS 기록을 찾지 못한 버퍼 수
+    };
+
+    explicit LatencyTrace(const std::string& name);
+    ~LatencyTrace();
+
+    const std::string& getName() const { return name_; }
+
+    // 단계 추가. 첫 단계가 기준 단계가 되고, parent를 생략하면 직전에 추가한 단계
+    // 반환값은 단계 번호 (MAX_STAGES를 넘으면 NO_PARENT)
+    size_t addStage(const std::string& name, size_t parent = NO_PARENT);
+    size_t findStage(const std::string& name) const;
+
+    // 버퍼가 단계를 지난 시각 기록 (단조 시각)
+    void stamp(size_t stage, uint64_t pts);
+    void stamp(size_t stage, uint64_t pts, int64_t nowNs);
+
+    std::vector<StageStats> getStats() const;
+    void reset();
+
+private:
+    static constexpr size_t SLOT_COUNT = 256;
+    static constexpr size_t PROBE_LENGTH = 4;
+
+    struct Stage {
+        std::string name;
+        size_t parent;
+        LatencyHistogram stageLatency;
+        LatencyHistogram totalLatency;
+        std::atomic<uint64_t> unmatched{0};
+    };
+
+    // PTS 하나의 단계별 도착 시각 (0: 아직 지나지 않음)
+    struct Slot {
+        std::atomic<uint64_t> pts{UINT64_MAX};
+        std::atomic<int64_t> times[MAX_STAGES];
+    };
+
+    static size_t slotIndex(uint64_t pts);
+
+    std::string name_;
+    std::vector<std::unique_ptr<Stage>> stages_;
+    std::atomic<size_t> stageCount_;
+    std::unique_ptr<Slot[]> slots_;
+};
+
+#endif // LATENCY_TRACE_H
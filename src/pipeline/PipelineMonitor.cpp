@@ -0,0 +1,174 @@
+#include "PipelineMonitor.h"
+#include "../utils/Logger.h"
+#include "../utils/Metrics.h"
+
+namespace {
+    constexpr gint64 RATE_WINDOW_US = G_USEC_PER_SEC;
+    constexpr gint64 STALE_US = 2 * G_USEC_PER_SEC;  // 이보다 오래 버퍼가 없으면 fps 0
+}
+
+struct PipelineMonitor::Watch {
+    GstElement* element;  // 참조 보유
+    bool isQueue;
+
+    Counter* buffers;
+    Gauge* fps;
+    Counter* dropped;     // 큐만
+    Gauge* dropRate;
+    Gauge* level;
+    Gauge* fillRatio;
+
+    // 창 시작 시점의 값 (프로브를 부르는 스트리밍 스레드만 갱신)
+    gint64 windowStartUs = 0;
+    uint64_t windowBuffers = 0;
+    uint64_t windowDrops = 0;
+    std::atomic<gint64> lastBufferUs{0};
+};
+
+PipelineMonitor::PipelineMonitor(const std::string& camera)
+    : camera_(camera)
+    , collectorId_(0) {
+    collectorId_ = MetricsRegistry::getInstance().addCollector([this]() { collect(); });
+}
+
+PipelineMonitor::~PipelineMonitor() {
+    MetricsRegistry::getInstance().removeCollector(collectorId_);
+    for (auto& watch : watches_) {
+        if (watch->isQueue) {
+            g_signal_handlers_disconnect_by_data(watch->element, watch.get());
+        }
+        gst_object_unref(watch->element);
+    }
+}
+
+bool PipelineMonitor::watchQueue(GstElement* queue, const std::string& name) {
+    Watch* watch = addWatch(queue, name, "src", true);
+    if (!watch) {
+        return false;
+    }
+    g_signal_connect(queue, "overrun", G_CALLBACK(PipelineMonitor::onOverrun), watch);
+    return true;
+}
+
+bool PipelineMonitor::watchElement(GstElement* element, const std::string& name, const char* padName) {
+    return addWatch(element, name, padName, false) != nullptr;
+}
+
+PipelineMonitor::Watch* PipelineMonitor::addWatch(GstElement* element, const std::string& name,
+                                                  const char* padName, bool isQueue) {
+    if (!element) {
+        return nullptr;
+    }
+
+    GstPad* pad = gst_element_get_static_pad(element, padName);
+    if (!pad) {
+        LOG_WARN("Pipeline monitor: %s has no %s pad", GST_ELEMENT_NAME(element), padName);
+        return nullptr;
+    }
+
+    MetricsRegistry& registry = MetricsRegistry::getInstance();
+    MetricLabels labels = {{"camera", camera_}, {"element", name}};
+
+    auto watch = std::make_unique<Watch>();
+    watch->element = GST_ELEMENT(gst_object_ref(element));
+    watch->isQueue = isQueue;
+    watch->buffers = &registry.counter("pipeline_buffers_total",
+        "Buffers that left the element", labels);
+    watch->fps = &registry.gauge("pipeline_fps",
+        "Buffers per second over the last second", labels);
+    watch->dropped = nullptr;
+    watch->dropRate = nullptr;
+    watch->level = nullptr;
+    watch->fillRatio = nullptr;
+    if (isQueue) {
+        watch->dropped = &registry.counter("pipeline_queue_dropped_total",
+            "Buffers dropped by a leaky queue (overrun signals)", labels);
+        watch->dropRate = &registry.gauge("pipeline_queue_drop_rate",
+            "Dropped buffers per second over the last second", labels);
+        watch->level = &registry.gauge("pipeline_queue_level_buffers",
+            "Buffers currently held by the queue", labels);
+        watch->fillRatio = &registry.gauge("pipeline_queue_fill_ratio",
+            "Queue level relative to max-size-buffers", labels);
+    }
+
+    Watch* raw = watch.get();
+    {
+        std::lock_guard<std::mutex> lock(watchesMutex_);
+        watches_.push_back(std::move(watch));
+    }
+
+    gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, PipelineMonitor::bufferProbe, raw, nullptr);
+    gst_object_unref(pad);
+    return raw;
+}
+
+GstPadProbeReturn PipelineMonitor::bufferProbe(GstPad* pad, GstPadProbeInfo* info, gpointer userData) {
+    (void)pad;
+    (void)info;
+    Watch* watch = static_cast<Watch*>(userData);
+    watch->buffers->inc();
+
+    gint64 nowUs = g_get_monotonic_time();
+    watch->lastBufferUs.store(nowUs, std::memory_order_relaxed);
+    if (watch->windowStartUs == 0) {
+        watch->windowStartUs = nowUs;
+        watch->windowBuffers = watch->buffers->get();
+        watch->windowDrops = watch->dropped ? watch->dropped->get() : 0;
+        return GST_PAD_PROBE_OK;
+    }
+
+    gint64 elapsedUs = nowUs - watch->windowStartUs;
+    if (elapsedUs < RATE_WINDOW_US) {
+        return GST_PAD_PROBE_OK;
+    }
+    if (elapsedUs > STALE_US) {
+        // 흐름이 끊겼다가 다시 시작: 멈춘 구간을 평균에 넣지 않도록 창만 새로 연다
+        watch->windowStartUs = nowUs;
+        watch->windowBuffers = watch->buffers->get();
+        watch->windowDrops = watch->dropped ? watch->dropped->get() : 0;
+        return GST_PAD_PROBE_OK;
+    }
+
+    double seconds = static_cast<double>(elapsedUs) / G_USEC_PER_SEC;
+    uint64_t buffers = watch->buffers->get();
+    watch->fps->set(static_cast<double>(buffers - watch->windowBuffers) / seconds);
+    watch->windowBuffers = buffers;
+    if (watch->dropped) {
+        uint64_t drops = watch->dropped->get();
+        watch->dropRate->set(static_cast<double>(drops - watch->windowDrops) / seconds);
+        watch->windowDrops = drops;
+    }
+    watch->windowStartUs = nowUs;
+    return GST_PAD_PROBE_OK;
+}
+
+// leaky=downstream 큐는 가득 찬 상태에서 버퍼가 들어올 때마다 overrun을 보낸 뒤 가장 오래된 버퍼를 버린다
+void PipelineMonitor::onOverrun(GstElement* queue, gpointer userData) {
+    (void)queue;
+    static_cast<Watch*>(userData)->dropped->inc();
+}
+
+// /metrics 렌더 직전: 큐 채움 정도를 읽고, 버퍼가 끊긴 요소의 fps/드롭률을 0으로
+void PipelineMonitor::collect() {
+    gint64 nowUs = g_get_monotonic_time();
+    std::lock_guard<std::mutex> lock(watchesMutex_);
+    for (auto& watch : watches_) {
+        if (nowUs - watch->lastBufferUs.load(std::memory_order_relaxed) > STALE_US) {
+            watch->fps->set(0.0);
+            if (watch->dropRate) {
+                watch->dropRate->set(0.0);
+            }
+        }
+
+        if (watch->isQueue) {
+            guint level = 0;
+            guint maxBuffers = 0;
+            g_object_get(watch->element,
+                         "current-level-buffers", &level,
+                         "max-size-buffers", &maxBuffers,
+                         nullptr);
+            watch->level->set(static_cast<double>(level));
+            watch->fillRatio->set(maxBuffers > 0 ? static_cast<double>(level) / maxBuffers : 0.0);
+        }
+    }
+}
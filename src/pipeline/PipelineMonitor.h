@@ -0,0 +1,46 @@
+#ifndef PIPELINE_MONITOR_H
+#define PIPELINE_MONITOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <gst/gst.h>
+
+class Counter;
+class Gauge;
+
+// 카메라 파이프라인 요소별 처리량/드롭 지표 (MetricsRegistry에 등록, /metrics로 노출)
+// - 요소 src 패드 프로브로 버퍼 수를 세고 1초 창마다 fps를 갱신한다
+// - leaky 큐는 overrun 시그널 한 번이 버퍼 하나를 버리는 것에 해당하므로 드롭 수로 센다
+// - 큐 채움 정도(current-level-buffers / max-size-buffers)는 /metrics 요청 시 읽는다
+// 파이프라인이 멈출 때까지 살아 있어야 한다 (프로브와 시그널이 내부 상태를 가리킴)
+class PipelineMonitor {
+public:
+    explicit PipelineMonitor(const std::string& camera);
+    ~PipelineMonitor();
+
+    // leaky 큐: 처리량 + 드롭 + 채움 정도
+    bool watchQueue(GstElement* queue, const std::string& name);
+
+    // 일반 요소: padName 패드를 지나는 처리량만
+    bool watchElement(GstElement* element, const std::string& name, const char* padName = "src");
+
+private:
+    struct Watch;
+
+    static GstPadProbeReturn bufferProbe(GstPad* pad, GstPadProbeInfo* info, gpointer userData);
+    static void onOverrun(GstElement* queue, gpointer userData);
+
+    Watch* addWatch(GstElement* element, const std::string& name, const char* padName, bool isQueue);
+    void collect();
+
+    std::string camera_;
+    std::mutex watchesMutex_;  // 감시 추가와 collect() 사이
+    std::vector<std::unique_ptr<Watch>> watches_;
+    int collectorId_;
+};
+
+#endif // PIPELINE_MONITOR_H
@@ -1,5 +1,6 @@
 #include "SignalingClient.h"
 #include "../utils/Logger.h"
+#include "../utils/Metrics.h"
 #include <libsoup/soup.h>
 #include <json-glib/json-glib.h>
 #include <sstream>
@@ -19,6 +20,14 @@ SignalingClient::SignalingClient(const std::string& serverUrl, const std::string
 
     serverUrl_ = serverUrl + "/signaling/" + cameraId + "/?token=test&peerType=camera";
     
+    MetricsRegistry& registry = MetricsRegistry::getInstance();
+    sentCounter_ = &registry.counter("signaling_messages_total",
+        "Signaling WebSocket messages", {{"direction", "sent"}});
+    receivedCounter_ = &registry.counter("signaling_messages_total",
+        "Signaling WebSocket messages", {{"direction", "received"}});
+    reconnectCounter_ = &registry.counter("signaling_reconnects_total",
+        "Signaling reconnect attempts");
+    
     LOG_INFO("SignalingClient created for camera %s, server: %s",
              cameraId.c_str(), serverUrl.c_str());
 }
@@ -128,7 +137,7 @@ bool SignalingClient::sendMessage(const std::string& type, const std::string& da
     gchar* message = json_generator_to_data(generator, nullptr);
     
     // 메시지 전송
-    soup_websocket_connection_send_text(connection_, message);
+    sendText(message);
     
     LOG_INFO("Sent message: type=%s, data_len=%zu json=%s", type.c_str(), data.length(), message);
     
@@ -227,7 +236,7 @@ bool SignalingClient::sendToPeer(const std::string& peerId, const std::string& t
     gchar* message = json_generator_to_data(generator, nullptr);
     
     // 전송
-    soup_websocket_connection_send_text(connection_, message);
+    sendText(message);
     LOG_DEBUG("Sent to peer %s (type=%s): %s", peerId.c_str(), type.c_str(), message);
     
     g_free(message);
@@ -271,7 +280,7 @@ bool SignalingClient::registerCamera() {
     gchar* message = json_generator_to_data(generator, nullptr);
     
     // WebSocket으로 직접 전송
-    soup_websocket_connection_send_text(connection_, message);
+    sendText(message);
     
     LOG_INFO("Camera registration sent: %s", message);
     
@@ -311,7 +320,7 @@ void SignalingClient::sendSdpOffer(const std::string& peerId, const std::string&
     gchar* message = json_generator_to_data(generator, nullptr);
     
     // WebSocket으로 직접 전송
-    soup_websocket_connection_send_text(connection_, message);
+    sendText(message);
     
     LOG_INFO("Camera SdpOffer sent: %s", message);
     
@@ -353,7 +362,7 @@ void SignalingClient::sendIceCandidate(const std::string& peerId, int mlineindex
     gchar* message = json_generator_to_data(generator, nullptr);
     
     // WebSocket으로 직접 전송
-    soup_websocket_connection_send_text(connection_, message);
+    sendText(message);
     
     LOG_INFO("Camera IceCandidate sent: %s", message);
     
@@ -394,7 +403,7 @@ void SignalingClient::sendCameraStatus()
     gchar* message = json_generator_to_data(generator, nullptr);
     
     // WebSocket으로 직접 전송
-    soup_websocket_connection_send_text(connection_, message);
+    sendText(message);
     
     LOG_DEBUG("Camera Status sent: %s", message);
     
@@ -494,7 +503,14 @@ void SignalingClient::onError(SoupWebsocketConnection* conn, GError* error,
     LOG_ERROR("WebSocket error: %s", error->message);
 }
 
+void SignalingClient::sendText(const char* message) {
+    soup_websocket_connection_send_text(connection_, message);
+    sentCounter_->inc();
+}
+
 void SignalingClient::handleMessage(const std::string& message) {
+    receivedCounter_->inc();
+    
     // LOG_INFO("=== RAW WebSocket Message ===");
     // LOG_INFO("%s", message.c_str());
     // LOG_INFO("=============================");
@@ -587,6 +603,7 @@ void SignalingClient::reconnect() {
     }
     
     state_ = ConnectionState::RECONNECTING;
+    reconnectCounter_->inc();
     
     // 재연결 스레드 시작
     if (reconnectThread_.joinable()) {
@@ -15,6 +15,8 @@
 typedef struct _SoupWebsocketConnection SoupWebsocketConnection;
 typedef struct _SoupSession SoupSession;
 
+class Counter;
+
 class SignalingClient {
 public:
     enum class ConnectionState {
@@ -78,6 +80,7 @@ private:
     static void onError(SoupWebsocketConnection* conn, GError* error, gpointer userData);
     
     void handleMessage(const std::string& message);
+    void sendText(const char* message);
     void reconnect();
     void reconnectThread();
     
@@ -97,6 +100,11 @@ private:
     
     std::thread reconnectThread_;
     std::mutex connectionMutex_;
+    
+    // 지표 (메시지 송수신, 재연결)
+    Counter* sentCounter_;
+    Counter* receivedCounter_;
+    Counter* reconnectCounter_;
 
     // 상태 정보
     struct CameraStatus {
@@ -1,5 +1,6 @@
 #include "Config.h"
 #include "Logger.h"
+#include <algorithm>
 #include <fstream>
 #include <nlohmann/json.hpp>
 
@@ -25,6 +26,16 @@ public:
             config_.streamBasePort = j.value("stream_base_port", 5000);
             config_.snapshotPath = j.value("snapshot_path", "/home/nvidia/webrtc");
             config_.apiPort = j.value("api_port", 8080);  // API 서버 포트
+            config_.apiWorkerThreads = j.value("api_worker_threads", 4);
+            config_.apiMaxConnections = j.value("api_max_connections", 64);
+            config_.apiKeepAliveTimeoutMs = j.value("api_keepalive_timeout_ms", 5000);
+            config_.logOverflowPolicy = j.value("log_overflow_policy", "drop");
+            config_.logFormat = j.value("log_format", "text");
+            config_.logMaxFileSizeMb = j.value("log_max_file_size_mb", 50);
+            config_.logCompress = j.value("log_compress", true);
+            config_.logMaxArchives = j.value("log_max_archives", 20);
+            config_.logRetentionDays = j.value("log_retention_days", 14);
+            config_.logRateLimitPerSec = j.value("log_rate_limit_per_sec", 100);
             
             // TTY 설정
             if (j.contains("tty")) {
@@ -86,6 +97,9 @@ public:
             recordEncIndex_ = j.value("record_enc_index", 0);
             eventRecordEncIndex_ = j.value("event_record_enc_index", 0);
             
+            // 검출 필터/색상 규칙 파일 (비어 있으면 내장 기본 규칙)
+            detectionRulesPath_ = j.value("detection_rules", "");
+            
             // HTTP 서비스
             httpServicePort_ = j.value("http_service_port", "8080");
             
@@ -117,6 +131,7 @@ public:
     int recordEncIndex_;
     int eventRecordEncIndex_;
     std::string httpServicePort_;
+    std::string detectionRulesPath_;
 };
 
 // Config 구현
@@ -163,6 +178,39 @@ int Config::getApiPort() const {
     return pImpl->config_.apiPort;
 }
 
+int Config::getApiWorkerThreads() const {
+    return pImpl->config_.apiWorkerThreads;
+}
+
+int Config::getApiMaxConnections() const {
+    return pImpl->config_.apiMaxConnections;
+}
+
+int Config::getApiKeepAliveTimeoutMs() const {
+    return pImpl->config_.apiKeepAliveTimeoutMs;
+}
+
+std::string Config::getLogOverflowPolicy() const {
+    return pImpl->config_.logOverflowPolicy;
+}
+
+std::string Config::getLogFormat() const {
+    return pImpl->config_.logFormat;
+}
+
+int Config::getLogRateLimit() const {
+    return pImpl->config_.logRateLimitPerSec;
+}
+
+LogRotationPolicy Config::getLogRotationPolicy() const {
+    LogRotationPolicy policy;
+    policy.maxFileSize = static_cast<uint64_t>(std::max(0, pImpl->config_.logMaxFileSizeMb)) * 1024 * 1024;
+    policy.compress = pImpl->config_.logCompress;
+    policy.maxArchives = static_cast<size_t>(std::max(0, pImpl->config_.logMaxArchives));
+    policy.retentionDays = std::max(0, pImpl->config_.logRetentionDays);
+    return policy;
+}
+
 const CameraConfig& Config::getCameraConfig(int index) const {
     if (index < 0 || index >= static_cast<int>(pImpl->config_.cameras.size())) {
         static CameraConfig empty;
@@ -195,6 +243,10 @@ int Config::getEventBufferTime() const {
     return pImpl->eventBufferTime_;
 }
 
+std::string Config::getDetectionRulesPath() const {
+    return pImpl->detectionRulesPath_;
+}
+
 std::string Config::getCodecName() const {
     // 첫 번째 비디오 인코더에서 코덱 추출
     if (!pImpl->config_.cameras.empty()) {
@@ -4,6 +4,7 @@
 #include <string>
 #include <memory>
 #include "../common/Types.h"
+#include "Logger.h"
 
 class Config {
 public:
@@ -21,6 +22,13 @@ public:
     int getMaxStreamCount() const;
     int getStreamBasePort() const;
     int getApiPort() const;
+    int getApiWorkerThreads() const;
+    int getApiMaxConnections() const;
+    int getApiKeepAliveTimeoutMs() const;
+    std::string getLogOverflowPolicy() const;
+    std::string getLogFormat() const;
+    int getLogRateLimit() const;
+    LogRotationPolicy getLogRotationPolicy() const;
     const CameraConfig& getCameraConfig(int index) const;
     
     // 추가 설정 접근자
@@ -31,6 +39,7 @@ public:
     int getRecordDuration() const;
     int getEventBufferTime() const;
     std::string getCodecName() const;
+    std::string getDetectionRulesPath() const;
     
 private:
     class Impl;
@@ -31,6 +31,7 @@ bool DeviceSetting::load(const std::string& filename) {
         // 분석 설정
         settings_.analysisStatus = j.value("analysis_status", 0);
         settings_.nvInterval = j.value("nv_interval", 0);
+        settings_.nvMaxRate = j.value("nv_max_rate", 0.0);
         
         // 탐지 설정
         settings_.optFlowApply = j.value("opt_flow_apply", 0);
@@ -76,6 +77,7 @@ bool DeviceSetting::save(const std::string& filename) {
         // 분석 설정
         j["analysis_status"] = settings_.analysisStatus;
         j["nv_interval"] = settings_.nvInterval;
+        j["nv_max_rate"] = settings_.nvMaxRate;
         
         // 탐지 설정
         j["opt_flow_apply"] = settings_.optFlowApply;
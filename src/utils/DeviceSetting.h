@@ -14,6 +14,7 @@ public:
         // 분석 설정
         int analysisStatus;
         int nvInterval;
+        double nvMaxRate;  // 초당 검출 처리 상한 (0이면 제한 없음)
         
         // 탐지 설정
         int optFlowApply;
@@ -29,7 +30,7 @@ public:
         
         Settings() : 
             recordStatus(0),
-            analysisStatus(0), nvInterval(0),
+            analysisStatus(0), nvInterval(0), nvMaxRate(0.0),
             optFlowApply(0), resnet50Apply(0), enableEventNotify(1),
             tempCorrection(0), colorPalette(0), ptzStatus("off") {}
     };
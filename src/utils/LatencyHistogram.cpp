@@ -0,0 +1,95 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t valueUs) {
+    if (valueUs < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(valueUs);
+    }
+    int exponent = 63 - __builtin_clzll(valueUs);
+    if (exponent > MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+    int shift = exponent - SUB_BUCKET_BITS;
+    uint64_t subBucket = (valueUs >> shift) - SUB_BUCKET_COUNT;
+    return static_cast<size_t>(SUB_BUCKET_COUNT + shift * SUB_BUCKET_COUNT + subBucket);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    size_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+    uint64_t subBucket = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT;
+    uint64_t lower = (SUB_BUCKET_COUNT + subBucket) << shift;
+    return lower + (1ull << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t valueUs) {
+    buckets_[bucketIndex(valueUs)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(valueUs, std::memory_order_relaxed);
+
+    uint64_t current = min_.load(std::memory_order_relaxed);
+    while (valueUs < current &&
+           !min_.compare_exchange_weak(current, valueUs, std::memory_order_relaxed)) {
+    }
+    current = max_.load(std::memory_order_relaxed);
+    while (valueUs > current &&
+           !max_.compare_exchange_weak(current, valueUs, std::memory_order_relaxed)) {
+    }
+}
+
+// 백분위수는 해당 버킷의 가장 큰 값 (실제 최댓값을 넘지 않게 자름)
+LatencyHistogram::Summary LatencyHistogram::summarize() const {
+    Summary summary = {};
+    uint64_t counts[BUCKET_COUNT];
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return summary;
+    }
+
+    summary.count = total;
+    summary.min = min_.load(std::memory_order_relaxed);
+    summary.max = max_.load(std::memory_order_relaxed);
+    summary.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) /
+                   static_cast<double>(count_.load(std::memory_order_relaxed));
+
+    struct Target {
+        double quantile;
+        uint64_t* value;
+    } targets[] = {
+        {0.50, &summary.p50}, {0.90, &summary.p90}, {0.99, &summary.p99}, {0.999, &summary.p999}
+    };
+
+    uint64_t seen = 0;
+    size_t next = 0;
+    for (size_t i = 0; i < BUCKET_COUNT && next < 4; i++) {
+        seen += counts[i];
+        while (next < 4 && seen > 0 &&
+               seen >= static_cast<uint64_t>(std::ceil(targets[next].quantile * total))) {
+            *targets[next].value = std::min(bucketUpperBound(i), summary.max);
+            next++;
+        }
+    }
+    return summary;
+}
+
+void LatencyHistogram::reset() {
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        buckets_[i].store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
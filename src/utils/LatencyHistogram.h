@@ -0,0 +1,49 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 지연 시간 히스토그램 (HDR 방식 로그-선형 버킷, 마이크로초 단위)
+// - 32 미만은 1us 단위, 그 이상은 2의 거듭제곱 구간마다 32개 버킷 (상대 오차 3% 이내)
+// - 2^36us(약 19시간)를 넘는 값은 마지막 버킷에 넣는다
+// - record()는 잠금 없이 여러 스레드에서 호출할 수 있다
+class LatencyHistogram {
+public:
+    struct Summary {
+        uint64_t count;
+        uint64_t min;
+        uint64_t max;
+        double mean;
+        uint64_t p50;
+        uint64_t p90;
+        uint64_t p99;
+        uint64_t p999;
+    };
+
+    LatencyHistogram();
+
+    void record(uint64_t valueUs);
+    Summary summarize() const;
+    void reset();
+
+    // 버킷 번호 <-> 값 범위 (버킷의 가장 큰 값)
+    static size_t bucketIndex(uint64_t valueUs);
+    static uint64_t bucketUpperBound(size_t index);
+
+private:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKET_COUNT = 1ull << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 36;
+    static constexpr size_t BUCKET_COUNT =
+        SUB_BUCKET_COUNT + (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    std::atomic<uint64_t> buckets_[BUCKET_COUNT];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> min_;
+    std::atomic<uint64_t> max_;
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,297 @@
+#include "LogArchiver.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <tuple>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <zlib.h>
+
+namespace {
+    constexpr size_t COPY_CHUNK_SIZE = 64 * 1024;
+    constexpr int ARCHIVER_NICE = 10;
+
+    // 로그 파일 이름: YYYY-MM-DD[.N].log|.blog[.gz]
+    bool isLogFileName(const std::string& name) {
+        if (name.size() < 14 || name[4] != '-' || name[7] != '-') {
+            return false;
+        }
+        for (int i : {0, 1, 2, 3, 5, 6, 8, 9}) {
+            if (name[i] < '0' || name[i] > '9') {
+                return false;
+            }
+        }
+        std::string base = name;
+        if (base.size() > 3 && base.compare(base.size() - 3, 3, ".gz") == 0) {
+            base.erase(base.size() - 3);
+        }
+        auto endsWith = [&](const char* suffix) {
+            size_t n = strlen(suffix);
+            return base.size() >= n && base.compare(base.size() - n, n, suffix) == 0;
+        };
+        return endsWith(".log") || endsWith(".blog");
+    }
+
+    bool isCompressed(const std::string& name) {
+        return name.size() > 3 && name.compare(name.size() - 3, 3, ".gz") == 0;
+    }
+}
+
+int LogArchiver::rotationIndex(const std::string& name) {
+    if (!isLogFileName(name) || name[10] != '.') {
+        return -1;
+    }
+    // 날짜 뒤가 숫자면 회전 번호, 아니면 확장자
+    char* end = nullptr;
+    long index = strtol(name.c_str() + 11, &end, 10);
+    if (end == name.c_str() + 11 || *end != '.' || index <= 0 || index > INT_MAX) {
+        return 0;
+    }
+    return static_cast<int>(index);
+}
+
+LogArchiver::LogArchiver()
+    : running_(false)
+    , compress_(true)
+    , maxArchives_(DEFAULT_MAX_ARCHIVES)
+    , retentionDays_(DEFAULT_RETENTION_DAYS) {
+}
+
+LogArchiver::~LogArchiver() {
+    stop();
+}
+
+void LogArchiver::start(const std::string& directory) {
+    stop();
+
+    directory_ = directory;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.clear();
+    }
+    running_ = true;
+    thread_ = std::thread(&LogArchiver::archiverThread, this);
+}
+
+void LogArchiver::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+void LogArchiver::setPolicy(bool compress, size_t maxArchives, int retentionDays) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    compress_ = compress;
+    maxArchives_ = maxArchives;
+    retentionDays_ = retentionDays;
+}
+
+void LogArchiver::setActiveFiles(const std::set<std::string>& names) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    activeNames_ = names;
+}
+
+void LogArchiver::submit(const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(path);
+    }
+    cv_.notify_one();
+}
+
+bool LogArchiver::isActive(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return activeNames_.count(name) > 0;
+}
+
+void LogArchiver::archiverThread() {
+    // 압축은 스트리밍/추론 스레드보다 낮은 우선순위로
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), ARCHIVER_NICE);
+
+    sweepDirectory();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        if (queue_.empty()) {
+            cv_.wait(lock, [this]() { return !running_ || !queue_.empty(); });
+            continue;
+        }
+
+        std::string path = queue_.front();
+        queue_.pop_front();
+        bool compress = compress_;
+        lock.unlock();
+
+        if (compress) {
+            compressFile(path);
+        }
+        applyRetention();
+
+        lock.lock();
+    }
+}
+
+// 이전 실행에서 남은 로그 정리 (압축 안 된 것은 압축)
+void LogArchiver::sweepDirectory() {
+    DIR* dir = opendir(directory_.c_str());
+    if (!dir) {
+        return;
+    }
+
+    std::vector<std::string> pending;
+    while (struct dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (isLogFileName(name) && !isCompressed(name) && !isActive(name)) {
+            pending.push_back(directory_ + "/" + name);
+        }
+    }
+    closedir(dir);
+
+    bool compress;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        compress = compress_;
+    }
+    if (compress) {
+        std::sort(pending.begin(), pending.end());
+        for (const std::string& path : pending) {
+            if (!running_) {
+                return;
+            }
+            compressFile(path);
+        }
+    }
+    applyRetention();
+}
+
+// path -> path.gz (임시 파일에 쓴 뒤 rename, 성공하면 원본 삭제)
+bool LogArchiver::compressFile(const std::string& path) {
+    int input = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (input < 0) {
+        LOG_WARN("Log archive: cannot open %s: %s", path.c_str(), strerror(errno));
+        return false;
+    }
+    struct stat source;
+    if (fstat(input, &source) != 0) {
+        LOG_WARN("Log archive: cannot stat %s: %s", path.c_str(), strerror(errno));
+        ::close(input);
+        return false;
+    }
+
+    std::string target = path + ".gz";
+    std::string temp = target + ".tmp";
+    gzFile output = gzopen(temp.c_str(), "wb6");
+    if (!output) {
+        LOG_WARN("Log archive: cannot create %s", temp.c_str());
+        ::close(input);
+        return false;
+    }
+
+    std::vector<char> buffer(COPY_CHUNK_SIZE);
+    bool ok = true;
+    for (;;) {
+        if (!running_) {
+            ok = false;  // 종료 중: 원본은 남기고 다음 실행에서 다시 압축
+            break;
+        }
+        ssize_t n = ::read(input, buffer.data(), buffer.size());
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            ok = (n == 0);
+            break;
+        }
+        if (gzwrite(output, buffer.data(), static_cast<unsigned>(n)) != n) {
+            ok = false;
+            break;
+        }
+    }
+    ::close(input);
+
+    if (gzclose(output) != Z_OK) {
+        ok = false;
+    }
+    // 보관 기간은 mtime으로 판정하므로 압축 시각이 아닌 원본의 마지막 기록 시각을 유지
+    struct timespec times[2] = {source.st_atim, source.st_mtim};
+    if (ok && utimensat(AT_FDCWD, temp.c_str(), times, 0) != 0) {
+        LOG_WARN("Log archive: cannot set times on %s: %s", temp.c_str(), strerror(errno));
+    }
+    if (!ok || rename(temp.c_str(), target.c_str()) != 0) {
+        unlink(temp.c_str());
+        if (running_) {
+            LOG_WARN("Log archive: failed to compress %s", path.c_str());
+        }
+        return false;
+    }
+
+    unlink(path.c_str());
+    return true;
+}
+
+// 보관 파일 수 / 기간 제한 (활성 파일 제외, 오래된 것부터 삭제)
+// 순서는 회전 순서: 날짜, 그날의 회전 번호, 번호 없는 파일(그날 마지막) 순. mtime은 기간 판정에만 쓴다
+void LogArchiver::applyRetention() {
+    size_t maxArchives;
+    int retentionDays;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        maxArchives = maxArchives_;
+        retentionDays = retentionDays_;
+    }
+    if (maxArchives == 0 && retentionDays <= 0) {
+        return;
+    }
+
+    DIR* dir = opendir(directory_.c_str());
+    if (!dir) {
+        return;
+    }
+
+    // (날짜, 회전 순서, 경로) + mtime
+    std::vector<std::tuple<std::string, int, std::string, time_t>> archives;
+    while (struct dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        int index = rotationIndex(name);
+        if (index < 0 || isActive(name)) {
+            continue;
+        }
+        struct stat st;
+        std::string path = directory_ + "/" + name;
+        if (stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+            archives.emplace_back(name.substr(0, 10), index > 0 ? index : INT_MAX, path, st.st_mtime);
+        }
+    }
+    closedir(dir);
+
+    std::sort(archives.begin(), archives.end());
+    time_t cutoff = (retentionDays > 0) ? time(nullptr) - static_cast<time_t>(retentionDays) * 86400 : 0;
+    size_t remaining = archives.size();
+    for (const auto& archive : archives) {
+        const std::string& path = std::get<2>(archive);
+        bool tooMany = maxArchives > 0 && remaining > maxArchives;
+        bool tooOld = retentionDays > 0 && std::get<3>(archive) < cutoff;
+        if (!tooMany && !tooOld) {
+            continue;
+        }
+        if (unlink(path.c_str()) == 0) {
+            LOG_INFO("Log archive removed: %s", path.c_str());
+        }
+        remaining--;
+    }
+}
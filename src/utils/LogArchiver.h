@@ -0,0 +1,63 @@
+#ifndef LOG_ARCHIVER_H
+#define LOG_ARCHIVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+// 회전된 로그 파일 보관 처리 (Logger 전용 백그라운드 스레드)
+// - 기록 스레드가 넘긴 파일을 gzip(.gz)으로 압축하고 원본을 지운다
+// - 보관 파일 수 / 보관 기간을 넘는 오래된 로그를 지운다
+// - 시작 시 이전 실행에서 남은 (활성 파일이 아닌) 로그도 같은 방식으로 정리한다
+// 기록 스레드는 submit()으로 경로만 넘기고 기다리지 않는다
+class LogArchiver {
+public:
+    static constexpr size_t DEFAULT_MAX_ARCHIVES = 20;
+    static constexpr int DEFAULT_RETENTION_DAYS = 14;
+
+    LogArchiver();
+    ~LogArchiver();
+
+    void start(const std::string& directory);
+    void stop();
+
+    // compress: 압축 여부, maxArchives/retentionDays: 0이면 제한 없음
+    void setPolicy(bool compress, size_t maxArchives, int retentionDays);
+
+    // 현재 기록 중인 파일 이름 (정리 대상에서 제외)
+    void setActiveFiles(const std::set<std::string>& names);
+
+    // 회전된 파일 처리 요청
+    void submit(const std::string& path);
+
+    // 로그 파일 이름(YYYY-MM-DD[.N].log|.blog[.gz])의 회전 번호.
+    // 번호가 없는 파일(그날의 마지막 파일)은 0, 로그 파일이 아니면 -1
+    static int rotationIndex(const std::string& name);
+
+private:
+    void archiverThread();
+    void sweepDirectory();
+    bool compressFile(const std::string& path);
+    void applyRetention();
+    bool isActive(const std::string& name);
+
+private:
+    std::string directory_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::string> queue_;
+    std::set<std::string> activeNames_;
+    bool compress_;
+    size_t maxArchives_;
+    int retentionDays_;
+};
+
+#endif // LOG_ARCHIVER_H
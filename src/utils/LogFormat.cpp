@@ -0,0 +1,379 @@
+#include "LogFormat.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+namespace {
+    // 인자 읽기
+    struct Arg {
+        uint8_t tag = 0;
+        int64_t i = 0;
+        uint64_t u = 0;
+        double f = 0;
+        std::string s;
+    };
+
+    class ArgReader {
+    public:
+        ArgReader(const char* data, size_t size) : data_(data), size_(size), pos_(0) {}
+
+        bool next(Arg& arg) {
+            if (pos_ >= size_) {
+                return false;
+            }
+            arg.tag = static_cast<uint8_t>(data_[pos_]);
+            size_t remaining = size_ - pos_ - 1;
+            const char* value = data_ + pos_ + 1;
+            switch (arg.tag) {
+                case LogFormat::ARG_INT:
+                case LogFormat::ARG_UINT:
+                case LogFormat::ARG_POINTER:
+                case LogFormat::ARG_DOUBLE:
+                    if (remaining < 8) {
+                        return fail();
+                    }
+                    memcpy(&arg.u, value, 8);
+                    memcpy(&arg.i, value, 8);
+                    memcpy(&arg.f, value, 8);
+                    pos_ += 9;
+                    return true;
+                case LogFormat::ARG_STRING: {
+                    uint16_t length;
+                    if (remaining < 2) {
+                        return fail();
+                    }
+                    memcpy(&length, value, 2);
+                    if (remaining - 2 < length) {
+                        return fail();
+                    }
+                    arg.s.assign(value + 2, length);
+                    pos_ += 3 + length;
+                    return true;
+                }
+                default:
+                    return fail();
+            }
+        }
+
+    private:
+        bool fail() {
+            pos_ = size_;
+            return false;
+        }
+
+    private:
+        const char* data_;
+        size_t size_;
+        size_t pos_;
+    };
+
+    int64_t argAsInt(const Arg& arg) {
+        switch (arg.tag) {
+            case LogFormat::ARG_DOUBLE: return static_cast<int64_t>(arg.f);
+            case LogFormat::ARG_STRING: return 0;
+            default: return arg.i;
+        }
+    }
+
+    double argAsDouble(const Arg& arg) {
+        switch (arg.tag) {
+            case LogFormat::ARG_DOUBLE: return arg.f;
+            case LogFormat::ARG_INT: return static_cast<double>(arg.i);
+            case LogFormat::ARG_STRING: return 0;
+            default: return static_cast<double>(arg.u);
+        }
+    }
+
+    size_t append(char* out, size_t capacity, size_t length, const char* text, size_t textLength) {
+        size_t n = std::min(textLength, capacity - length);
+        memcpy(out + length, text, n);
+        return length + n;
+    }
+
+    // 변환 하나를 snprintf로 출력
+    template<typename T>
+    size_t appendFormatted(char* out, size_t capacity, size_t length, const char* spec, T value) {
+        if (length + 1 >= capacity) {
+            return length;
+        }
+        int written = snprintf(out + length, capacity - length, spec, value);
+        if (written < 0) {
+            return length;
+        }
+        return length + std::min(capacity - length - 1, static_cast<size_t>(written));
+    }
+
+    template<typename T>
+    void putLE(std::string& out, T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+namespace LogFormat {
+
+const char* levelName(uint8_t level) {
+    switch (level) {
+        case 0: return "TRACE";
+        case 1: return "DEBUG";
+        case 2: return "INFO ";
+        case 3: return "WARN ";
+        case 4: return "ERROR";
+        case 5: return "FATAL";
+        default: return "UNKNOWN";
+    }
+}
+
+size_t formatHeader(char* out, size_t capacity, uint8_t level, const char* file, int line,
+                    int64_t timestampNs) {
+    int64_t ms = timestampNs / 1000000;
+    time_t seconds = static_cast<time_t>(ms / 1000);
+
+    thread_local time_t cachedSecond = -1;
+    thread_local char cachedTime[32];
+    if (seconds != cachedSecond) {
+        struct tm timeinfo;
+        localtime_r(&seconds, &timeinfo);
+        strftime(cachedTime, sizeof(cachedTime), "%Y-%m-%d %H:%M:%S", &timeinfo);
+        cachedSecond = seconds;
+    }
+
+    int header = snprintf(out, capacity, "[%s.%03d] [%s] [%s:%d] ",
+                          cachedTime, static_cast<int>(ms % 1000), levelName(level), file, line);
+    return (header > 0) ? std::min(static_cast<size_t>(header), capacity - 1) : 0;
+}
+
+size_t renderMessage(char* out, size_t capacity, const char* format,
+                     const char* args, size_t argsLength) {
+    // 인자가 없는 호출은 포맷 문자열을 그대로 (텍스트 모드와 같음)
+    if (argsLength == 0) {
+        return append(out, capacity, 0, format, strlen(format));
+    }
+
+    ArgReader reader(args, argsLength);
+    size_t length = 0;
+    const char* p = format;
+    while (*p && length < capacity) {
+        if (*p != '%') {
+            const char* next = strchr(p, '%');
+            size_t n = next ? static_cast<size_t>(next - p) : strlen(p);
+            length = append(out, capacity, length, p, n);
+            p += n;
+            continue;
+        }
+        if (p[1] == '%') {
+            length = append(out, capacity, length, "%", 1);
+            p += 2;
+            continue;
+        }
+
+        // %[flags][width][.precision][length]conversion
+        // 정수는 길이 지정자대로 자른 뒤 long long으로 출력한다 (printf와 같은 결과)
+        std::string spec = "%";
+        const char* q = p + 1;
+        while (*q && strchr("-+ #0'", *q)) spec += *q++;
+        if (*q == '*') {
+            Arg width;
+            spec += std::to_string(reader.next(width) ? argAsInt(width) : 0);
+            q++;
+        }
+        while (*q >= '0' && *q <= '9') spec += *q++;
+        if (*q == '.') {
+            spec += *q++;
+            if (*q == '*') {
+                Arg precision;
+                spec += std::to_string(reader.next(precision) ? argAsInt(precision) : 0);
+                q++;
+            }
+            while (*q >= '0' && *q <= '9') spec += *q++;
+        }
+        std::string modifier;
+        while (*q && strchr("hlLqjzt", *q)) modifier += *q++;
+        bool wide = modifier.find_first_of("lLqjzt") != std::string::npos;
+        char conversion = *q;
+        if (!conversion) {
+            length = append(out, capacity, length, p, strlen(p));
+            break;
+        }
+        p = q + 1;
+
+        if (conversion == 'n') {
+            continue;
+        }
+
+        Arg arg;
+        if (!reader.next(arg)) {
+            length = append(out, capacity, length, "<?>", 3);
+            continue;
+        }
+
+        switch (conversion) {
+            case 'd': case 'i':
+                spec += "ll";
+                spec += conversion;
+                length = appendFormatted(out, capacity, length, spec.c_str(),
+                                         static_cast<long long>(
+                                             wide ? argAsInt(arg)
+                                             : modifier == "hh" ? static_cast<signed char>(argAsInt(arg))
+                                             : modifier == "h" ? static_cast<short>(argAsInt(arg))
+                                             : static_cast<int>(argAsInt(arg))));
+                break;
+            case 'o': case 'u': case 'x': case 'X':
+                spec += "ll";
+                spec += conversion;
+                length = appendFormatted(out, capacity, length, spec.c_str(),
+                                         static_cast<unsigned long long>(
+                                             wide ? static_cast<uint64_t>(argAsInt(arg))
+                                             : modifier == "hh" ? static_cast<unsigned char>(argAsInt(arg))
+                                             : modifier == "h" ? static_cast<unsigned short>(argAsInt(arg))
+                                             : static_cast<unsigned int>(argAsInt(arg))));
+                break;
+            case 'c':
+                spec += conversion;
+                length = appendFormatted(out, capacity, length, spec.c_str(),
+                                         static_cast<int>(argAsInt(arg)));
+                break;
+            case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+                spec += conversion;
+                length = appendFormatted(out, capacity, length, spec.c_str(), argAsDouble(arg));
+                break;
+            case 's':
+                spec += conversion;
+                length = appendFormatted(out, capacity, length, spec.c_str(),
+                                         arg.tag == ARG_STRING ? arg.s.c_str() : "<?>");
+                break;
+            case 'p':
+                spec += conversion;
+                length = appendFormatted(out, capacity, length, spec.c_str(),
+                                         reinterpret_cast<void*>(static_cast<uintptr_t>(arg.u)));
+                break;
+            default:
+                length = append(out, capacity, length, "<?>", 3);
+                break;
+        }
+    }
+    return length;
+}
+
+size_t encodeSession(char* out) {
+    out[0] = static_cast<char>(FRAME_SESSION);
+    memcpy(out + 1, MAGIC, sizeof(MAGIC));
+    memcpy(out + 5, &VERSION, sizeof(VERSION));
+    return SESSION_FRAME_SIZE;
+}
+
+std::string encodeSite(uint32_t siteId, uint8_t level, const char* file, int line,
+                       const char* format) {
+    uint16_t fileLength = static_cast<uint16_t>(std::min<size_t>(strlen(file), UINT16_MAX));
+    uint16_t formatLength = static_cast<uint16_t>(std::min<size_t>(strlen(format), UINT16_MAX));
+
+    std::string frame;
+    frame.reserve(14 + fileLength + formatLength);
+    frame += static_cast<char>(FRAME_SITE);
+    putLE(frame, siteId);
+    frame += static_cast<char>(level);
+    putLE(frame, static_cast<uint32_t>(line));
+    putLE(frame, fileLength);
+    frame.append(file, fileLength);
+    putLE(frame, formatLength);
+    frame.append(format, formatLength);
+    return frame;
+}
+
+size_t encodeRecord(char* out, size_t capacity, uint32_t siteId, int64_t timestampNs,
+                    const char* args, size_t argsLength) {
+    uint16_t length = static_cast<uint16_t>(
+        std::min(argsLength, std::min<size_t>(capacity - RECORD_HEADER_SIZE, UINT16_MAX)));
+    out[0] = static_cast<char>(FRAME_RECORD);
+    memcpy(out + 1, &siteId, sizeof(siteId));
+    memcpy(out + 5, &timestampNs, sizeof(timestampNs));
+    memcpy(out + 13, &length, sizeof(length));
+    if (length > 0) {
+        memcpy(out + RECORD_HEADER_SIZE, args, length);
+    }
+    return RECORD_HEADER_SIZE + length;
+}
+
+size_t Decoder::feed(const char* data, size_t size, const LineHandler& handler) {
+    size_t pos = 0;
+    char line[8192];
+
+    while (pos < size && error_.empty()) {
+        const char* frame = data + pos;
+        size_t remaining = size - pos;
+        uint8_t type = static_cast<uint8_t>(frame[0]);
+
+        if (type == FRAME_SESSION) {
+            if (remaining < SESSION_FRAME_SIZE) {
+                break;
+            }
+            uint16_t version;
+            memcpy(&version, frame + 5, sizeof(version));
+            if (memcmp(frame + 1, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION) {
+                error_ = "bad session header at offset " + std::to_string(pos);
+                break;
+            }
+            sites_.clear();
+            pos += SESSION_FRAME_SIZE;
+        } else if (type == FRAME_SITE) {
+            if (remaining < 12) {
+                break;
+            }
+            uint16_t fileLength;
+            memcpy(&fileLength, frame + 10, sizeof(fileLength));
+            if (remaining < 14u + fileLength) {
+                break;
+            }
+            uint16_t formatLength;
+            memcpy(&formatLength, frame + 12 + fileLength, sizeof(formatLength));
+            size_t frameSize = 14u + fileLength + formatLength;
+            if (remaining < frameSize) {
+                break;
+            }
+
+            uint32_t siteId;
+            Site site;
+            memcpy(&siteId, frame + 1, sizeof(siteId));
+            site.level = static_cast<uint8_t>(frame[5]);
+            memcpy(&site.line, frame + 6, sizeof(site.line));
+            site.file.assign(frame + 12, fileLength);
+            site.format.assign(frame + 14 + fileLength, formatLength);
+            sites_[siteId] = std::move(site);
+            pos += frameSize;
+        } else if (type == FRAME_RECORD) {
+            if (remaining < RECORD_HEADER_SIZE) {
+                break;
+            }
+            uint32_t siteId;
+            int64_t timestamp;
+            uint16_t argsLength;
+            memcpy(&siteId, frame + 1, sizeof(siteId));
+            memcpy(&timestamp, frame + 5, sizeof(timestamp));
+            memcpy(&argsLength, frame + 13, sizeof(argsLength));
+            size_t frameSize = RECORD_HEADER_SIZE + argsLength;
+            if (remaining < frameSize) {
+                break;
+            }
+
+            auto it = sites_.find(siteId);
+            size_t length;
+            if (it == sites_.end()) {
+                length = formatHeader(line, sizeof(line), UINT8_MAX, "?", 0, timestamp);
+                length += snprintf(line + length, sizeof(line) - length,
+                                   "<undefined log site %u>", siteId);
+            } else {
+                const Site& site = it->second;
+                length = formatHeader(line, sizeof(line), site.level, site.file.c_str(),
+                                      static_cast<int>(site.line), timestamp);
+                length += renderMessage(line + length, sizeof(line) - 1 - length,
+                                        site.format.c_str(), frame + RECORD_HEADER_SIZE, argsLength);
+            }
+            handler(line, length);
+            pos += frameSize;
+        } else {
+            error_ = "unknown frame type " + std::to_string(type) + " at offset " + std::to_string(pos);
+        }
+    }
+    return pos;
+}
+
+}  // namespace LogFormat
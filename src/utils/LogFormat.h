@@ -0,0 +1,162 @@
+#ifndef LOG_FORMAT_H
+#define LOG_FORMAT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "binary log format assumes a little-endian host"
+#endif
+
+// 로그 줄 포맷과 바이너리 로그 포맷 (Logger와 logdecode 도구가 함께 사용)
+//
+// 텍스트 줄: [YYYY-MM-DD HH:MM:SS.mmm] [LEVEL] [file:line] message
+//
+// 바이너리 로그 (리틀 엔디언, 프레임 연속)
+//   세션 프레임: 파일을 열 때마다 기록, 이후 사이트 ID 표를 새로 시작한다
+//     uint8    type           0
+//     char[4]  magic          "SCLG"
+//     uint16   version        1
+//
+//   사이트 프레임: 세션에서 처음 쓰이는 LOG_* 호출 위치마다 한 번
+//     uint8    type           1
+//     uint32   siteId
+//     uint8    level          LogLevel
+//     uint32   line
+//     uint16   fileLength,   char[fileLength]
+//     uint16   formatLength, char[formatLength]
+//
+//   레코드 프레임
+//     uint8    type           2
+//     uint32   siteId
+//     int64    timestamp      system_clock ns
+//     uint16   argsLength
+//     args     인자마다 uint8 태그 + 값
+//              'i' int64, 'u' uint64, 'f' float64, 'p' uint64(포인터), 's' uint16 길이 + 바이트
+//              인자가 없으면 포맷 문자열을 그대로 출력한다 (텍스트 모드와 같음)
+namespace LogFormat {
+    constexpr char MAGIC[4] = {'S', 'C', 'L', 'G'};
+    constexpr uint16_t VERSION = 1;
+
+    constexpr uint8_t FRAME_SESSION = 0;
+    constexpr uint8_t FRAME_SITE = 1;
+    constexpr uint8_t FRAME_RECORD = 2;
+
+    constexpr size_t SESSION_FRAME_SIZE = 7;
+    constexpr size_t RECORD_HEADER_SIZE = 15;
+
+    constexpr uint8_t ARG_INT = 'i';
+    constexpr uint8_t ARG_UINT = 'u';
+    constexpr uint8_t ARG_DOUBLE = 'f';
+    constexpr uint8_t ARG_POINTER = 'p';
+    constexpr uint8_t ARG_STRING = 's';
+
+    const char* levelName(uint8_t level);
+
+    // 줄 머리 "[time] [LEVEL] [file:line] " 포맷. 반환값은 줄바꿈 한 자리를 남긴 길이
+    // 날짜/시각 문자열은 스레드별로 초 단위 캐시
+    size_t formatHeader(char* out, size_t capacity, uint8_t level, const char* file, int line,
+                        int64_t timestampNs);
+
+    // 인코딩된 인자로 printf 형식 메시지를 렌더링 (줄바꿈 없음, 넘치면 자름)
+    size_t renderMessage(char* out, size_t capacity, const char* format,
+                         const char* args, size_t argsLength);
+
+    size_t encodeSession(char* out);
+    std::string encodeSite(uint32_t siteId, uint8_t level, const char* file, int line,
+                           const char* format);
+    // 레코드 프레임 (capacity를 넘는 인자는 자름). 반환값은 프레임 길이
+    size_t encodeRecord(char* out, size_t capacity, uint32_t siteId, int64_t timestampNs,
+                        const char* args, size_t argsLength);
+
+    // 인자 인코더 (호출 스레드의 스택 버퍼에 기록, 공간이 모자라면 이후 인자는 버림)
+    class ArgWriter {
+    public:
+        ArgWriter(char* out, size_t capacity) : out_(out), capacity_(capacity), used_(0) {}
+
+        template<typename T>
+        void put(T value) {
+            using Type = typename std::decay<T>::type;
+            if constexpr (std::is_same<Type, const char*>::value || std::is_same<Type, char*>::value) {
+                putString(value ? value : "(null)");
+            } else if constexpr (std::is_pointer<Type>::value || std::is_null_pointer<Type>::value) {
+                putValue(ARG_POINTER, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+            } else if constexpr (std::is_floating_point<Type>::value) {
+                putValue(ARG_DOUBLE, static_cast<double>(value));
+            } else if constexpr (std::is_enum<Type>::value) {
+                putValue(ARG_INT, static_cast<int64_t>(value));
+            } else if constexpr (std::is_integral<Type>::value && std::is_signed<Type>::value) {
+                putValue(ARG_INT, static_cast<int64_t>(value));
+            } else if constexpr (std::is_integral<Type>::value) {
+                putValue(ARG_UINT, static_cast<uint64_t>(value));
+            } else {
+                static_assert(std::is_arithmetic<Type>::value, "unsupported log argument type");
+            }
+        }
+
+        size_t size() const { return used_; }
+
+    private:
+        template<typename V>
+        void putValue(uint8_t tag, V value) {
+            if (used_ + 1 + sizeof(value) > capacity_) {
+                used_ = capacity_;
+                return;
+            }
+            out_[used_] = static_cast<char>(tag);
+            memcpy(out_ + used_ + 1, &value, sizeof(value));
+            used_ += 1 + sizeof(value);
+        }
+
+        void putString(const char* value) {
+            if (used_ + 3 > capacity_) {
+                used_ = capacity_;
+                return;
+            }
+            // strnlen에 남은 용량을 넘기면 짧은 리터럴에서 GCC가 -Wstringop-overread로 경고한다
+            size_t length = std::min(strlen(value), capacity_ - used_ - 3);
+            uint16_t length16 = static_cast<uint16_t>(length);
+            out_[used_] = static_cast<char>(ARG_STRING);
+            memcpy(out_ + used_ + 1, &length16, sizeof(length16));
+            memcpy(out_ + used_ + 3, value, length);
+            used_ += 3 + length;
+        }
+
+    private:
+        char* out_;
+        size_t capacity_;
+        size_t used_;
+    };
+
+    // 바이너리 로그 디코더 (프레임 단위 스트리밍)
+    class Decoder {
+    public:
+        using LineHandler = std::function<void(const char* line, size_t length)>;
+
+        // 완전한 프레임을 모두 처리하고 소비한 바이트 수를 반환한다
+        // (끝의 불완전한 프레임은 다음 호출에 이어서 넘긴다)
+        size_t feed(const char* data, size_t size, const LineHandler& handler);
+
+        bool failed() const { return !error_.empty(); }
+        const std::string& error() const { return error_; }
+
+    private:
+        struct Site {
+            uint8_t level;
+            uint32_t line;
+            std::string file;
+            std::string format;
+        };
+
+        std::unordered_map<uint32_t, Site> sites_;
+        std::string error_;
+    };
+}
+
+#endif // LOG_FORMAT_H
@@ -1,135 +1,884 @@
 #include "Logger.h"
+#include "LogArchiver.h"
 #include <iostream>
-#include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <algorithm>
+#include <cstring>
 #include <ctime>
-#include <cstdarg>
+#include <thread>
+#include <set>
+#include <vector>
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
+namespace {
+    // 레코드 한 개의 크기. 포맷된 줄이 넘치면 잘라서 기록한다
+    constexpr size_t RECORD_SIZE = 1024;
+    // writev 한 번에 모으는 레코드 수
+    constexpr size_t MAX_BATCH = 64;
+    // 기록 스레드가 알림 없이 대기하는 최대 시간
+    constexpr int WRITER_IDLE_WAIT_MS = 100;
+    // 초기화 전/종료 후의 activeLevel_ (어떤 레벨보다도 높음)
+    constexpr int LEVEL_OFF = static_cast<int>(LogLevel::FATAL) + 1;
+    // 스레드별 억제 카운트 슬롯 수
+    constexpr size_t SUPPRESSION_STAGE_SLOTS = 16;
+    
+    const char* getFileName(const char* path) {
+        const char* name = path;
+        for (const char* p = path; *p; p++) {
+            if (*p == '/' || *p == '\\') {
+                name = p + 1;
+            }
+        }
+        return name;
+    }
+    
+    // 속도 제한 구간 (단조 시각, 초)
+    uint32_t monotonicSeconds() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+        return static_cast<uint32_t>(ts.tv_sec);
+    }
+    
+    int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    
+    // 로그 포맷: [YYYY-MM-DD HH:MM:SS.mmm] [LEVEL] [file:line] message\n
+    size_t formatHeader(char* out, size_t capacity, LogLevel level, const char* file, int line) {
+        return LogFormat::formatHeader(out, capacity, static_cast<uint8_t>(level), file, line, nowNs());
+    }
+    
+    // 메시지와 줄바꿈을 붙인다. 넘치면 잘라서 "..."으로 표시
+    size_t appendMessage(char* out, size_t length, size_t capacity,
+                         const char* message, size_t messageLength) {
+        size_t room = capacity - 1 - length;
+        if (messageLength > room) {
+            size_t keep = (room > 3) ? room - 3 : 0;
+            memcpy(out + length, message, keep);
+            memcpy(out + length + keep, "...", room - keep);
+            length += room;
+        } else {
+            memcpy(out + length, message, messageLength);
+            length += messageLength;
+        }
+        out[length++] = '\n';
+        return length;
+    }
+    
+    // printf 형식 메시지를 레코드에 바로 포맷한다
+    size_t appendFormat(char* out, size_t length, size_t capacity, const char* format, va_list args) {
+        size_t room = capacity - 1 - length;
+        int written = vsnprintf(out + length, room + 1, format, args);
+        size_t messageLength = (written > 0) ? static_cast<size_t>(written) : 0;
+        if (messageLength > room) {
+            size_t mark = std::min<size_t>(3, room);
+            memcpy(out + length + room - mark, "...", mark);
+            messageLength = room;
+        }
+        length += messageLength;
+        out[length++] = '\n';
+        return length;
+    }
+    
+    size_t formatRecord(char* out, size_t capacity, LogLevel level, const char* file, int line,
+                        const char* message, size_t messageLength) {
+        size_t length = formatHeader(out, capacity, level, file, line);
+        return appendMessage(out, length, capacity, message, messageLength);
+    }
+    
+    // iovec 전체를 기록 (부분 기록, EINTR 처리). 반환값은 기록한 바이트 수
+    size_t writeAll(int fd, struct iovec* iov, int count) {
+        size_t total = 0;
+        while (count > 0) {
+            ssize_t written = writev(fd, iov, count);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return total;
+            }
+            
+            total += static_cast<size_t>(written);
+            size_t remaining = static_cast<size_t>(written);
+            while (count > 0 && remaining >= iov->iov_len) {
+                remaining -= iov->iov_len;
+                iov++;
+                count--;
+            }
+            if (count > 0) {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + remaining;
+                iov->iov_len -= remaining;
+            }
+        }
+        return total;
+    }
+}
+
+// 비동기 로거
+// - 로그를 남기는 스레드는 링의 슬롯을 CAS로 예약해 그 자리에 완성된 줄을 포맷하고
+//   시퀀스 번호로 게시만 한다 (잠금/파일 I/O 없음, 다중 생산자 단일 소비자 링)
+// - 기록 스레드 하나가 게시된 레코드를 순서대로 모아 파일/콘솔에 writev로 일괄 기록한다
+// - 링이 가득 차면 정책에 따라 버리거나(DROP) 자리가 빌 때까지 기다린다(BLOCK).
+//   FATAL은 항상 기다리고, 기록까지 마친 뒤 반환한다
 class Logger::Impl {
 public:
-    Impl() : logLevel_(LogLevel::INFO), isInitialized_(false) {}
+    Impl()
+        : logLevel_(static_cast<int>(LogLevel::INFO))
+        , policy_(static_cast<int>(LogOverflowPolicy::DROP))
+        , isInitialized_(false)
+        , writerRunning_(false)
+        , writerSleeping_(false)
+        , stopping_(false)
+        , flushWaiters_(0)
+        , enqueuePos_(0)
+        , writtenPos_(0)
+        , dropped_(0)
+        , capacity_(0)
+        , mask_(0)
+        , dequeuePos_(0)
+        , reportedDropped_(0)
+        , maxFileSize_(LogRotationPolicy().maxFileSize)
+        , lastDayCheck_(0)
+        , today_(0) {
+        todayName_[0] = '\0';
+    }
     
     ~Impl() {
-        if (fileStream_.is_open()) {
-            fileStream_.close();
-        }
+        close();
     }
     
-    bool init(const std::string& logPath, LogLevel level) {
+    bool init(const std::string& directory, LogLevel level, size_t queueCapacity) {
+        close();
+        
         std::lock_guard<std::mutex> lock(mutex_);
         
-        logLevel_ = level;
-        logPath_ = logPath;
+        logLevel_.store(static_cast<int>(level), std::memory_order_relaxed);
+        directory_ = directory;
         
         // 로그 디렉토리 생성
-        size_t pos = logPath.find_last_of("/\\");
-        if (pos != std::string::npos) {
-            std::string dir = logPath.substr(0, pos);
-            mkdir(dir.c_str(), 0755);
-        }
+        mkdir(directory.c_str(), 0755);
         
-        // 파일 열기
-        fileStream_.open(logPath, std::ios::app);
-        if (!fileStream_.is_open()) {
-            std::cerr << "Failed to open log file: " << logPath << std::endl;
+        // 날짜별 로그 파일 열기 (바이너리 파일은 첫 바이너리 레코드에서 연다)
+        lastDayCheck_ = 0;
+        updateToday();
+        if (!openFile(textFile_)) {
+            std::cerr << "Failed to open log file: " << directory_ << "/" << textFile_.name << std::endl;
             return false;
         }
+        archiver_.start(directory_);
         
-        isInitialized_ = true;
+        // 링 생성 (용량은 2의 거듭제곱으로 올림)
+        size_t capacity = 2;
+        while (capacity < queueCapacity) {
+            capacity <<= 1;
+        }
+        capacity_ = capacity;
+        mask_ = capacity - 1;
+        ring_.reset(new Record[capacity]);
+        for (size_t i = 0; i < capacity; i++) {
+            ring_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueuePos_.store(0, std::memory_order_relaxed);
+        writtenPos_.store(0, std::memory_order_relaxed);
+        dequeuePos_ = 0;
+        dropped_.store(0, std::memory_order_relaxed);
+        reportedDropped_ = 0;
+        
+        Logger::rateWindow_.store(monotonicSeconds(), std::memory_order_relaxed);
+        stopping_.store(false);
+        writerRunning_.store(true);
+        writer_ = std::thread(&Impl::writerThread, this);
+        
+        isInitialized_.store(true, std::memory_order_release);
+        Logger::activeLevel_.store(static_cast<int>(level), std::memory_order_relaxed);
         return true;
     }
     
-    void log(LogLevel level, const std::string& file, int line, const std::string& message) {
-        if (!isInitialized_ || level < logLevel_) {
+    void log(LogLevel level, const char* file, int line, const char* message, size_t messageLength) {
+        uint64_t pos;
+        Record* record = beginRecord(level, pos);
+        if (!record) {
+            return;
+        }
+        
+        size_t length = formatHeader(record->text, sizeof(record->text), level, getFileName(file), line);
+        length = appendMessage(record->text, length, sizeof(record->text), message, messageLength);
+        commitRecord(record, pos, level, length);
+    }
+    
+    void logv(LogLevel level, const char* file, int line, const char* format, va_list args) {
+        uint64_t pos;
+        Record* record = beginRecord(level, pos);
+        if (!record) {
+            return;
+        }
+        
+        size_t length = formatHeader(record->text, sizeof(record->text), level, getFileName(file), line);
+        length = appendFormat(record->text, length, sizeof(record->text), format, args);
+        commitRecord(record, pos, level, length);
+    }
+    
+    void logBinary(LogSite& site, const char* args, size_t argsLength) {
+        uint32_t siteId = site.id.load(std::memory_order_acquire);
+        if (siteId == 0) {
+            siteId = registerSite(site);
+        }
+        
+        uint64_t pos;
+        Record* record = beginRecord(site.level, pos);
+        if (!record) {
             return;
         }
         
+        record->binary = 1;
+        size_t length = LogFormat::encodeRecord(record->text, sizeof(record->text), siteId, nowNs(),
+                                                args, argsLength);
+        commitRecord(record, pos, site.level, length);
+    }
+    
+    void setLogLevel(LogLevel level) {
         std::lock_guard<std::mutex> lock(mutex_);
+        logLevel_.store(static_cast<int>(level), std::memory_order_relaxed);
+        if (isInitialized_.load(std::memory_order_relaxed)) {
+            Logger::activeLevel_.store(static_cast<int>(level), std::memory_order_relaxed);
+        }
+    }
+    
+    void setOverflowPolicy(LogOverflowPolicy policy) {
+        policy_.store(static_cast<int>(policy), std::memory_order_relaxed);
+    }
+    
+    void setRotationPolicy(const LogRotationPolicy& policy) {
+        maxFileSize_.store(policy.maxFileSize, std::memory_order_relaxed);
+        archiver_.setPolicy(policy.compress, policy.maxArchives, policy.retentionDays);
+    }
+    
+    uint64_t getDroppedCount() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+    
+    // 스레드별 억제 카운트 등록/해제 (기록 스레드가 구간마다 거둬 간다)
+    void addStage(SuppressionStage* stage) {
+        std::lock_guard<std::mutex> lock(stagesMutex_);
+        stages_.push_back(stage);
+    }
+    
+    void removeStage(SuppressionStage* stage) {
+        std::lock_guard<std::mutex> lock(stagesMutex_);
+        stages_.erase(std::remove(stages_.begin(), stages_.end(), stage), stages_.end());
+    }
+    
+    // 모든 스레드의 억제 카운트를 호출 위치에 반영 (SuppressionStage 정의 뒤에 구현)
+    void collectSuppressed();
+    
+    // 처음 억제된 호출 위치 등록 (위치마다 한 번)
+    void trackSuppressed(LogSite& site) {
+        std::lock_guard<std::mutex> lock(sitesMutex_);
+        suppressedSites_.push_back(&site);
+    }
+    
+    uint64_t getSuppressedCount() const {
+        std::lock_guard<std::mutex> lock(sitesMutex_);
+        uint64_t total = 0;
+        for (const LogSite* site : suppressedSites_) {
+            total += site->suppressedTotal.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+    
+    std::vector<LogSuppression> getSuppressionStats() const {
+        std::vector<LogSuppression> stats;
+        {
+            std::lock_guard<std::mutex> lock(sitesMutex_);
+            stats.reserve(suppressedSites_.size());
+            for (const LogSite* site : suppressedSites_) {
+                stats.push_back({getFileName(site->file), site->line, site->level, site->format,
+                                 site->suppressedTotal.load(std::memory_order_relaxed)});
+            }
+        }
+        std::sort(stats.begin(), stats.end(), [](const LogSuppression& a, const LogSuppression& b) {
+            return a.suppressed > b.suppressed;
+        });
+        return stats;
+    }
+    
+    void flush() {
+        uint64_t target = enqueuePos_.load(std::memory_order_acquire);
         
-        // 타임스탬프 생성
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()) % 1000;
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        flushWaiters_.fetch_add(1);
+        writerCv_.notify_one();
+        flushCv_.wait(lock, [&]() {
+            return writtenPos_.load() >= target || !writerRunning_.load();
+        });
+        flushWaiters_.fetch_sub(1);
+    }
+    
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
         
-        struct tm timeinfo;
-        localtime_r(&time_t, &timeinfo);
+        Logger::activeLevel_.store(LEVEL_OFF, std::memory_order_relaxed);
+        isInitialized_.store(false, std::memory_order_release);
+        if (writer_.joinable()) {
+            {
+                std::lock_guard<std::mutex> wakeLock(wakeMutex_);
+                stopping_.store(true);
+                writerCv_.notify_one();
+            }
+            writer_.join();
+        }
+        
+        {
+            std::lock_guard<std::mutex> wakeLock(wakeMutex_);
+            writerRunning_.store(false);
+            flushCv_.notify_all();
+        }
+        
+        closeFile(textFile_);
+        closeFile(binaryFile_);
+        archiver_.stop();
+    }
+
+private:
+    // 날짜별 로그 파일 (기록 스레드 전용)
+    struct LogFile {
+        explicit LogFile(const char* ext) : extension(ext) {}
         
-        // 로그 포맷: [YYYY-MM-DD HH:MM:SS.mmm] [LEVEL] [file:line] message
-        std::ostringstream oss;
-        oss << "[" << std::put_time(&timeinfo, "%Y-%m-%d %H:%M:%S")
-            << "." << std::setfill('0') << std::setw(3) << ms.count() << "] "
-            << "[" << levelToString(level) << "] "
-            << "[" << getFileName(file) << ":" << line << "] "
-            << message;
+        const char* extension;
+        int fd = -1;
+        uint64_t size = 0;
+        int day = 0;
+        std::string name;  // 디렉토리를 뺀 파일 이름
         
-        std::string logLine = oss.str();
+        // 마지막으로 쓴 크기 회전 번호 (보관 정리로 지워진 번호도 다시 쓰지 않도록 기억)
+        int rotationDay = 0;
+        int lastRotation = 0;
+    };
+    
+    struct alignas(64) Record {
+        std::atomic<uint64_t> sequence;  // pos: 비어 있음, pos + 1: 게시됨
+        uint16_t length;
+        uint8_t level;
+        uint8_t binary;                  // text가 바이너리 레코드 프레임인지
+        char text[RECORD_SIZE - 16];
+    };
+    
+    // 레벨 검사 후 슬롯 예약. 기록하지 않을 레코드면 nullptr
+    Record* beginRecord(LogLevel level, uint64_t& pos) {
+        if (!isInitialized_.load(std::memory_order_acquire) || !Logger::isEnabled(level)) {
+            return nullptr;
+        }
         
-        // 파일과 콘솔에 출력
-        if (fileStream_.is_open()) {
-            fileStream_ << logLine << std::endl;
-            fileStream_.flush();
+        bool block = (level == LogLevel::FATAL) ||
+                     policy_.load(std::memory_order_relaxed) == static_cast<int>(LogOverflowPolicy::BLOCK);
+        Record* record = reserve(block, pos);
+        if (!record) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
         }
+        record->level = static_cast<uint8_t>(level);
+        record->binary = 0;
+        return record;
+    }
+    
+    // 포맷을 마친 레코드를 게시
+    void commitRecord(Record* record, uint64_t pos, LogLevel level, size_t length) {
+        record->length = static_cast<uint16_t>(length);
+        record->sequence.store(pos + 1, std::memory_order_release);
+        wakeWriter();
         
-        // 콘솔 출력 (ERROR 이상만)
-        if (level >= LogLevel::ERROR) {
-            std::cerr << logLine << std::endl;
-        } else if (level >= LogLevel::INFO) {
-            std::cout << logLine << std::endl;
+        if (level == LogLevel::FATAL) {
+            flush();
         }
     }
     
-    void setLogLevel(LogLevel level) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        logLevel_ = level;
+    // 호출 위치에 ID 부여 (위치마다 처음 한 번)
+    uint32_t registerSite(LogSite& site) {
+        std::lock_guard<std::mutex> lock(sitesMutex_);
+        uint32_t siteId = site.id.load(std::memory_order_relaxed);
+        if (siteId == 0) {
+            sites_.push_back(&site);
+            siteId = static_cast<uint32_t>(sites_.size());
+            site.id.store(siteId, std::memory_order_release);
+        }
+        return siteId;
     }
     
-    void flush() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (fileStream_.is_open()) {
-            fileStream_.flush();
+    // 슬롯 예약. DROP 정책에서 링이 가득 차면 nullptr
+    Record* reserve(bool block, uint64_t& pos) {
+        pos = enqueuePos_.load(std::memory_order_relaxed);
+        int spins = 0;
+        for (;;) {
+            Record& record = ring_[pos & mask_];
+            uint64_t sequence = record.sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return &record;
+                }
+            } else if (diff < 0) {
+                // 가득 참: 기록 스레드가 슬롯을 비울 때까지
+                if (!block || !writerRunning_.load(std::memory_order_relaxed)) {
+                    return nullptr;
+                }
+                wakeWriter();
+                if (++spins < 16) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
         }
     }
     
-    void close() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (fileStream_.is_open()) {
-            fileStream_.close();
+    // 기록 스레드가 대기 중일 때만 깨운다
+    void wakeWriter() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (writerSleeping_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            writerCv_.notify_one();
         }
-        isInitialized_ = false;
     }
     
-private:
-    std::string levelToString(LogLevel level) {
-        switch (level) {
-            case LogLevel::TRACE: return "TRACE";
-            case LogLevel::DEBUG: return "DEBUG";
-            case LogLevel::INFO:  return "INFO ";
-            case LogLevel::WARNING: return "WARN ";
-            case LogLevel::ERROR: return "ERROR";
-            case LogLevel::FATAL: return "FATAL";
-            default: return "UNKNOWN";
+    bool hasPublished() const {
+        const Record& record = ring_[dequeuePos_ & mask_];
+        return record.sequence.load(std::memory_order_acquire) == dequeuePos_ + 1;
+    }
+    
+    void writerThread() {
+        struct iovec fileIov[MAX_BATCH];
+        struct iovec binaryIov[MAX_BATCH];
+        struct iovec outIov[MAX_BATCH];
+        struct iovec errIov[MAX_BATCH];
+        std::unique_ptr<char[]> consoleText(new char[MAX_BATCH * RECORD_SIZE]);
+        
+        for (;;) {
+            // 속도 제한 구간 갱신, 지난 구간의 억제 수 요약
+            uint32_t window = monotonicSeconds();
+            if (window != Logger::rateWindow_.load(std::memory_order_relaxed)) {
+                Logger::rateWindow_.store(window, std::memory_order_relaxed);
+                collectSuppressed();
+                reportSuppressed();
+            }
+            
+            // 날짜/크기 회전은 새 레코드를 쓰기 전에 (호출 스레드는 관여하지 않음)
+            if (hasPublished()) {
+                checkRotation();
+            }
+            
+            // 게시된 레코드를 순서대로 모은다
+            size_t count = 0;
+            int fileCount = 0;
+            int binaryCount = 0;
+            int outCount = 0;
+            int errCount = 0;
+            while (count < MAX_BATCH) {
+                Record& record = ring_[(dequeuePos_ + count) & mask_];
+                if (record.sequence.load(std::memory_order_acquire) != dequeuePos_ + count + 1) {
+                    break;
+                }
+                struct iovec iov = {record.text, record.length};
+                if (record.binary) {
+                    prepareBinaryRecord(record);
+                    binaryIov[binaryCount++] = iov;
+                    
+                    // 콘솔로 나갈 레코드만 여기서 텍스트로 만든다
+                    if (record.level >= static_cast<uint8_t>(LogLevel::INFO)) {
+                        char* line = consoleText.get() + count * RECORD_SIZE;
+                        iov.iov_base = line;
+                        iov.iov_len = renderBinaryRecord(record, line, RECORD_SIZE);
+                    }
+                } else {
+                    fileIov[fileCount++] = iov;
+                }
+                
+                // 콘솔 출력 (ERROR 이상은 stderr, INFO 이상은 stdout)
+                if (record.level >= static_cast<uint8_t>(LogLevel::ERROR)) {
+                    errIov[errCount++] = iov;
+                } else if (record.level >= static_cast<uint8_t>(LogLevel::INFO)) {
+                    outIov[outCount++] = iov;
+                }
+                count++;
+            }
+            
+            if (count > 0) {
+                textFile_.size += writeAll(textFile_.fd, fileIov, fileCount);
+                binaryFile_.size += writeAll(binaryFile_.fd, binaryIov, binaryCount);
+                writeAll(STDOUT_FILENO, outIov, outCount);
+                writeAll(STDERR_FILENO, errIov, errCount);
+                
+                // 슬롯 반환
+                for (size_t i = 0; i < count; i++) {
+                    uint64_t pos = dequeuePos_ + i;
+                    ring_[pos & mask_].sequence.store(pos + capacity_, std::memory_order_release);
+                }
+                dequeuePos_ += count;
+                writtenPos_.store(dequeuePos_);
+                
+                if (flushWaiters_.load() > 0) {
+                    std::lock_guard<std::mutex> lock(wakeMutex_);
+                    flushCv_.notify_all();
+                }
+                continue;
+            }
+            
+            reportDropped();
+            
+            if (stopping_.load()) {
+                collectSuppressed();
+                reportSuppressed();
+                break;
+            }
+            
+            // 대기 (게시 직후 깨어나도록 플래그를 먼저 세우고 다시 확인)
+            writerSleeping_.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> lock(wakeMutex_);
+                writerCv_.wait_for(lock, std::chrono::milliseconds(WRITER_IDLE_WAIT_MS), [&]() {
+                    return stopping_.load() || hasPublished();
+                });
+            }
+            writerSleeping_.store(false);
         }
     }
     
-    std::string getFileName(const std::string& path) {
-        size_t pos = path.find_last_of("/\\");
-        return (pos != std::string::npos) ? path.substr(pos + 1) : path;
+    // 바이너리 파일을 (처음이면) 열고, 세션에서 처음 쓰이는 호출 위치면 사이트 프레임을 먼저 쓴다
+    void prepareBinaryRecord(const Record& record) {
+        if (binaryFile_.fd < 0) {
+            if (!openFile(binaryFile_)) {
+                return;
+            }
+            char session[LogFormat::SESSION_FRAME_SIZE];
+            struct iovec iov = {session, LogFormat::encodeSession(session)};
+            binaryFile_.size += writeAll(binaryFile_.fd, &iov, 1);
+            definedSites_.clear();
+        }
+        
+        uint32_t siteId;
+        memcpy(&siteId, record.text + 1, sizeof(siteId));
+        if (siteId < definedSites_.size() && definedSites_[siteId]) {
+            return;
+        }
+        const LogSite* site = siteFor(siteId);
+        if (!site) {
+            return;
+        }
+        std::string frame = LogFormat::encodeSite(siteId, static_cast<uint8_t>(site->level),
+                                                  getFileName(site->file), site->line, site->format);
+        struct iovec iov = {&frame[0], frame.size()};
+        binaryFile_.size += writeAll(binaryFile_.fd, &iov, 1);
+        if (siteId >= definedSites_.size()) {
+            definedSites_.resize(siteId + 1, false);
+        }
+        definedSites_[siteId] = true;
     }
     
+    // 바이너리 레코드를 텍스트 줄로 (콘솔 출력용)
+    size_t renderBinaryRecord(const Record& record, char* out, size_t capacity) {
+        uint32_t siteId;
+        int64_t timestamp;
+        uint16_t argsLength;
+        memcpy(&siteId, record.text + 1, sizeof(siteId));
+        memcpy(&timestamp, record.text + 5, sizeof(timestamp));
+        memcpy(&argsLength, record.text + 13, sizeof(argsLength));
+        
+        const LogSite* site = siteFor(siteId);
+        if (!site) {
+            return 0;
+        }
+        size_t length = LogFormat::formatHeader(out, capacity, record.level, getFileName(site->file),
+                                                site->line, timestamp);
+        length += LogFormat::renderMessage(out + length, capacity - 1 - length, site->format,
+                                           record.text + LogFormat::RECORD_HEADER_SIZE, argsLength);
+        out[length++] = '\n';
+        return length;
+    }
+    
+    // 기록 스레드의 사이트 표 사본 (모르는 ID일 때만 잠금)
+    const LogSite* siteFor(uint32_t siteId) {
+        if (siteId == 0) {
+            return nullptr;
+        }
+        if (siteId > writerSites_.size()) {
+            std::lock_guard<std::mutex> lock(sitesMutex_);
+            writerSites_ = sites_;
+        }
+        return (siteId <= writerSites_.size()) ? writerSites_[siteId - 1] : nullptr;
+    }
+    
+    // 버려진 레코드가 늘었으면 파일에 한 줄 남긴다
+    void reportDropped() {
+        uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped == reportedDropped_) {
+            return;
+        }
+        
+        char message[96];
+        int messageLength = snprintf(message, sizeof(message),
+                                     "Log queue full, dropped %llu records",
+                                     static_cast<unsigned long long>(dropped - reportedDropped_));
+        char line[256];
+        size_t length = formatRecord(line, sizeof(line), LogLevel::WARNING, "Logger.cpp", __LINE__,
+                                     message, static_cast<size_t>(messageLength));
+        struct iovec iov = {line, length};
+        textFile_.size += writeAll(textFile_.fd, &iov, 1);
+        reportedDropped_ = dropped;
+    }
+    
+    // 억제된 레코드가 있는 호출 위치마다 그 위치의 레벨로 요약 한 줄을 남긴다
+    void reportSuppressed() {
+        {
+            std::lock_guard<std::mutex> lock(sitesMutex_);
+            writerSuppressedSites_ = suppressedSites_;
+        }
+        
+        for (LogSite* site : writerSuppressedSites_) {
+            uint64_t suppressed = site->suppressed.exchange(0, std::memory_order_relaxed);
+            if (suppressed == 0) {
+                continue;
+            }
+            
+            char message[96];
+            int messageLength = snprintf(message, sizeof(message),
+                                         "Suppressed %llu messages from this call site",
+                                         static_cast<unsigned long long>(suppressed));
+            char line[512];
+            size_t length = formatRecord(line, sizeof(line), site->level, getFileName(site->file),
+                                         site->line, message, static_cast<size_t>(messageLength));
+            struct iovec iov = {line, length};
+            textFile_.size += writeAll(textFile_.fd, &iov, 1);
+            if (site->level >= LogLevel::ERROR) {
+                iov = {line, length};
+                writeAll(STDERR_FILENO, &iov, 1);
+            } else if (site->level >= LogLevel::INFO) {
+                iov = {line, length};
+                writeAll(STDOUT_FILENO, &iov, 1);
+            }
+        }
+    }
+    
+    // 로컬 날짜 갱신 (초 단위로만 계산)
+    void updateToday() {
+        time_t now = time(nullptr);
+        if (now == lastDayCheck_) {
+            return;
+        }
+        lastDayCheck_ = now;
+        
+        struct tm timeinfo;
+        localtime_r(&now, &timeinfo);
+        int today = (timeinfo.tm_year + 1900) * 10000 + (timeinfo.tm_mon + 1) * 100 + timeinfo.tm_mday;
+        if (today == today_) {
+            return;
+        }
+        today_ = today;
+        strftime(todayName_, sizeof(todayName_), "%Y-%m-%d", &timeinfo);
+        
+        // 오늘 날짜 파일은 보관 정리 대상에서 제외
+        std::string name = todayName_;
+        archiver_.setActiveFiles({name + textFile_.extension, name + binaryFile_.extension});
+    }
+    
+    // 오늘 날짜 파일 열기 (이어 쓰기)
+    bool openFile(LogFile& file) {
+        file.name = std::string(todayName_) + file.extension;
+        std::string path = directory_ + "/" + file.name;
+        file.fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (file.fd < 0) {
+            return false;
+        }
+        struct stat st;
+        file.size = (fstat(file.fd, &st) == 0) ? static_cast<uint64_t>(st.st_size) : 0;
+        file.day = today_;
+        return true;
+    }
+    
+    void closeFile(LogFile& file) {
+        if (file.fd >= 0) {
+            ::close(file.fd);
+            file.fd = -1;
+        }
+    }
+    
+    void checkRotation() {
+        updateToday();
+        if (rotateIfNeeded(textFile_) && !openFile(textFile_)) {
+            std::cerr << "Failed to open log file: " << directory_ << "/" << textFile_.name << std::endl;
+        }
+        // 바이너리 파일은 다음 바이너리 레코드에서 새로 연다 (세션 프레임부터)
+        rotateIfNeeded(binaryFile_);
+    }
+    
+    // 날짜가 바뀌었거나 크기 제한을 넘은 파일을 닫고 보관 처리로 넘긴다
+    // 같은 날 크기 회전은 <날짜>.N<확장자>로 이름을 바꾼 뒤 넘긴다
+    bool rotateIfNeeded(LogFile& file) {
+        if (file.fd < 0) {
+            return false;
+        }
+        uint64_t maxFileSize = maxFileSize_.load(std::memory_order_relaxed);
+        bool newDay = file.day != today_;
+        if (!newDay && (maxFileSize == 0 || file.size < maxFileSize)) {
+            return false;
+        }
+        
+        std::string path = directory_ + "/" + file.name;
+        if (!newDay) {
+            int index = nextRotationIndex(file);
+            std::string rotated = directory_ + "/" + todayName_ + "." + std::to_string(index) + file.extension;
+            if (rename(path.c_str(), rotated.c_str()) != 0) {
+                // 이름을 바꿀 수 없으면 같은 파일에 계속 쓴다
+                file.size = 0;
+                return false;
+            }
+            file.rotationDay = today_;
+            file.lastRotation = index;
+            path = rotated;
+        }
+        
+        closeFile(file);
+        archiver_.submit(path);
+        return true;
+    }
+    
+    // 오늘 회전 번호 = 디렉토리에 남은 가장 큰 번호와 이번 실행에서 쓴 번호 중 큰 값 + 1
+    // 번호가 회전 순서를 따라야 보관 정리가 오래된 파일부터 지운다
+    int nextRotationIndex(const LogFile& file) {
+        int highest = (file.rotationDay == today_) ? file.lastRotation : 0;
+        std::string prefix = std::string(todayName_) + ".";
+        DIR* dir = opendir(directory_.c_str());
+        if (dir) {
+            while (struct dirent* entry = readdir(dir)) {
+                std::string name = entry->d_name;
+                if (name.compare(0, prefix.size(), prefix) != 0) {
+                    continue;
+                }
+                int index = LogArchiver::rotationIndex(name);
+                std::string base = std::to_string(index) + file.extension;
+                if (index > highest && name.compare(prefix.size(), base.size(), base) == 0 &&
+                    (name.size() == prefix.size() + base.size() ||
+                     name.compare(prefix.size() + base.size(), std::string::npos, ".gz") == 0)) {
+                    highest = index;
+                }
+            }
+            closedir(dir);
+        }
+        return highest + 1;
+    }
+
 private:
-    std::mutex mutex_;
-    std::ofstream fileStream_;
-    std::string logPath_;
-    LogLevel logLevel_;
-    bool isInitialized_;
+    std::mutex mutex_;  // init/close 직렬화
+    std::string directory_;
+    std::atomic<int> logLevel_;
+    std::atomic<int> policy_;
+    std::atomic<bool> isInitialized_;
+    
+    // 기록 스레드 대기/flush 알림
+    std::mutex wakeMutex_;
+    std::condition_variable writerCv_;
+    std::condition_variable flushCv_;
+    std::atomic<bool> writerRunning_;
+    std::atomic<bool> writerSleeping_;
+    std::atomic<bool> stopping_;
+    std::atomic<int> flushWaiters_;
+    std::thread writer_;
+    
+    // 생산자 공유 (캐시 라인 분리)
+    alignas(64) std::atomic<uint64_t> enqueuePos_;
+    alignas(64) std::atomic<uint64_t> writtenPos_;
+    std::atomic<uint64_t> dropped_;
+    
+    // 호출 위치 ID 표 (바이너리 모드)
+    mutable std::mutex sitesMutex_;
+    std::vector<const LogSite*> sites_;
+    
+    // 기록 스레드 전용
+    alignas(64) std::unique_ptr<Record[]> ring_;
+    size_t capacity_;
+    size_t mask_;
+    uint64_t dequeuePos_;
+    uint64_t reportedDropped_;
+    LogFile textFile_{".log"};
+    LogFile binaryFile_{".blog"};
+    std::atomic<uint64_t> maxFileSize_;
+    LogArchiver archiver_;
+    time_t lastDayCheck_;
+    int today_;                       // YYYYMMDD
+    char todayName_[16];              // YYYY-MM-DD
+    std::vector<const LogSite*> writerSites_;
+    std::vector<LogSite*> suppressedSites_;      // sitesMutex_
+    std::mutex stagesMutex_;                     // 순서: stagesMutex_ → 스테이지 mutex → sitesMutex_
+    std::vector<SuppressionStage*> stages_;      // stagesMutex_
+    std::vector<LogSite*> writerSuppressedSites_;
+    std::vector<bool> definedSites_;  // 현재 바이너리 파일에 사이트 프레임을 쓴 ID
+};
+
+// 스레드별 억제 카운트 (호출 위치 주소로 슬롯을 고르는 직접 사상 표)
+// 폭주 중인 호출 위치의 공유 카운터에 매 호출마다 쓰지 않고 자기 스레드의 슬롯만 올린다.
+// 기록 스레드가 속도 제한 구간이 바뀔 때마다 모든 스테이지를 거둬 호출 위치에 반영하므로
+// 억제 수는 늦어도 다음 구간 요약에 들어간다. 스레드가 끝날 때 남은 몫도 반영한다
+// 슬롯의 호출 위치는 소유 스레드만 바꾸고, 바꿀 때와 거둘 때만 mutex를 잡는다 (카운트 증가는 잠금 없음)
+struct Logger::SuppressionStage {
+    struct Slot {
+        std::atomic<LogSite*> site{nullptr};
+        std::atomic<uint64_t> count{0};
+    };
+    
+    Slot slots[SUPPRESSION_STAGE_SLOTS];
+    std::mutex mutex;
+    
+    SuppressionStage() {
+        Logger::getInstance().pImpl->addStage(this);
+    }
+    
+    ~SuppressionStage() {
+        Logger::getInstance().pImpl->removeStage(this);
+        collect();
+    }
+    
+    void collect() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Slot& slot : slots) {
+            publish(slot);
+        }
+    }
+    
+    // mutex를 잡은 상태에서 호출
+    static void publish(Slot& slot) {
+        uint64_t count = slot.count.exchange(0, std::memory_order_relaxed);
+        if (count > 0) {
+            Logger::publishSuppressed(*slot.site.load(std::memory_order_relaxed), count);
+        }
+    }
 };
 
+void Logger::Impl::collectSuppressed() {
+    std::lock_guard<std::mutex> lock(stagesMutex_);
+    for (SuppressionStage* stage : stages_) {
+        stage->collect();
+    }
+}
+
 // Logger 구현
+std::atomic<int> Logger::activeLevel_(LEVEL_OFF);
+std::atomic<bool> Logger::binaryMode_(false);
+std::atomic<uint32_t> Logger::rateLimit_(Logger::DEFAULT_RATE_LIMIT);
+std::atomic<uint32_t> Logger::rateWindow_(0);
+
 Logger::Logger() : pImpl(std::make_unique<Impl>()) {}
 Logger::~Logger() = default;
 
@@ -138,27 +887,96 @@ Logger& Logger::getInstance() {
     return instance;
 }
 
-void Logger::init(const std::string& logPath, LogLevel level) {
-    // 날짜별 로그 파일 생성
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    struct tm timeinfo;
-    localtime_r(&time_t, &timeinfo);
-    
-    std::ostringstream oss;
-    oss << logPath << "/"
-        << std::put_time(&timeinfo, "%Y-%m-%d")
-        << ".log";
-    
-    pImpl->init(oss.str(), level);
+void Logger::init(const std::string& logPath, LogLevel level, size_t queueCapacity) {
+    // 날짜별 로그 파일 (<logPath>/<YYYY-MM-DD>.log), 날짜가 바뀌거나 크기 제한을 넘으면 회전
+    pImpl->init(logPath, level, queueCapacity);
 }
 
 void Logger::setLogLevel(LogLevel level) {
     pImpl->setLogLevel(level);
 }
 
-void Logger::log(LogLevel level, const std::string& file, int line, const std::string& message) {
-    pImpl->log(level, file, line, message);
+void Logger::setOverflowPolicy(LogOverflowPolicy policy) {
+    pImpl->setOverflowPolicy(policy);
+}
+
+void Logger::setRotationPolicy(const LogRotationPolicy& policy) {
+    pImpl->setRotationPolicy(policy);
+}
+
+void Logger::setBinaryMode(bool enabled) {
+    binaryMode_.store(enabled, std::memory_order_relaxed);
+}
+
+uint64_t Logger::getDroppedCount() const {
+    return pImpl->getDroppedCount();
+}
+
+void Logger::setRateLimit(uint32_t perSecond) {
+    rateLimit_.store(perSecond, std::memory_order_relaxed);
+}
+
+uint64_t Logger::getSuppressedCount() const {
+    return pImpl->getSuppressedCount();
+}
+
+std::vector<LogSuppression> Logger::getSuppressionStats() const {
+    return pImpl->getSuppressionStats();
+}
+
+bool Logger::admitSlow(LogSite& site, uint32_t window, uint32_t limit) {
+    // 새 구간의 첫 호출이 카운트를 되돌린다 (경쟁 시 몇 개 더 통과할 수 있음)
+    uint32_t siteWindow = site.window.load(std::memory_order_relaxed);
+    if (siteWindow != window &&
+        site.window.compare_exchange_strong(siteWindow, window, std::memory_order_relaxed)) {
+        site.windowCount.store(0, std::memory_order_relaxed);
+    }
+    if (site.windowCount.fetch_add(1, std::memory_order_relaxed) < limit) {
+        return true;
+    }
+    suppress(site);
+    return false;
+}
+
+void Logger::suppress(LogSite& site) {
+    static thread_local SuppressionStage stage;
+    
+    uintptr_t address = reinterpret_cast<uintptr_t>(&site);
+    SuppressionStage::Slot& slot = stage.slots[((address >> 4) ^ (address >> 10)) % SUPPRESSION_STAGE_SLOTS];
+    if (slot.site.load(std::memory_order_relaxed) != &site) {
+        // 다른 호출 위치가 쓰던 슬롯: 그 몫을 반영하고 넘겨받는다
+        std::lock_guard<std::mutex> lock(stage.mutex);
+        SuppressionStage::publish(slot);
+        slot.site.store(&site, std::memory_order_relaxed);
+    }
+    slot.count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Logger::publishSuppressed(LogSite& site, uint64_t count) {
+    site.suppressed.fetch_add(count, std::memory_order_relaxed);
+    site.suppressedTotal.fetch_add(count, std::memory_order_relaxed);
+    if (!site.tracked.load(std::memory_order_relaxed) && !site.tracked.exchange(true)) {
+        getInstance().pImpl->trackSuppressed(site);
+    }
+}
+
+void Logger::log(LogLevel level, const char* file, int line, const std::string& message) {
+    pImpl->log(level, file, line, message.data(), message.size());
+}
+
+void Logger::logMessage(LogLevel level, const char* file, int line, const char* message, size_t length) {
+    pImpl->log(level, file, line, message, length);
+}
+
+void Logger::logBinary(LogSite& site, const char* args, size_t length) {
+    pImpl->logBinary(site, args, length);
+}
+
+void Logger::logFormat(LogLevel level, const char* file, int line, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    pImpl->logv(level, file, line, format, args);
+    va_end(args);
 }
 
 void Logger::flush() {
@@ -170,8 +988,8 @@ void Logger::close() {
 }
 
 // 템플릿 인스턴스화 (필요한 타입들)
-template void Logger::log(LogLevel, const std::string&, int, const std::string&, int);
-template void Logger::log(LogLevel, const std::string&, int, const std::string&, const char*);
-template void Logger::log(LogLevel, const std::string&, int, const std::string&, double);
-template void Logger::log(LogLevel, const std::string&, int, const std::string&, int, int);
-template void Logger::log(LogLevel, const std::string&, int, const std::string&, const char*, int);
\ No newline at end of file
+template void Logger::log(LogLevel, const char*, int, const char*, int);
+template void Logger::log(LogLevel, const char*, int, const char*, const char*);
+template void Logger::log(LogLevel, const char*, int, const char*, double);
+template void Logger::log(LogLevel, const char*, int, const char*, int, int);
+template void Logger::log(LogLevel, const char*, int, const char*, const char*, int);
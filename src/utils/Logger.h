@@ -6,8 +6,13 @@
 #include <memory>
 #include <sstream>
 #include <mutex>
+#include <atomic>
 #include <cstdarg>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <vector>
+#include "LogFormat.h"
 
 enum class LogLevel {
     TRACE = 0,
@@ -18,24 +23,145 @@ enum class LogLevel {
     FATAL
 };
 
+// 컴파일 시점 최소 레벨 (전처리기 비교용 숫자, LogLevel 순서와 같다)
+#define LOG_LEVEL_TRACE   0
+#define LOG_LEVEL_DEBUG   1
+#define LOG_LEVEL_INFO    2
+#define LOG_LEVEL_WARNING 3
+#define LOG_LEVEL_ERROR   4
+#define LOG_LEVEL_FATAL   5
+
+// 이 레벨보다 낮은 LOG_* 호출은 컴파일 단계에서 제거된다 (예: -DLOG_COMPILE_MIN_LEVEL=LOG_LEVEL_DEBUG)
+#ifndef LOG_COMPILE_MIN_LEVEL
+#define LOG_COMPILE_MIN_LEVEL LOG_LEVEL_TRACE
+#endif
+
+// 로그 큐가 가득 찼을 때의 동작
+enum class LogOverflowPolicy {
+    DROP = 0,   // 레코드를 버리고 카운트만 증가 (호출 스레드는 기다리지 않음)
+    BLOCK       // 기록 스레드가 자리를 비울 때까지 대기
+};
+
+// 로그 파일 회전/보관 설정
+// 날짜가 바뀌면 항상 새 파일로 넘어가고, 같은 날 크기 제한을 넘으면 <날짜>.N.log로 회전한다
+// 회전된 파일의 압축과 정리는 보관 스레드가 하므로 LOG_* 호출은 기다리지 않는다
+struct LogRotationPolicy {
+    uint64_t maxFileSize = 50ull * 1024 * 1024;  // 바이트, 0이면 크기 회전 없음
+    bool compress = true;                        // 회전된 파일을 gzip으로 압축
+    size_t maxArchives = 20;                     // 보관 파일 수, 0이면 제한 없음
+    int retentionDays = 14;                      // 보관 기간, 0이면 제한 없음
+};
+
+// LOG_* 호출 위치 (매크로 안의 정적 객체, 상수 초기화)
+// 바이너리 모드에서는 처음 쓰일 때 받은 ID만 기록하고 포맷 문자열은 사이트 프레임으로 한 번만 남긴다
+// 속도 제한: 1초 구간마다 호출 위치당 rateLimit개까지만 기록하고 나머지는 억제 수만 센다
+struct LogSite {
+    LogLevel level;
+    const char* file;
+    int line;
+    const char* format;
+    std::atomic<uint32_t> id{0};               // 0: 미등록
+    std::atomic<uint32_t> window{0};           // 현재 구간 (단조 시각, 초)
+    std::atomic<uint32_t> windowCount{0};      // 현재 구간에서 통과한 수
+    std::atomic<uint64_t> suppressed{0};       // 아직 요약을 남기지 않은 억제 수
+    std::atomic<uint64_t> suppressedTotal{0};  // 누적 억제 수
+    std::atomic<bool> tracked{false};          // 억제 사이트 목록에 등록됨
+};
+
+// 호출 위치별 누적 억제 수 (API 조회용)
+struct LogSuppression {
+    std::string file;
+    int line;
+    LogLevel level;
+    std::string format;
+    uint64_t suppressed;
+};
+
 class Logger {
 public:
+    static constexpr size_t DEFAULT_QUEUE_CAPACITY = 4096;  // 레코드 수 (2의 거듭제곱)
+    static constexpr uint32_t DEFAULT_RATE_LIMIT = 0;       // 호출 위치당 초당 레코드 수 (0: 제한 없음)
+    
     static Logger& getInstance();
     
-    void init(const std::string& logPath, LogLevel level = LogLevel::INFO);
+    // 로그 파일을 열고 백그라운드 기록 스레드를 시작한다
+    void init(const std::string& logPath, LogLevel level = LogLevel::INFO,
+              size_t queueCapacity = DEFAULT_QUEUE_CAPACITY);
     void setLogLevel(LogLevel level);
+    void setOverflowPolicy(LogOverflowPolicy policy);
+    void setRotationPolicy(const LogRotationPolicy& policy);
+    
+    // 바이너리 모드: LOG_* 호출은 포맷 ID + 타임스탬프 + 인자 바이트만 <날짜>.blog에 남긴다
+    // (텍스트 변환은 logdecode 도구로, 콘솔 출력 줄은 기록 스레드가 포맷한다)
+    void setBinaryMode(bool enabled);
+    
+    // 큐가 가득 차 버려진 레코드 수
+    uint64_t getDroppedCount() const;
     
-    void log(LogLevel level, const std::string& file, int line, const std::string& message);
+    // 호출 위치당 초당 최대 레코드 수 (0: 제한 없음, FATAL은 제한하지 않음)
+    // 억제된 수는 기록 스레드가 1초마다 "Suppressed N messages" 한 줄로 요약한다
+    void setRateLimit(uint32_t perSecond);
+    
+    // 억제된 레코드 수 (전체 / 호출 위치별, 많은 순)
+    // 스레드별 임시 카운트는 기록 스레드가 1초마다 거둬 더한다
+    uint64_t getSuppressedCount() const;
+    std::vector<LogSuppression> getSuppressionStats() const;
+    
+    // 현재 레벨에서 기록되는지 (초기화 전/종료 후에는 항상 false)
+    // LOG_* 매크로는 인자를 평가하기 전에 이 검사를 먼저 한다
+    static bool isEnabled(LogLevel level) {
+        return static_cast<int>(level) >= activeLevel_.load(std::memory_order_relaxed);
+    }
+    
+    // 속도 제한 검사 (LOG_* 매크로가 인자를 평가하기 전에 호출)
+    // 제한을 넘은 구간에서는 공유 변수에 쓰지 않고 스레드별 카운트만 올린다 (기록 스레드가 구간마다 거둠)
+    static bool admit(LogSite& site) {
+        uint32_t limit = rateLimit_.load(std::memory_order_relaxed);
+        if (limit == 0 || site.level == LogLevel::FATAL) {
+            return true;
+        }
+        uint32_t window = rateWindow_.load(std::memory_order_relaxed);
+        if (site.window.load(std::memory_order_relaxed) == window &&
+            site.windowCount.load(std::memory_order_relaxed) >= limit) {
+            suppress(site);
+            return false;
+        }
+        return admitSlow(site, window, limit);
+    }
+    
+    void log(LogLevel level, const char* file, int line, const std::string& message);
+    
+    // LOG_* 매크로 경로
+    template<typename... Args>
+    void log(LogSite& site, Args... args) {
+        if (binaryMode_.load(std::memory_order_relaxed)) {
+            if constexpr (sizeof...(Args) == 0) {
+                logBinary(site, nullptr, 0);
+            } else {
+                char buffer[MAX_BINARY_ARGS_SIZE];
+                LogFormat::ArgWriter writer(buffer, sizeof(buffer));
+                (writer.put(args), ...);
+                logBinary(site, buffer, writer.size());
+            }
+        } else if constexpr (sizeof...(Args) == 0) {
+            logMessage(site.level, site.file, site.line, site.format, strlen(site.format));
+        } else {
+            logFormat(site.level, site.file, site.line, site.format, args...);
+        }
+    }
     
     // 템플릿 함수 정의를 헤더에 포함
+    // 포맷팅은 로그 큐의 레코드에 바로 한다 (중간 버퍼/문자열 없음)
     template<typename... Args>
-    void log(LogLevel level, const std::string& file, int line, const std::string& format, Args... args) {
-        // 가변 인자 포맷팅
-        char buffer[4096];
-        snprintf(buffer, sizeof(buffer), format.c_str(), args...);
-        log(level, file, line, std::string(buffer));
+    void log(LogLevel level, const char* file, int line, const char* format, Args... args) {
+        if constexpr (sizeof...(Args) == 0) {
+            logMessage(level, file, line, format, strlen(format));
+        } else {
+            logFormat(level, file, line, format, args...);
+        }
     }
     
+    // 호출 시점까지 큐에 들어간 레코드가 모두 기록될 때까지 대기
     void flush();
     void close();
     
@@ -45,16 +171,44 @@ private:
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
     
+    void logMessage(LogLevel level, const char* file, int line, const char* message, size_t length);
+    void logFormat(LogLevel level, const char* file, int line, const char* format, ...);
+    void logBinary(LogSite& site, const char* args, size_t length);
+    static bool admitSlow(LogSite& site, uint32_t window, uint32_t limit);
+    static void suppress(LogSite& site);
+    static void publishSuppressed(LogSite& site, uint64_t count);
+    
+    static constexpr size_t MAX_BINARY_ARGS_SIZE = 512;
+    
+    // isEnabled 기준 레벨 (초기화 전에는 모든 레벨보다 높다)
+    static std::atomic<int> activeLevel_;
+    static std::atomic<bool> binaryMode_;
+    static std::atomic<uint32_t> rateLimit_;
+    static std::atomic<uint32_t> rateWindow_;  // 현재 속도 제한 구간 (기록 스레드가 초마다 갱신)
+    
+    struct SuppressionStage;
     class Impl;
     std::unique_ptr<Impl> pImpl;
 };
 
 // 매크로 정의
-#define LOG_TRACE(msg, ...) Logger::getInstance().log(LogLevel::TRACE, __FILE__, __LINE__, msg, ##__VA_ARGS__)
-#define LOG_DEBUG(msg, ...) Logger::getInstance().log(LogLevel::DEBUG, __FILE__, __LINE__, msg, ##__VA_ARGS__)
-#define LOG_INFO(msg, ...) Logger::getInstance().log(LogLevel::INFO, __FILE__, __LINE__, msg, ##__VA_ARGS__)
-#define LOG_WARN(msg, ...) Logger::getInstance().log(LogLevel::WARNING, __FILE__, __LINE__, msg, ##__VA_ARGS__)
-#define LOG_ERROR(msg, ...) Logger::getInstance().log(LogLevel::ERROR, __FILE__, __LINE__, msg, ##__VA_ARGS__)
-#define LOG_FATAL(msg, ...) Logger::getInstance().log(LogLevel::FATAL, __FILE__, __LINE__, msg, ##__VA_ARGS__)
+// 레벨이 꺼져 있거나 속도 제한에 걸리면 인자를 평가하지 않고,
+// LOG_COMPILE_MIN_LEVEL 미만이면 호출 자체가 제거된다
+#define LOG_AT(minLevel, level, msg, ...) \
+    do { \
+        if ((minLevel) >= LOG_COMPILE_MIN_LEVEL && Logger::isEnabled(level)) { \
+            static LogSite logSite_ = {level, __FILE__, __LINE__, msg}; \
+            if (Logger::admit(logSite_)) { \
+                Logger::getInstance().log(logSite_, ##__VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define LOG_TRACE(msg, ...) LOG_AT(LOG_LEVEL_TRACE, LogLevel::TRACE, msg, ##__VA_ARGS__)
+#define LOG_DEBUG(msg, ...) LOG_AT(LOG_LEVEL_DEBUG, LogLevel::DEBUG, msg, ##__VA_ARGS__)
+#define LOG_INFO(msg, ...) LOG_AT(LOG_LEVEL_INFO, LogLevel::INFO, msg, ##__VA_ARGS__)
+#define LOG_WARN(msg, ...) LOG_AT(LOG_LEVEL_WARNING, LogLevel::WARNING, msg, ##__VA_ARGS__)
+#define LOG_ERROR(msg, ...) LOG_AT(LOG_LEVEL_ERROR, LogLevel::ERROR, msg, ##__VA_ARGS__)
+#define LOG_FATAL(msg, ...) LOG_AT(LOG_LEVEL_FATAL, LogLevel::FATAL, msg, ##__VA_ARGS__)
 
 #endif // LOGGER_H
\ No newline at end of file
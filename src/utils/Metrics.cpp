@@ -0,0 +1,299 @@
+#include "Metrics.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    // 라벨 값 이스케이프 (\, ", 줄바꿈)
+    void appendEscaped(std::string& out, const std::string& value) {
+        for (char c : value) {
+            switch (c) {
+                case '\\': out += "\\\\"; break;
+                case '"': out += "\\\""; break;
+                case '\n': out += "\\n"; break;
+                default: out += c; break;
+            }
+        }
+    }
+
+    std::string renderLabels(const MetricLabels& labels) {
+        if (labels.empty()) {
+            return std::string();
+        }
+        std::string out = "{";
+        for (size_t i = 0; i < labels.size(); i++) {
+            if (i > 0) {
+                out += ',';
+            }
+            out += labels[i].first;
+            out += "=\"";
+            appendEscaped(out, labels[i].second);
+            out += '"';
+        }
+        out += '}';
+        return out;
+    }
+
+    // 렌더된 라벨에 le 라벨을 덧붙인다 (히스토그램 버킷)
+    void appendBucketLabels(std::string& out, const std::string& labels, const char* le) {
+        if (labels.empty()) {
+            out += "{le=\"";
+        } else {
+            out.append(labels, 0, labels.size() - 1);
+            out += ",le=\"";
+        }
+        out += le;
+        out += "\"}";
+    }
+
+    void appendUnsigned(std::string& out, uint64_t value) {
+        char buffer[24];
+        snprintf(buffer, sizeof(buffer), "%" PRIu64, value);
+        out += buffer;
+    }
+
+    void appendDouble(std::string& out, double value) {
+        if (std::isnan(value)) {
+            out += "NaN";
+        } else if (std::isinf(value)) {
+            out += (value > 0) ? "+Inf" : "-Inf";
+        } else {
+            char buffer[32];
+            snprintf(buffer, sizeof(buffer), "%.6g", value);
+            out += buffer;
+        }
+    }
+
+    // name_bucket{...,le="x"} (누적), name_sum, name_count
+    void renderHistogram(std::string& out, const std::string& name, const std::string& labels,
+                         const Histogram& histogram) {
+        Histogram::Snapshot snapshot = histogram.snapshot();
+        const std::vector<double>& bounds = histogram.getBounds();
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i <= bounds.size(); i++) {
+            cumulative += snapshot.counts[i];
+            char le[32];
+            if (i < bounds.size()) {
+                snprintf(le, sizeof(le), "%.6g", bounds[i]);
+            } else {
+                snprintf(le, sizeof(le), "+Inf");
+            }
+            out += name;
+            out += "_bucket";
+            appendBucketLabels(out, labels, le);
+            out += ' ';
+            appendUnsigned(out, cumulative);
+            out += '\n';
+        }
+        out += name;
+        out += "_sum";
+        out += labels;
+        out += ' ';
+        appendDouble(out, snapshot.sum);
+        out += "\n";
+        out += name;
+        out += "_count";
+        out += labels;
+        out += ' ';
+        appendUnsigned(out, snapshot.count);
+        out += '\n';
+    }
+}
+
+Histogram::Histogram(const std::vector<double>& bounds)
+    : bounds_(bounds) {
+    std::sort(bounds_.begin(), bounds_.end());
+    bounds_.erase(std::unique(bounds_.begin(), bounds_.end()), bounds_.end());
+    // 버킷 + +Inf + 합계
+    linesPerShard_ = (bounds_.size() + 2 + 7) / 8;
+    lines_.reset(new Line[METRIC_SHARDS * linesPerShard_]);
+    for (size_t i = 0; i < METRIC_SHARDS * linesPerShard_; i++) {
+        for (auto& value : lines_[i].values) {
+            value.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+const std::vector<double>& Histogram::latencyBuckets() {
+    static const std::vector<double> buckets = {
+        0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0
+    };
+    return buckets;
+}
+
+void Histogram::observe(double value) {
+    size_t bucket = std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin();
+    size_t shard = metricShard();
+    slot(shard, bucket).fetch_add(1, std::memory_order_relaxed);
+
+    // 합계: 샤드를 쓰는 스레드가 거의 하나라 CAS가 실패하는 일은 드물다
+    std::atomic<uint64_t>& sum = slot(shard, bounds_.size() + 1);
+    uint64_t oldBits = sum.load(std::memory_order_relaxed);
+    uint64_t newBits;
+    do {
+        double total;
+        memcpy(&total, &oldBits, sizeof(total));
+        total += value;
+        memcpy(&newBits, &total, sizeof(newBits));
+    } while (!sum.compare_exchange_weak(oldBits, newBits, std::memory_order_relaxed));
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+    Snapshot result;
+    result.counts.assign(bounds_.size() + 1, 0);
+    result.count = 0;
+    result.sum = 0.0;
+    for (size_t shard = 0; shard < METRIC_SHARDS; shard++) {
+        for (size_t i = 0; i <= bounds_.size(); i++) {
+            uint64_t count = slot(shard, i).load(std::memory_order_relaxed);
+            result.counts[i] += count;
+            result.count += count;
+        }
+        uint64_t bits = slot(shard, bounds_.size() + 1).load(std::memory_order_relaxed);
+        double sum;
+        memcpy(&sum, &bits, sizeof(sum));
+        result.sum += sum;
+    }
+    return result;
+}
+
+MetricsRegistry& MetricsRegistry::getInstance() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+MetricsRegistry::Series& MetricsRegistry::findOrCreate(const std::string& name, const std::string& help,
+                                                       Type type, const MetricLabels& labels,
+                                                       const std::vector<double>* bounds) {
+    std::string rendered = renderLabels(labels);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Family* family;
+    auto it = familyIndex_.find(name);
+    if (it != familyIndex_.end()) {
+        family = it->second;
+        if (family->type != type) {
+            LOG_ERROR("Metric %s registered with a different type", name.c_str());
+        }
+    } else {
+        families_.push_back(std::make_unique<Family>());
+        family = families_.back().get();
+        family->name = name;
+        family->help = help;
+        family->type = type;
+        familyIndex_[name] = family;
+    }
+
+    Series* series = nullptr;
+    for (auto& existing : family->series) {
+        if (existing->labels == rendered) {
+            series = existing.get();
+            break;
+        }
+    }
+    if (!series) {
+        family->series.push_back(std::make_unique<Series>());
+        series = family->series.back().get();
+        series->labels = rendered;
+    }
+
+    switch (type) {
+        case Type::COUNTER:
+            if (!series->counter) {
+                series->counter = std::make_unique<Counter>();
+            }
+            break;
+        case Type::GAUGE:
+            if (!series->gauge) {
+                series->gauge = std::make_unique<Gauge>();
+            }
+            break;
+        case Type::HISTOGRAM:
+            if (!series->histogram) {
+                series->histogram = std::make_unique<Histogram>(*bounds);
+            }
+            break;
+    }
+    return *series;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help,
+                                  const MetricLabels& labels) {
+    return *findOrCreate(name, help, Type::COUNTER, labels).counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help,
+                              const MetricLabels& labels) {
+    return *findOrCreate(name, help, Type::GAUGE, labels).gauge;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                      const std::vector<double>& bounds, const MetricLabels& labels) {
+    return *findOrCreate(name, help, Type::HISTOGRAM, labels, &bounds).histogram;
+}
+
+int MetricsRegistry::addCollector(Collector collector) {
+    std::lock_guard<std::mutex> lock(collectorsMutex_);
+    int id = nextCollectorId_++;
+    collectors_.emplace_back(id, std::move(collector));
+    return id;
+}
+
+void MetricsRegistry::removeCollector(int id) {
+    std::lock_guard<std::mutex> lock(collectorsMutex_);
+    for (auto it = collectors_.begin(); it != collectors_.end(); ++it) {
+        if (it->first == id) {
+            collectors_.erase(it);
+            return;
+        }
+    }
+}
+
+std::string MetricsRegistry::renderPrometheus() {
+    {
+        // 콜백은 잠금을 잡은 채 부른다 (해제와 경쟁하지 않도록)
+        std::lock_guard<std::mutex> lock(collectorsMutex_);
+        for (auto& entry : collectors_) {
+            entry.second();
+        }
+    }
+
+    std::string out;
+    out.reserve(4096);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& family : families_) {
+        out += "# HELP ";
+        out += family->name;
+        out += ' ';
+        out += family->help;
+        out += "\n# TYPE ";
+        out += family->name;
+        switch (family->type) {
+            case Type::COUNTER: out += " counter\n"; break;
+            case Type::GAUGE: out += " gauge\n"; break;
+            case Type::HISTOGRAM: out += " histogram\n"; break;
+        }
+
+        for (const auto& series : family->series) {
+            if (family->type == Type::COUNTER && series->counter) {
+                out += family->name;
+                out += series->labels;
+                out += ' ';
+                appendUnsigned(out, series->counter->get());
+                out += '\n';
+            } else if (family->type == Type::GAUGE && series->gauge) {
+                out += family->name;
+                out += series->labels;
+                out += ' ';
+                appendDouble(out, series->gauge->get());
+                out += '\n';
+            } else if (family->type == Type::HISTOGRAM && series->histogram) {
+                renderHistogram(out, family->name, series->labels, *series->histogram);
+            }
+        }
+    }
+    return out;
+}
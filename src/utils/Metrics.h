@@ -0,0 +1,178 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// 런타임 지표 (Prometheus 텍스트 포맷으로 노출)
+// - 지표는 이름 + 라벨 조합마다 한 번 등록하고, 받은 참조로 잠금 없이 갱신한다
+// - 등록한 지표는 프로세스가 끝날 때까지 유지된다 (참조가 무효화되지 않음)
+// - 렌더 직전에 수집 콜백을 불러 계산형 게이지(큐 채움 정도 등)를 갱신한다
+// - 카운터와 히스토그램은 스레드별 샤드(캐시 라인 단위)에 더하고 읽을 때 합친다.
+//   여러 스트리밍/워커 스레드가 같은 지표를 갱신해도 캐시 라인을 주고받지 않는다
+
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+constexpr size_t METRIC_SHARDS = 16;
+
+// 호출 스레드의 샤드 번호 (스레드가 처음 지표를 갱신할 때 순서대로 배정)
+inline size_t metricShard() {
+    static std::atomic<size_t> nextShard{0};
+    thread_local size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    return shard;
+}
+
+class Counter {
+public:
+    void inc(uint64_t amount = 1) {
+        shards_[metricShard()].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+    uint64_t get() const {
+        uint64_t total = 0;
+        for (const Shard& shard : shards_) {
+            total += shard.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+    Shard shards_[METRIC_SHARDS];
+};
+
+class Gauge {
+public:
+    void set(double value) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        bits_.store(bits, std::memory_order_relaxed);
+    }
+    double get() const {
+        uint64_t bits = bits_.load(std::memory_order_relaxed);
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+private:
+    std::atomic<uint64_t> bits_{0};  // 0.0
+};
+
+// 고정 버킷 히스토그램 (값의 단위는 등록한 쪽이 정한다. 지연은 초 단위)
+// bounds는 오름차순 상한값이며, 마지막 상한을 넘는 값은 +Inf 버킷에 들어간다
+class Histogram {
+public:
+    struct Snapshot {
+        std::vector<uint64_t> counts;  // 버킷별 (누적 아님), 마지막이 +Inf
+        uint64_t count;
+        double sum;
+    };
+
+    // 시간 측정 범위 (소멸 시 경과 시간을 초 단위로 기록)
+    class Timer {
+    public:
+        explicit Timer(Histogram& histogram)
+            : histogram_(histogram)
+            , start_(std::chrono::steady_clock::now()) {}
+        ~Timer() {
+            histogram_.observe(std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start_).count());
+        }
+
+    private:
+        Histogram& histogram_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    explicit Histogram(const std::vector<double>& bounds);
+
+    void observe(double value);
+    Snapshot snapshot() const;
+    const std::vector<double>& getBounds() const { return bounds_; }
+
+    // 요청/명령 지연용 기본 버킷 (0.5ms ~ 5s)
+    static const std::vector<double>& latencyBuckets();
+
+private:
+    // 샤드마다 [버킷들..., +Inf, 합계(double 비트)] 를 캐시 라인 경계에 맞춰 둔다
+    struct alignas(64) Line {
+        std::atomic<uint64_t> values[8];
+    };
+
+    std::atomic<uint64_t>& slot(size_t shard, size_t index) const {
+        return lines_[shard * linesPerShard_ + index / 8].values[index % 8];
+    }
+
+    std::vector<double> bounds_;
+    size_t linesPerShard_;
+    std::unique_ptr<Line[]> lines_;
+};
+
+class MetricsRegistry {
+public:
+    using Collector = std::function<void()>;
+
+    static MetricsRegistry& getInstance();
+
+    // 같은 이름 + 라벨이면 기존 지표를 반환한다
+    Counter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    Gauge& gauge(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    Histogram& histogram(const std::string& name, const std::string& help,
+                         const std::vector<double>& bounds, const MetricLabels& labels = {});
+
+    // 수집 콜백 등록/해제 (해제 후에는 호출되지 않음)
+    int addCollector(Collector collector);
+    void removeCollector(int id);
+
+    // Prometheus 텍스트 포맷 (version 0.0.4)
+    std::string renderPrometheus();
+
+    static constexpr const char* CONTENT_TYPE = "text/plain; version=0.0.4; charset=utf-8";
+
+private:
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    enum class Type { COUNTER, GAUGE, HISTOGRAM };
+
+    // 요청한 타입의 지표만 만든다 (타입이 어긋난 등록도 참조는 유효하지만 렌더되지 않음)
+    struct Series {
+        std::string labels;  // 렌더된 라벨 ({k="v",...} 또는 빈 문자열)
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    struct Family {
+        std::string name;
+        std::string help;
+        Type type;
+        std::vector<std::unique_ptr<Series>> series;
+    };
+
+    Series& findOrCreate(const std::string& name, const std::string& help, Type type,
+                         const MetricLabels& labels, const std::vector<double>* bounds = nullptr);
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<Family>> families_;  // 등록 순서대로 렌더
+    std::unordered_map<std::string, Family*> familyIndex_;
+
+    std::mutex collectorsMutex_;
+    std::vector<std::pair<int, Collector>> collectors_;
+    int nextCollectorId_ = 1;
+};
+
+#endif // METRICS_H
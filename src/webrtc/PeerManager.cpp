@@ -3,6 +3,7 @@
 #include "../pipeline/Pipeline.h"
 #include "../pipeline/CameraSource.h"
 #include "../utils/Logger.h"
+#include "../utils/Metrics.h"
 #include <json-glib/json-glib.h>
 
 PeerManager::PeerManager(Pipeline* pipeline, int maxPeers)
@@ -12,6 +13,10 @@ PeerManager::PeerManager(Pipeline* pipeline, int maxPeers)
     , baseStreamPort_(0)
     , commSocketBasePort_(0) {
     
+    MetricsRegistry& registry = MetricsRegistry::getInstance();
+    peersGauge_ = &registry.gauge("webrtc_peers", "Connected WebRTC peers");
+    peersAddedCounter_ = &registry.counter("webrtc_peers_added_total", "WebRTC peers accepted");
+    
     LOG_INFO("PeerManager created (max peers: %d)", maxPeers);
 }
 
@@ -73,6 +78,8 @@ bool PeerManager::addPeer(const std::string& peerId, CameraType source) {
     }
     
     peers_[peerId] = std::move(sender);
+    peersGauge_->set(static_cast<double>(peers_.size()));
+    peersAddedCounter_->inc();
     
     LOG_INFO("Added peer %s", peerId.c_str());
     
@@ -98,6 +105,7 @@ bool PeerManager::removePeer(const std::string& peerId) {
         
         // 즉시 맵에서 제거
         peers_.erase(it);
+        peersGauge_->set(static_cast<double>(peers_.size()));
     }
     
     // 카메라 출력 제거
@@ -420,4 +428,5 @@ void PeerManager::stopAllProcesses() {
     
     LOG_INFO("Stopping all peer processes...");
     peers_.clear();  // 소멸자에서 자동으로 stop() 호출됨
+    peersGauge_->set(0.0);
 }
\ No newline at end of file
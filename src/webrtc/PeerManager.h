@@ -11,6 +11,8 @@
 
 class WebRTCSenderProcess;
 class Pipeline;
+class Counter;
+class Gauge;
 
 class PeerManager {
 public:
@@ -52,6 +54,10 @@ private:
     mutable std::mutex peersMutex_;
     std::unordered_map<std::string, std::unique_ptr<WebRTCSenderProcess>> peers_;
     
+    // 지표 (peersMutex_ 안에서 갱신)
+    Gauge* peersGauge_;
+    Counter* peersAddedCounter_;
+    
     // 포트 할당 관리
     std::vector<bool> portAllocated_;
     std::vector<bool> commSocketAllocated_;
@@ -0,0 +1,36 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+// 단위 테스트 공용 검사 매크로 (외부 프레임워크 없음)
+// 실패하면 위치와 식을 출력하고 계속 진행한다. main은 TEST_RESULT()를 반환한다
+
+#include <cstdio>
+
+namespace test {
+    inline int& failures() {
+        static int count = 0;
+        return count;
+    }
+}
+
+#define CHECK(expr) \
+    do { \
+        if (!(expr)) { \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #expr); \
+            test::failures()++; \
+        } \
+    } while (0)
+
+#define CHECK_EQ(a, b) \
+    do { \
+        if (!((a) == (b))) { \
+            std::fprintf(stderr, "%s:%d: CHECK_EQ failed: %s == %s (%lld vs %lld)\n", __FILE__, __LINE__, \
+                         #a, #b, static_cast<long long>(a), static_cast<long long>(b)); \
+            test::failures()++; \
+        } \
+    } while (0)
+
+#define TEST_RESULT() \
+    (test::failures() == 0 ? (std::printf("OK\n"), 0) : (std::fprintf(stderr, "%d failure(s)\n", test::failures()), 1))
+
+#endif // TEST_UTIL_H
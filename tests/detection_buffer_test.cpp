@@ -0,0 +1,148 @@
+// DetectionBuffer: 시간 범위 조회, 최신 프레임, 링 덮어쓰기, 객체 풀 감기, 증분 방문, 시계 조정
+
+#include "TestUtil.h"
+#include "detection/DetectionBuffer.h"
+#include <vector>
+
+namespace {
+    const uint64_t BASE_NS = 1700000000ULL * 1000000000ULL;
+    const uint64_t FRAME_NS = 33333333ULL;
+
+    std::vector<DetectedObject> makeObjects(size_t count, int classId) {
+        std::vector<DetectedObject> objects(count);
+        for (size_t i = 0; i < count; i++) {
+            objects[i].classId = classId;
+            objects[i].confidence = 0.5f;
+            objects[i].bbox = {static_cast<int>(i) * 10, 20, 100, 80};
+            objects[i].color = BboxColor::GREEN;
+            objects[i].hasBbox = true;
+        }
+        return objects;
+    }
+
+    void testTimeRange() {
+        DetectionBuffer buffer(CameraType::RGB, 64);
+        for (uint32_t f = 0; f < 10; f++) {
+            std::vector<DetectedObject> objects = makeObjects(f % 3 + 1, static_cast<int>(f));
+            buffer.addDetection(BASE_NS + f * FRAME_NS, f, objects.data(), objects.size());
+        }
+        CHECK_EQ(buffer.getBufferSize(), 10);
+
+        // [2, 5] 프레임
+        std::vector<DetectionData> range =
+            buffer.getDetectionsInTimeRange(BASE_NS + 2 * FRAME_NS, BASE_NS + 5 * FRAME_NS);
+        CHECK_EQ(range.size(), 4);
+        if (range.size() == 4) {
+            CHECK_EQ(range.front().frameNumber, 2);
+            CHECK_EQ(range.back().frameNumber, 5);
+            CHECK_EQ(range[1].objects.size(), 3 % 3 + 1);
+            CHECK_EQ(range[1].objects[0].classId, 3);
+        }
+
+        size_t visited = buffer.visitDetectionsInTimeRange(0, UINT64_MAX, [](const DetectionView& view) {
+            CHECK_EQ(view.objectCount, view.frameNumber % 3 + 1);
+        });
+        CHECK_EQ(visited, 10);
+
+        DetectionData latest;
+        CHECK(buffer.getLatestDetection(latest));
+        CHECK_EQ(latest.frameNumber, 9);
+        CHECK_EQ(latest.timestamp, BASE_NS + 9 * FRAME_NS);
+    }
+
+    void testWrapAround() {
+        // 프레임 8개, 객체 풀 20개: 오래된 프레임은 덮어써지고 남은 프레임의 객체는 온전해야 한다
+        DetectionBuffer buffer(CameraType::THERMAL, 8, 20);
+        for (uint32_t f = 0; f < 50; f++) {
+            std::vector<DetectedObject> objects = makeObjects(f % 5 + 1, static_cast<int>(f));
+            buffer.addDetection(BASE_NS + f * FRAME_NS, f, objects.data(), objects.size());
+        }
+
+        uint32_t previous = 0;
+        size_t visited = buffer.visitDetectionsInTimeRange(0, UINT64_MAX, [&](const DetectionView& view) {
+            CHECK(view.frameNumber > previous);
+            previous = view.frameNumber;
+            CHECK_EQ(view.objectCount, view.frameNumber % 5 + 1);
+            for (const DetectedObject& obj : view) {
+                CHECK_EQ(obj.classId, static_cast<int>(view.frameNumber));
+            }
+        });
+        CHECK(visited > 0 && visited <= 8);
+        CHECK_EQ(previous, 49);
+    }
+
+    void testVisitSince() {
+        DetectionBuffer buffer(CameraType::RGB, 16);
+        uint64_t index = buffer.getHeadIndex();
+        std::vector<DetectedObject> objects = makeObjects(2, 1);
+        for (uint32_t f = 0; f < 3; f++) {
+            buffer.addDetection(BASE_NS + f * FRAME_NS, f, objects.data(), objects.size());
+        }
+
+        std::vector<uint32_t> frames;
+        index = buffer.visitDetectionsSince(index, [&](const DetectionView& view) {
+            frames.push_back(view.frameNumber);
+        });
+        CHECK_EQ(frames.size(), 3);
+
+        buffer.addDetection(BASE_NS + 3 * FRAME_NS, 3, objects.data(), objects.size());
+        frames.clear();
+        buffer.visitDetectionsSince(index, [&](const DetectionView& view) {
+            frames.push_back(view.frameNumber);
+        });
+        CHECK_EQ(frames.size(), 1);
+        CHECK(!frames.empty() && frames[0] == 3);
+    }
+
+    void testClockGoesBack() {
+        // 시계가 조금(CLOCK_STEP_NS 미만) 뒤로 가면 타임스탬프는 단조 증가로 보정된다
+        DetectionBuffer buffer(CameraType::RGB, 16);
+        std::vector<DetectedObject> objects = makeObjects(1, 0);
+        buffer.addDetection(BASE_NS + 10 * FRAME_NS, 0, objects.data(), objects.size());
+        buffer.addDetection(BASE_NS, 1, objects.data(), objects.size());
+
+        DetectionData latest;
+        CHECK(buffer.getLatestDetection(latest));
+        CHECK_EQ(latest.timestamp, BASE_NS + 10 * FRAME_NS);
+        CHECK_EQ(buffer.getDetectionsInTimeRange(BASE_NS + 10 * FRAME_NS, UINT64_MAX).size(), 2);
+    }
+
+    void testClockStepBack() {
+        // 벽시계가 크게 뒤로 조정되면 이전 프레임을 퇴역시키고 새 시각으로 쌓는다 (옛 시각에 묶이지 않는다)
+        const uint64_t STEP_NS = 60ULL * 1000000000ULL;
+        DetectionBuffer buffer(CameraType::RGB, 16);
+        std::vector<DetectedObject> objects = makeObjects(1, 0);
+        for (uint32_t f = 0; f < 5; f++) {
+            buffer.addDetection(BASE_NS + STEP_NS + f * FRAME_NS, f, objects.data(), objects.size());
+        }
+        uint64_t generation = buffer.getGeneration();
+
+        for (uint32_t f = 5; f < 8; f++) {
+            buffer.addDetection(BASE_NS + f * FRAME_NS, f, objects.data(), objects.size());
+        }
+        CHECK(buffer.getGeneration() > generation);
+        CHECK_EQ(buffer.getBufferSize(), 3);
+
+        DetectionData latest;
+        CHECK(buffer.getLatestDetection(latest));
+        CHECK_EQ(latest.timestamp, BASE_NS + 7 * FRAME_NS);
+        CHECK_EQ(latest.frameNumber, 7);
+
+        // 조정 후의 "지금" 범위에 새 프레임이 모두 보이고, 조정 전 시각의 프레임은 남지 않는다
+        std::vector<DetectionData> recent = buffer.getDetectionsInTimeRange(BASE_NS, BASE_NS + 10 * FRAME_NS);
+        CHECK_EQ(recent.size(), 3);
+        for (size_t i = 0; i < recent.size(); i++) {
+            CHECK_EQ(recent[i].timestamp, BASE_NS + (5 + i) * FRAME_NS);
+        }
+        CHECK(buffer.getDetectionsInTimeRange(BASE_NS + STEP_NS, UINT64_MAX).empty());
+    }
+}
+
+int main() {
+    testTimeRange();
+    testWrapAround();
+    testVisitSince();
+    testClockGoesBack();
+    testClockStepBack();
+    return TEST_RESULT();
+}
@@ -0,0 +1,210 @@
+// DetectionCodec: 인코드→디코드 왕복, 델타 타임스탬프/프레임 번호, 빈 프레임, 잘린/잘못된 입력 거부
+
+#include "TestUtil.h"
+#include "api/DetectionCodec.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+    const uint64_t BASE_TIME = 1700000000ULL * 1000000000ULL;
+
+    DetectedObject makeObject(int classId, float confidence, BoundingBox bbox, BboxColor color) {
+        DetectedObject obj;
+        obj.classId = classId;
+        obj.confidence = confidence;
+        obj.bbox = bbox;
+        obj.color = color;
+        obj.hasBbox = color != BboxColor::NONE;
+        return obj;
+    }
+
+    DetectionData makeFrame(uint64_t timestamp, uint32_t frameNumber, std::vector<DetectedObject> objects) {
+        DetectionData detection;
+        detection.timestamp = timestamp;
+        detection.frameNumber = frameNumber;
+        detection.cameraType = CameraType::THERMAL;
+        detection.objects = std::move(objects);
+        return detection;
+    }
+
+    std::string encode(CameraType cameraType, const std::vector<DetectionData>& frames) {
+        std::string out;
+        DetectionCodec::Writer writer([&out](const char* data, size_t length) {
+            out.append(data, length);
+            return true;
+        });
+        writer.begin(cameraType);
+        for (const DetectionData& frame : frames) {
+            DetectionView view{frame.timestamp, frame.frameNumber, frame.cameraType,
+                               frame.objects.data(), frame.objects.size()};
+            writer.writeDetection(view);
+        }
+        writer.end();
+        CHECK(writer.flush());
+        CHECK_EQ(writer.bytesWritten(), out.size());
+        return out;
+    }
+
+    bool decode(const std::string& data, CameraType& cameraType, std::vector<DetectionData>& frames,
+                std::string* error = nullptr) {
+        frames.clear();
+        return DetectionCodec::decode(reinterpret_cast<const uint8_t*>(data.data()), data.size(),
+                                      cameraType, frames, error);
+    }
+
+    size_t varintSize(uint64_t value) {
+        size_t size = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            size++;
+        }
+        return size;
+    }
+
+    bool sameObject(const DetectedObject& a, const DetectedObject& b) {
+        return a.classId == b.classId && a.confidence == b.confidence && a.color == b.color &&
+               a.hasBbox == b.hasBbox && memcmp(&a.bbox, &b.bbox, sizeof(BoundingBox)) == 0;
+    }
+
+    void testRoundTrip() {
+        std::vector<DetectionData> frames;
+        frames.push_back(makeFrame(BASE_TIME, 10, {
+            makeObject(0, 0.91f, {100, 200, 50, 60}, BboxColor::RED),
+            makeObject(3, 0.42f, {-20, 5, 300, 400}, BboxColor::NONE),
+        }));
+        frames.push_back(makeFrame(BASE_TIME + 33333333ULL, 13, {
+            makeObject(5, 0.5f, {1800, 1000, 119, 7}, BboxColor::GREEN),
+        }));
+        frames.push_back(makeFrame(BASE_TIME + 66666666ULL, 16, {}));
+
+        std::string data = encode(CameraType::THERMAL, frames);
+        CHECK(memcmp(data.data(), DetectionCodec::MAGIC, sizeof(DetectionCodec::MAGIC)) == 0);
+
+        CameraType cameraType = CameraType::RGB;
+        std::vector<DetectionData> decoded;
+        std::string error;
+        CHECK(decode(data, cameraType, decoded, &error));
+        CHECK(error.empty());
+        CHECK(cameraType == CameraType::THERMAL);
+        CHECK_EQ(decoded.size(), frames.size());
+
+        for (size_t i = 0; i < frames.size() && i < decoded.size(); i++) {
+            CHECK_EQ(decoded[i].timestamp, frames[i].timestamp);
+            CHECK_EQ(decoded[i].frameNumber, frames[i].frameNumber);
+            CHECK(decoded[i].cameraType == CameraType::THERMAL);
+            CHECK_EQ(decoded[i].objects.size(), frames[i].objects.size());
+            for (size_t j = 0; j < frames[i].objects.size() && j < decoded[i].objects.size(); j++) {
+                CHECK(sameObject(decoded[i].objects[j], frames[i].objects[j]));
+            }
+        }
+    }
+
+    void testDeltas() {
+        // 두 번째 프레임부터 타임스탬프는 직전 대비 델타, 프레임 번호는 zigzag 델타 (감소도 허용)
+        std::vector<DetectionData> frames;
+        frames.push_back(makeFrame(BASE_TIME, 1000, {}));
+        frames.push_back(makeFrame(BASE_TIME + 33333333ULL, 999, {}));
+
+        std::string data = encode(CameraType::RGB, frames);
+        size_t first = 1 + varintSize(BASE_TIME) + varintSize(1000 << 1) + 1;
+        size_t second = 1 + varintSize(33333333ULL) + 1 + 1;  // -1 → zigzag 1
+        CHECK_EQ(data.size(), DetectionCodec::HEADER_SIZE + first + second + 1);
+        CHECK_EQ(static_cast<uint8_t>(data[DetectionCodec::HEADER_SIZE + first]), DetectionCodec::TAG_FRAME);
+
+        CameraType cameraType;
+        std::vector<DetectionData> decoded;
+        CHECK(decode(data, cameraType, decoded));
+        CHECK_EQ(decoded.size(), 2u);
+        if (decoded.size() == 2) {
+            CHECK_EQ(decoded[1].timestamp, BASE_TIME + 33333333ULL);
+            CHECK_EQ(decoded[1].frameNumber, 999u);
+        }
+
+        // 뒤로 간 타임스탬프는 직전 값으로 붙인다 (델타는 음수가 되지 않는다)
+        frames[1].timestamp = BASE_TIME - 1;
+        CHECK(decode(encode(CameraType::RGB, frames), cameraType, decoded));
+        CHECK_EQ(decoded.size(), 2u);
+        if (decoded.size() == 2) {
+            CHECK_EQ(decoded[1].timestamp, BASE_TIME);
+        }
+    }
+
+    void testEmpty() {
+        // 프레임이 없는 스트림: 헤더 + 끝 태그
+        std::string data = encode(CameraType::RGB, {});
+        CHECK_EQ(data.size(), DetectionCodec::HEADER_SIZE + 1);
+
+        CameraType cameraType = CameraType::THERMAL;
+        std::vector<DetectionData> decoded;
+        CHECK(decode(data, cameraType, decoded));
+        CHECK(cameraType == CameraType::RGB);
+        CHECK(decoded.empty());
+
+        // 객체가 없는 프레임들
+        std::vector<DetectionData> frames = {makeFrame(BASE_TIME, 0, {}), makeFrame(BASE_TIME, 0, {})};
+        CHECK(decode(encode(CameraType::RGB, frames), cameraType, decoded));
+        CHECK_EQ(decoded.size(), 2u);
+        for (const DetectionData& frame : decoded) {
+            CHECK(frame.objects.empty());
+            CHECK_EQ(frame.timestamp, BASE_TIME);
+        }
+    }
+
+    void testTruncated() {
+        std::vector<DetectionData> frames;
+        frames.push_back(makeFrame(BASE_TIME, 1, {makeObject(1, 0.7f, {1, 2, 3, 4}, BboxColor::RED)}));
+        frames.push_back(makeFrame(BASE_TIME + 1000, 2, {makeObject(2, 0.8f, {5, 6, 7, 8}, BboxColor::RED)}));
+        std::string data = encode(CameraType::RGB, frames);
+
+        CameraType cameraType;
+        std::vector<DetectionData> decoded;
+        for (size_t length = 0; length < data.size(); length++) {
+            std::string error;
+            CHECK(!decode(data.substr(0, length), cameraType, decoded, &error));
+            CHECK(!error.empty());
+        }
+        CHECK(decode(data, cameraType, decoded));
+    }
+
+    void testBadHeader() {
+        std::string data = encode(CameraType::RGB, {makeFrame(BASE_TIME, 1, {})});
+        CameraType cameraType;
+        std::vector<DetectionData> decoded;
+        std::string error;
+
+        std::string badMagic = data;
+        badMagic[0] = 'X';
+        CHECK(!decode(badMagic, cameraType, decoded, &error));
+        CHECK(error == "bad magic");
+
+        std::string badVersion = data;
+        badVersion[4] = static_cast<char>(DetectionCodec::VERSION + 1);
+        CHECK(!decode(badVersion, cameraType, decoded, &error));
+        CHECK(error == "unsupported version");
+
+        std::string badCamera = data;
+        badCamera[6] = static_cast<char>(0x7F);
+        CHECK(!decode(badCamera, cameraType, decoded, &error));
+        CHECK(error == "bad camera type");
+
+        std::string badObjectSize = data;
+        badObjectSize[7] = static_cast<char>(DetectionCodec::OBJECT_RECORD_SIZE - 1);
+        CHECK(!decode(badObjectSize, cameraType, decoded, &error));
+        CHECK(error == "bad object record size");
+
+        std::string badTag = data;
+        badTag[DetectionCodec::HEADER_SIZE] = static_cast<char>(7);
+        CHECK(!decode(badTag, cameraType, decoded, &error));
+        CHECK(error == "unknown record tag");
+    }
+}
+
+int main() {
+    testRoundTrip();
+    testDeltas();
+    testEmpty();
+    testTruncated();
+    testBadHeader();
+    return TEST_RESULT();
+}
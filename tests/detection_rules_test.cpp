@@ -0,0 +1,118 @@
+// DetectionRules: 기본 규칙, 규칙 파일 컴파일/거부, 필터와 색상, 프리셋 마스크, 규칙 교체
+
+#include "TestUtil.h"
+#include "detection/DetectionRules.h"
+#include <vector>
+
+namespace {
+    DetectedObject makeObject(int classId, float confidence, int x, int y, int width, int height) {
+        DetectedObject obj = DetectedObject();
+        obj.classId = classId;
+        obj.confidence = confidence;
+        obj.bbox = {x, y, width, height};
+        obj.color = BboxColor::NONE;
+        obj.hasBbox = false;
+        return obj;
+    }
+
+    void testDefaults() {
+        std::unique_ptr<DetectionRules> rules = DetectionRules::defaults();
+        std::vector<DetectedObject> objects = {
+            makeObject(CLASS_NORMAL_COW, 0.9f, 0, 0, 100, 100),
+            makeObject(CLASS_NORMAL_COW, 0.2f, 0, 0, 100, 100),   // 신뢰도 미달
+            makeObject(CLASS_HEAT_COW, 0.9f, 0, 0, 100, 100),
+            makeObject(CLASS_FLIP_COW, 0.9f, 0, 0, 10, 10),       // 대각선 범위 밖: 박스 없음
+        };
+
+        size_t kept = rules->apply(CameraType::RGB, -1, 0, objects.data(), objects.size());
+        CHECK_EQ(kept, 3);
+        CHECK(objects[0].color == BboxColor::GREEN && objects[0].hasBbox);
+        CHECK(objects[1].classId == CLASS_HEAT_COW && objects[1].color == BboxColor::YELLOW);
+        CHECK(objects[2].classId == CLASS_FLIP_COW && !objects[2].hasBbox);
+
+        // ResNet50 확인이 켜지면 발정 소는 빨강
+        DetectedObject heat = makeObject(CLASS_HEAT_COW, 0.9f, 0, 0, 100, 100);
+        CHECK_EQ(rules->apply(CameraType::RGB, -1, DetectionRules::CONFIRM_RESNET50, &heat, 1), 1);
+        CHECK(heat.color == BboxColor::RED);
+    }
+
+    void testCompile() {
+        std::unique_ptr<DetectionRules> rules = DetectionRules::compile(R"({
+            "default": {"min_confidence": 0.5},
+            "classes": [{"id": 0, "color": "blue", "roi": [[0, 0, 200, 200]]}],
+            "cameras": {"thermal": {"min_diagonal": 10, "max_diagonal": 50}}
+        })");
+        CHECK(rules != nullptr);
+        if (!rules) {
+            return;
+        }
+
+        std::vector<DetectedObject> objects = {
+            makeObject(0, 0.6f, 10, 10, 40, 30),     // ROI 안
+            makeObject(0, 0.6f, 500, 500, 40, 30),   // ROI 밖
+            makeObject(2, 0.4f, 10, 10, 40, 30),     // default 신뢰도 미달
+        };
+        CHECK_EQ(rules->apply(CameraType::RGB, -1, 0, objects.data(), objects.size()), 1);
+        CHECK(objects[0].color == BboxColor::BLUE);
+
+        // 열화상 카메라의 대각선 범위 (10..50)
+        DetectedObject large = makeObject(0, 0.6f, 10, 10, 60, 60);
+        CHECK_EQ(rules->apply(CameraType::THERMAL, -1, 0, &large, 1), 1);
+        CHECK(!large.hasBbox);
+    }
+
+    void testRejects() {
+        CHECK(DetectionRules::compile("{") == nullptr);
+        CHECK(DetectionRules::compile(R"({"classes": [{"id": 99}]})") == nullptr);
+        CHECK(DetectionRules::compile(R"({"classes": [{"id": 1, "color": "pink"}]})") == nullptr);
+        CHECK(DetectionRules::compile(R"({"classes": [{"id": 1, "confirm_by": ["radar"]}]})") == nullptr);
+        CHECK(DetectionRules::compile(R"({"classes": [{"id": 1, "roi": [[0, 0, 1]]}]})") == nullptr);
+        CHECK(DetectionRules::compile(R"({"cameras": {"rgb": {"mask": {"presets": {"12": {}}}}}})") == nullptr);
+        CHECK(DetectionRules::compile(R"({"classes": [{"id": 4, "event": {"window": 65}}]})") == nullptr);
+    }
+
+    void testPresetMasks() {
+        // default는 왼쪽 절반, 프리셋 3은 오른쪽 절반만 허용
+        std::unique_ptr<DetectionRules> rules = DetectionRules::compile(R"({
+            "cameras": {"rgb": {"mask": {"frame": [1280, 720], "cell_size": 16, "presets": {
+                "default": {"include": [[[0, 0], [640, 0], [640, 720], [0, 720]]]},
+                "3": {"include": [[[640, 0], [1280, 0], [1280, 720], [640, 720]]]}
+            }}}}
+        })");
+        CHECK(rules != nullptr);
+        if (!rules) {
+            return;
+        }
+
+        DetectedObject left = makeObject(0, 0.9f, 100, 100, 100, 100);
+        DetectedObject right = makeObject(0, 0.9f, 900, 100, 100, 100);
+        CHECK_EQ(rules->apply(CameraType::RGB, -1, 0, &left, 1), 1);
+        CHECK_EQ(rules->apply(CameraType::RGB, -1, 0, &right, 1), 0);
+        CHECK_EQ(rules->apply(CameraType::RGB, 3, 0, &left, 1), 0);
+        CHECK_EQ(rules->apply(CameraType::RGB, 3, 0, &right, 1), 1);
+        CHECK_EQ(rules->apply(CameraType::RGB, 5, 0, &left, 1), 1);     // 마스크 없는 프리셋: default
+        CHECK_EQ(rules->apply(CameraType::RGB, 42, 0, &left, 1), 1);    // 범위 밖 프리셋: default
+        CHECK_EQ(rules->apply(CameraType::THERMAL, 3, 0, &right, 1), 1);  // 열화상은 마스크 없음
+    }
+
+    void testStore() {
+        DetectionRuleStore& store = DetectionRuleStore::getInstance();
+        CHECK(!store.load("/nonexistent/detection_rules.json"));
+
+        store.publish(DetectionRules::compile(R"({"default": {"min_confidence": 0.95}})"));
+        DetectedObject obj = makeObject(0, 0.9f, 0, 0, 100, 100);
+        CHECK_EQ(store.current().apply(CameraType::RGB, -1, 0, &obj, 1), 0);
+
+        store.publish(DetectionRules::defaults());
+        CHECK_EQ(store.current().apply(CameraType::RGB, -1, 0, &obj, 1), 1);
+    }
+}
+
+int main() {
+    testDefaults();
+    testCompile();
+    testRejects();
+    testPresetMasks();
+    testStore();
+    return TEST_RESULT();
+}
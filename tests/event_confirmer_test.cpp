@@ -0,0 +1,195 @@
+// EventConfirmer: 창 임계값, 재무장, 쿨다운(슬롯 재사용 포함), 확인 플래그, 박스 없는 객체, 추적 없는 객체, 슬롯 수 제한
+
+#include "TestUtil.h"
+#include "detection/DetectionRules.h"
+#include "detection/EventConfirmer.h"
+#include <vector>
+
+namespace {
+    const uint64_t BASE_NS = 1700000000ULL * 1000000000ULL;
+    const uint64_t FRAME_NS = 33333333ULL;
+
+    DetectedObject makeObject(int classId, uint64_t trackId) {
+        DetectedObject obj = DetectedObject();
+        obj.classId = classId;
+        obj.confidence = 0.9f;
+        obj.bbox = {100, 100, 120, 90};
+        obj.color = BboxColor::RED;
+        obj.hasBbox = true;
+        obj.trackId = trackId;
+        return obj;
+    }
+
+    // present(f)가 참인 프레임에만 객체를 넣어 frames 프레임을 돌리고 이벤트가 난 프레임을 돌려준다
+    template <typename Present>
+    std::vector<uint32_t> run(EventConfirmer& confirmer, const DetectionRules& rules, uint32_t confirmFlags,
+                              const std::vector<DetectedObject>& objects, uint32_t frames, Present present) {
+        std::vector<uint32_t> eventFrames;
+        std::vector<DetectionEvent> events;
+        DetectionData detection;
+        detection.cameraType = CameraType::RGB;
+        for (uint32_t f = 0; f < frames; f++) {
+            detection.frameNumber = f;
+            detection.timestamp = BASE_NS + f * FRAME_NS;
+            detection.objects.clear();
+            if (present(f)) {
+                detection.objects = objects;
+            }
+            events.clear();
+            confirmer.update(rules, confirmFlags, detection, events);
+            for (const DetectionEvent& event : events) {
+                eventFrames.push_back(event.frameNumber);
+            }
+        }
+        return eventFrames;
+    }
+
+    void testThresholdAndRearm() {
+        std::unique_ptr<DetectionRules> rules = DetectionRules::compile(R"({
+            "classes": [{"id": 4, "event": {"window": 10, "hits": 5, "release": 1, "cooldown": 0}}]
+        })");
+        CHECK(rules != nullptr);
+        if (!rules) {
+            return;
+        }
+
+        // 0..39 보임, 40..59 사라짐, 60.. 다시 보임: 5번째 프레임과 다시 나타난 뒤 5번째 프레임에 한 번씩
+        EventConfirmer confirmer;
+        std::vector<DetectedObject> objects = {makeObject(CLASS_LABOR_SIGN_COW, 7)};
+        std::vector<uint32_t> events = run(confirmer, *rules, 0, objects, 100,
+                                           [](uint32_t f) { return f < 40 || f >= 60; });
+        CHECK_EQ(events.size(), 2);
+        if (events.size() == 2) {
+            CHECK_EQ(events[0], 4);
+            CHECK_EQ(events[1], 64);
+        }
+    }
+
+    void testCooldown() {
+        // 기본 규칙: 30 중 20, 쿨다운 300초 → 사라졌다 나타나도 쿨다운 안에서는 한 번
+        std::unique_ptr<DetectionRules> rules = DetectionRules::defaults();
+        EventConfirmer confirmer;
+        std::vector<DetectedObject> objects = {makeObject(CLASS_LABOR_SIGN_COW, 1)};
+        std::vector<uint32_t> events = run(confirmer, *rules, 0, objects, 300,
+                                           [](uint32_t f) { return (f / 50) % 2 == 0; });
+        CHECK_EQ(events.size(), 1);
+        if (!events.empty()) {
+            CHECK_EQ(events[0], 19);
+        }
+    }
+
+    void testCooldownSurvivesEviction() {
+        // 분만 징후(추적 없음)가 이벤트를 낸 뒤 창(64 프레임)보다 오래 사라진 사이 발정 트랙들이 슬롯을 잡아도,
+        // 쿨다운 중인 슬롯은 재사용되지 않아 돌아왔을 때 쿨다운 안에서 다시 울리지 않는다
+        std::unique_ptr<DetectionRules> rules = DetectionRules::compile(R"({
+            "classes": [{"id": 3, "event": {"window": 30, "hits": 20, "release": 5, "cooldown": 300, "confirmed_only": false}},
+                        {"id": 4, "event": {"window": 30, "hits": 20, "release": 5, "cooldown": 300, "confirmed_only": false}}]
+        })");
+        CHECK(rules != nullptr);
+        if (!rules) {
+            return;
+        }
+
+        EventConfirmer confirmer;
+        std::vector<uint32_t> laborEvents;
+        std::vector<DetectionEvent> events;
+        DetectionData detection;
+        detection.cameraType = CameraType::RGB;
+        for (uint32_t f = 0; f < 600; f++) {
+            detection.frameNumber = f;
+            detection.timestamp = BASE_NS + f * FRAME_NS;
+            detection.objects.clear();
+            if (f < 50 || f >= 300) {
+                detection.objects.push_back(makeObject(CLASS_LABOR_SIGN_COW, EventConfirmer::UNTRACKED));
+            }
+            if (f >= 150) {
+                // 슬롯을 모두 채우도록 트랙을 계속 바꾼다
+                detection.objects.push_back(makeObject(CLASS_HEAT_COW, 1000 + f));
+            }
+            events.clear();
+            confirmer.update(*rules, 0, detection, events);
+            for (const DetectionEvent& event : events) {
+                if (event.classId == CLASS_LABOR_SIGN_COW) {
+                    laborEvents.push_back(event.frameNumber);
+                }
+            }
+        }
+        CHECK_EQ(laborEvents.size(), 1);
+        if (!laborEvents.empty()) {
+            CHECK_EQ(laborEvents[0], 19);
+        }
+    }
+
+    void testConfirmFlags() {
+        // 전도 소는 Optical Flow가 켜진 프레임만 증거로 센다
+        std::unique_ptr<DetectionRules> rules = DetectionRules::defaults();
+        std::vector<DetectedObject> objects = {makeObject(CLASS_FLIP_COW, 3)};
+
+        EventConfirmer unconfirmed;
+        CHECK(run(unconfirmed, *rules, 0, objects, 100, [](uint32_t) { return true; }).empty());
+
+        EventConfirmer confirmed;
+        CHECK_EQ(run(confirmed, *rules, DetectionRules::CONFIRM_OPT_FLOW, objects, 100,
+                     [](uint32_t) { return true; }).size(), 1);
+
+        // 정상 소는 이벤트 없음
+        EventConfirmer normal;
+        std::vector<DetectedObject> cows = {makeObject(CLASS_NORMAL_COW, 4)};
+        CHECK(run(normal, *rules, 0, cows, 100, [](uint32_t) { return true; }).empty());
+    }
+
+    void testUnboxed() {
+        // 대각선 범위 밖이라 박스가 없는 객체는 증거가 아니다
+        std::unique_ptr<DetectionRules> rules = DetectionRules::defaults();
+        EventConfirmer confirmer;
+        std::vector<DetectedObject> objects = {makeObject(CLASS_LABOR_SIGN_COW, 2)};
+        objects[0].color = BboxColor::NONE;
+        objects[0].hasBbox = false;
+        CHECK(run(confirmer, *rules, 0, objects, 100, [](uint32_t) { return true; }).empty());
+        CHECK_EQ(confirmer.activeTracks(), 0);
+    }
+
+    void testUntracked() {
+        // 추적기가 없으면 같은 클래스 객체 여럿이 한 프레임에 한 번만 센다
+        std::unique_ptr<DetectionRules> rules = DetectionRules::compile(R"({
+            "classes": [{"id": 4, "event": {"window": 10, "hits": 5, "release": 1, "cooldown": 0}}]
+        })");
+        CHECK(rules != nullptr);
+        if (!rules) {
+            return;
+        }
+        EventConfirmer confirmer;
+        std::vector<DetectedObject> objects(3, makeObject(CLASS_LABOR_SIGN_COW, EventConfirmer::UNTRACKED));
+        std::vector<uint32_t> events = run(confirmer, *rules, 0, objects, 20, [](uint32_t) { return true; });
+        CHECK_EQ(events.size(), 1);
+        if (!events.empty()) {
+            CHECK_EQ(events[0], 4);
+        }
+        CHECK_EQ(confirmer.activeTracks(), 1);
+    }
+
+    void testSlotLimit() {
+        std::unique_ptr<DetectionRules> rules = DetectionRules::defaults();
+        EventConfirmer confirmer;
+        std::vector<DetectedObject> objects;
+        for (uint64_t t = 0; t < 100; t++) {
+            objects.push_back(makeObject(CLASS_LABOR_SIGN_COW, t));
+        }
+        run(confirmer, *rules, 0, objects, 5, [](uint32_t) { return true; });
+        CHECK_EQ(confirmer.activeTracks(), EventConfirmer::MAX_TRACKS);
+
+        confirmer.reset();
+        CHECK_EQ(confirmer.activeTracks(), 0);
+    }
+}
+
+int main() {
+    testThresholdAndRearm();
+    testCooldown();
+    testCooldownSurvivesEviction();
+    testConfirmFlags();
+    testUnboxed();
+    testUntracked();
+    testSlotLimit();
+    return TEST_RESULT();
+}
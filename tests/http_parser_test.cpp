@@ -0,0 +1,94 @@
+// HttpParser: 완성/부분 요청, 파이프라이닝, 헤더 조회, keep-alive, 오류 상태 코드
+
+#include "TestUtil.h"
+#include "api/HttpParser.h"
+#include <string>
+
+namespace {
+    void testComplete() {
+        std::string request =
+            "POST /api/get_latest?camera=rgb HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "Content-Type: application/json\r\n"
+            "Content-Length: 13\r\n"
+            "\r\n"
+            "{\"camera\":1}\n";
+        HttpParser parser;
+        CHECK(parser.parse(request.data(), request.size()) == HttpParser::Status::COMPLETE);
+        CHECK(parser.method() == "POST");
+        CHECK(parser.path() == "/api/get_latest?camera=rgb");
+        CHECK(parser.version() == "HTTP/1.1");
+        CHECK(parser.header("content-type") == "application/json");
+        CHECK(parser.header("CONTENT-LENGTH") == "13");
+        CHECK(parser.header("accept").empty());
+        CHECK(parser.body() == "{\"camera\":1}\n");
+        CHECK_EQ(parser.consumed(), request.size());
+        CHECK(parser.keepAlive());
+    }
+
+    void testIncremental() {
+        // 한 바이트씩 도착해도 같은 결과
+        std::string request = "GET /metrics HTTP/1.0\r\nConnection: keep-alive\r\n\r\n";
+        HttpParser parser;
+        HttpParser::Status status = HttpParser::Status::INCOMPLETE;
+        for (size_t n = 1; n <= request.size(); n++) {
+            status = parser.parse(request.data(), n);
+            if (n < request.size()) {
+                CHECK(status == HttpParser::Status::INCOMPLETE);
+            }
+        }
+        CHECK(status == HttpParser::Status::COMPLETE);
+        CHECK(parser.path() == "/metrics");
+        CHECK(parser.keepAlive());
+    }
+
+    void testPipelined() {
+        std::string first = "GET /a HTTP/1.1\r\nConnection: close\r\n\r\n";
+        std::string second = "GET /b HTTP/1.0\r\n\r\n";
+        std::string data = first + second;
+
+        HttpParser parser;
+        CHECK(parser.parse(data.data(), data.size()) == HttpParser::Status::COMPLETE);
+        CHECK(parser.path() == "/a");
+        CHECK(!parser.keepAlive());
+        CHECK_EQ(parser.consumed(), first.size());
+
+        size_t offset = parser.consumed();
+        parser.reset();
+        CHECK(parser.parse(data.data() + offset, data.size() - offset) == HttpParser::Status::COMPLETE);
+        CHECK(parser.path() == "/b");
+        CHECK(!parser.keepAlive());
+    }
+
+    int errorFor(const std::string& request, const HttpParser::Limits& limits = HttpParser::Limits()) {
+        HttpParser parser(limits);
+        if (parser.parse(request.data(), request.size()) != HttpParser::Status::ERROR) {
+            return 0;
+        }
+        return parser.errorStatus();
+    }
+
+    void testErrors() {
+        CHECK_EQ(errorFor("GET /\r\n\r\n"), 400);
+        CHECK_EQ(errorFor("GET / HTTP/2.0\r\n\r\n"), 505);
+        CHECK_EQ(errorFor("GET / HTTP/1.1\r\nBad Header\r\n\r\n"), 400);
+        CHECK_EQ(errorFor("POST / HTTP/1.1\r\nContent-Length: x\r\n\r\n"), 400);
+        CHECK_EQ(errorFor("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"), 501);
+
+        HttpParser::Limits limits;
+        limits.maxBodySize = 4;
+        CHECK_EQ(errorFor("POST / HTTP/1.1\r\nContent-Length: 5\r\n\r\nhello", limits), 413);
+
+        limits = HttpParser::Limits();
+        limits.maxHeaderSize = 32;
+        CHECK_EQ(errorFor("GET / HTTP/1.1\r\nX-Long: " + std::string(64, 'a') + "\r\n\r\n", limits), 431);
+    }
+}
+
+int main() {
+    testComplete();
+    testIncremental();
+    testPipelined();
+    testErrors();
+    return TEST_RESULT();
+}
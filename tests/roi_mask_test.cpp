@@ -0,0 +1,59 @@
+// RoiMask: 포함/제외 다각형 래스터화, CENTER/OVERLAP 판정, 가장자리 처리
+
+#include "TestUtil.h"
+#include "detection/RoiMask.h"
+#include <cmath>
+
+namespace {
+    RoiMask::Polygon rect(float x0, float y0, float x1, float y1) {
+        return {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+    }
+
+    void testEmpty() {
+        RoiMask mask;
+        CHECK(mask.empty());
+        CHECK(mask.accepts({0, 0, 10, 10}));
+        CHECK(mask.overlap({0, 0, 10, 10}) == 1.0f);
+    }
+
+    void testCenter() {
+        // 100×100 프레임, 10픽셀 셀. 왼쪽 절반 포함, 그 안의 [0,20)×[0,20) 제외
+        RoiMask mask;
+        CHECK(mask.build(100, 100, 10, {rect(0, 0, 50, 100)}, {rect(0, 0, 20, 20)}));
+        CHECK_EQ(mask.columns(), 10);
+        CHECK_EQ(mask.rows(), 10);
+        CHECK_EQ(mask.allowedCells(), 50 - 4);
+
+        CHECK(mask.accepts({20, 40, 10, 10}));    // 중심 (25, 45)
+        CHECK(!mask.accepts({70, 40, 10, 10}));   // 중심 (75, 45): 포함 밖
+        CHECK(!mask.accepts({0, 0, 10, 10}));     // 중심 (5, 5): 제외 영역
+        CHECK(mask.accepts({-50, 50, 60, 10}));   // 중심이 프레임 밖이면 가장자리 셀로 붙인다
+    }
+
+    void testOverlap() {
+        RoiMask mask;
+        CHECK(mask.build(100, 100, 10, {rect(0, 0, 50, 100)}, {}, RoiMask::Mode::OVERLAP, 0.5f));
+
+        // [30, 70) × [0, 20): 4열 중 2열 허용 → 0.5
+        CHECK(std::fabs(mask.overlap({30, 0, 40, 20}) - 0.5f) < 1e-6f);
+        CHECK(mask.accepts({30, 0, 40, 20}));
+        // [40, 80): 4열 중 1열 → 0.25
+        CHECK(std::fabs(mask.overlap({40, 0, 40, 20}) - 0.25f) < 1e-6f);
+        CHECK(!mask.accepts({40, 0, 40, 20}));
+    }
+
+    void testInvalid() {
+        RoiMask mask;
+        CHECK(!mask.build(0, 100, 10, {}, {}));
+        CHECK(!mask.build(100, 100, 0, {}, {}));
+        CHECK(!mask.build(100, 100, 10, {{{0, 0}, {10, 10}}}, {}));
+    }
+}
+
+int main() {
+    testEmpty();
+    testCenter();
+    testOverlap();
+    testInvalid();
+    return TEST_RESULT();
+}
@@ -0,0 +1,76 @@
+// 바이너리 로그(.blog) 디코더
+// Logger 바이너리 모드로 기록된 파일을 텍스트 로그와 같은 형식
+// "[YYYY-MM-DD HH:MM:SS.mmm] [LEVEL] [file:line] message"로 출력한다.
+// 시각은 디코드하는 장비의 로컬 시간대로 표시된다 (TZ 환경 변수로 지정 가능).
+//
+// 사용법: logdecode [file.blog ...]   (파일을 주지 않으면 표준 입력)
+
+#include "utils/LogFormat.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+bool decodeStream(FILE* input, const char* name) {
+    LogFormat::Decoder decoder;
+    std::vector<char> buffer(256 * 1024);
+    size_t pending = 0;
+
+    auto printLine = [](const char* line, size_t length) {
+        fwrite(line, 1, length, stdout);
+        fputc('\n', stdout);
+    };
+
+    for (;;) {
+        size_t n = fread(buffer.data() + pending, 1, buffer.size() - pending, input);
+        if (n == 0) {
+            break;
+        }
+        pending += n;
+
+        size_t consumed = decoder.feed(buffer.data(), pending, printLine);
+        if (decoder.failed()) {
+            fprintf(stderr, "logdecode: %s: %s\n", name, decoder.error().c_str());
+            return false;
+        }
+        memmove(buffer.data(), buffer.data() + consumed, pending - consumed);
+        pending -= consumed;
+
+        // 프레임 하나가 버퍼보다 크면 버퍼를 늘린다
+        if (pending == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+    }
+
+    if (ferror(input)) {
+        fprintf(stderr, "logdecode: %s: %s\n", name, strerror(errno));
+        return false;
+    }
+    if (pending > 0) {
+        fprintf(stderr, "logdecode: %s: truncated frame at end (%zu bytes)\n", name, pending);
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        return decodeStream(stdin, "<stdin>") ? 0 : 1;
+    }
+
+    bool ok = true;
+    for (int i = 1; i < argc; i++) {
+        FILE* input = fopen(argv[i], "rb");
+        if (!input) {
+            fprintf(stderr, "logdecode: %s: %s\n", argv[i], strerror(errno));
+            ok = false;
+            continue;
+        }
+        ok = decodeStream(input, argv[i]) && ok;
+        fclose(input);
+    }
+    return ok ? 0 : 1;
+}